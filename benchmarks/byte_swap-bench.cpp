@@ -0,0 +1,163 @@
+/**
+ *  \file   byte_swap-bench.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "networking/net.h"
+
+namespace {
+/**
+ * The number of bytes converted per packet
+ */
+constexpr std::size_t packet_size = 8192;
+
+/**
+ * The number of packets converted by each run
+ */
+constexpr std::size_t num_packets = 100000;
+
+/**
+ * Keeps the optimizer from discarding the conversions
+ */
+volatile std::uint64_t sink;
+
+/**
+ * Convert packets of samples to host byte order
+ *
+ * @tparam T The sample type
+ *
+ * @param[in] bulk  If true, convert each packet with a single call to the
+ *                  bulk converter; otherwise, one sample at a time
+ * @param[in] level The instruction set used by the bulk converter
+ *
+ * @return The throughput, in GB/s
+ */
+template <typename T>
+double run(bool bulk, jfern::internal::simd_level level) {
+    constexpr std::size_t count = packet_size / sizeof(T);
+
+    std::vector<T> in(count), out(count);
+    for (std::size_t i = 0; i < count; i++) in[i] = static_cast<T>(i);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t p = 0; p < num_packets; p++) {
+        if (bulk) {
+            jfern::internal::bulk_byte_swap(in.data(), out.data(), count,
+                                            sizeof(T), level);
+        } else {
+            for (std::size_t i = 0; i < count; i++) {
+                out[i] = jfern::to_host_order(in[i]);
+            }
+        }
+
+        sink = sink + out[p % count];
+    }
+
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    return packet_size * num_packets / elapsed.count() / 1e9;
+}
+
+/**
+ * Reverse the bytes of an integer with shifts and masks, as byte_swap did
+ * before it used the compiler builtins
+ *
+ * @param[in] data The integer whose bytes to reverse
+ *
+ * @return \a data with its bytes reversed
+ */
+std::uint64_t shift_mask_swap(std::uint64_t data) {
+    data = ((data & 0x00000000ffffffffull) << 32) |
+           ((data & 0xffffffff00000000ull) >> 32);
+    data = ((data & 0x0000ffff0000ffffull) << 16) |
+           ((data & 0xffff0000ffff0000ull) >> 16);
+    data = ((data & 0x00ff00ff00ff00ffull) <<  8) |
+           ((data & 0xff00ff00ff00ff00ull) >>  8);
+    return data;
+}
+
+/**
+ * Swap 64-bit values one at a time, folding each into a checksum so the
+ * swaps cannot be vectorized or hoisted
+ *
+ * @param[in] builtin If true, use byte_swap(); otherwise, shift_mask_swap()
+ *
+ * @return The throughput, in millions of swaps per second
+ */
+double run_single(bool builtin) {
+    constexpr std::size_t iterations = 200000000;
+
+    std::uint64_t value = 0x0102030405060708ull;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < iterations; i++) {
+        value = builtin ? jfern::byte_swap(value) : shift_mask_swap(value);
+        value += i;
+    }
+
+    sink = value;
+
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    return iterations / elapsed.count() / 1e6;
+}
+
+/**
+ * Benchmark each converter for one sample type
+ *
+ * @tparam T The sample type
+ */
+template <typename T>
+void run_all() {
+    using jfern::internal::simd_level;
+
+    const simd_level max_level = jfern::internal::max_simd_level();
+
+    std::printf("%6zu %12.2f %12.2f", 8 * sizeof(T),
+                run<T>(false, simd_level::scalar),
+                run<T>(true, simd_level::scalar));
+
+    for (simd_level level : {simd_level::ssse3, simd_level::avx2}) {
+        if (level <= max_level) {
+            std::printf(" %12.2f", run<T>(true, level));
+        } else {
+            std::printf(" %12s", "n/a");
+        }
+    }
+
+    std::printf("\n");
+}
+
+}  // namespace
+
+int main() {
+    std::printf("Byte order conversion of %zu-byte packets, GB/s\n\n",
+                packet_size);
+    std::printf("%6s %12s %12s %12s %12s\n", "bits", "per-element",
+                "scalar", "ssse3", "avx2");
+
+    run_all<std::uint16_t>();
+    run_all<std::uint32_t>();
+    run_all<std::uint64_t>();
+
+    // The builtin compiles to a single bswap; the shift/mask version is
+    // recognized by some compilers but not all
+    std::printf("\nSingle 64-bit swaps, millions/s\n\n");
+    std::printf("%12s %12s\n", "shift/mask", "builtin");
+    std::printf("%12.1f %12.1f\n", run_single(false), run_single(true));
+
+    return 0;
+}
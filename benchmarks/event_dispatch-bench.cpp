@@ -0,0 +1,87 @@
+/**
+ *  \file   event_dispatch-bench.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+
+#include "networking/basic_fd_event_sink.h"
+#include "networking/basic_unique_fd.h"
+#include "networking/fd_event_sink.h"
+#include "networking/unique_fd.h"
+
+namespace {
+/**
+ * The number of events dispatched by each run
+ */
+constexpr std::size_t iterations = 50000000;
+
+/**
+ * Keeps the optimizer from discarding the handlers
+ */
+volatile std::size_t sink_total;
+
+/**
+ * Dispatch events through a sink, as a reactor would on each wakeup
+ *
+ * @param[in] sink The sink, which must have a POLLIN handler
+ *
+ * @return The nanoseconds per event
+ */
+template <typename Sink>
+double run(Sink& sink) {
+    const auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < iterations; i++) {
+        sink.handle_events(POLLIN);
+    }
+
+    const std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    return elapsed.count() / iterations;
+}
+
+}  // namespace
+
+int main() {
+    int fds[2];
+    if (::pipe(fds) != 0) return 1;
+
+    std::size_t total = 0;
+
+    // Virtual fd_interface with a std::function handler
+    jfern::fd_event_sink dynamic_sink(
+        std::make_unique<jfern::unique_fd>(fds[0]));
+    dynamic_sink.add_events(POLLIN, [&total](short revents,
+                                             jfern::fd_interface& fd) {
+        total += revents + fd.get();
+    });
+
+    // Concrete fd type with the handler's own type
+    auto handler = [&total](short revents, jfern::basic_unique_fd& fd) {
+        total += revents + fd.get();
+    };
+
+    jfern::basic_fd_event_sink<jfern::basic_unique_fd, decltype(handler)>
+        static_sink{jfern::basic_unique_fd(::dup(fds[0]))};
+    static_sink.add_events(POLLIN, handler);
+
+    std::printf("Handler dispatch cost, ns/event\n\n");
+    std::printf("%14s %14s\n", "fd_event_sink", "basic_sink");
+    std::printf("%14.2f %14.2f\n", run(dynamic_sink), run(static_sink));
+
+    sink_total = total;
+
+    ::close(fds[1]);
+    return 0;
+}
@@ -0,0 +1,91 @@
+/**
+ *  \file   ref_counts-bench.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "networking/ref_counts.h"
+
+namespace {
+/**
+ * The number of reference count operations made by each thread
+ */
+constexpr std::size_t iterations = 2000000;
+
+/**
+ * Have half of the threads copy and destroy strong references while the
+ * other half copy, lock, and destroy weak references to the same descriptor,
+ * as when workers copy a shared_fd while observers hold weak_fds to it
+ *
+ * @tparam Layout How the reference counters are laid out
+ *
+ * @param[in] num_threads The number of threads
+ *
+ * @return The wall-clock nanoseconds per iteration of each thread
+ */
+template <jfern::fd::counter_layout Layout>
+double run(std::size_t num_threads) {
+    jfern::fd::ref_counts<Layout> counts;
+
+    std::atomic<bool> go(false);
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < num_threads; i++) {
+        threads.emplace_back([&counts, &go, i]() {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+
+            if (i % 2 == 0) {
+                for (std::size_t j = 0; j < iterations; j++) {
+                    counts.add_reference();
+                    counts.release();
+                }
+            } else {
+                for (std::size_t j = 0; j < iterations; j++) {
+                    counts.add_weak_reference();
+                    counts.release_weak_reference();
+                }
+            }
+        });
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+
+    for (auto& thread : threads) thread.join();
+
+    const std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    return elapsed.count() / iterations;
+}
+
+}  // namespace
+
+int main() {
+    using jfern::fd::counter_layout;
+
+    std::printf("shared_fd / weak_fd copy cost, %zu copies per thread "
+                "(%u hardware threads)\n\n",
+                iterations, std::thread::hardware_concurrency());
+    std::printf("%8s %14s %14s\n", "threads", "packed (ns)", "padded (ns)");
+
+    for (std::size_t num_threads = 2; num_threads <= 64; num_threads *= 2) {
+        const double packed = run<counter_layout::packed>(num_threads);
+        const double padded = run<counter_layout::padded>(num_threads);
+
+        std::printf("%8zu %14.2f %14.2f\n", num_threads, packed, padded);
+    }
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+/**
+ *  \file   shared_fd-bench.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "networking/fd_internal.h"
+
+namespace {
+/**
+ * The number of connections held open at once
+ */
+constexpr std::size_t burst_size = 1024;
+
+/**
+ * The number of bursts accepted by each thread
+ */
+constexpr std::size_t num_bursts = 2000;
+
+/**
+ * Allocates control blocks from the general-purpose heap, as shared_fd did
+ * before control blocks were pooled
+ */
+struct heap_allocator {
+    static jfern::fd::shared_internal* create(int fd) {
+        void* storage = ::operator new(sizeof(jfern::fd::shared_internal));
+        return ::new (storage) jfern::fd::shared_internal(fd);
+    }
+
+    static void destroy(jfern::fd::shared_internal* info) {
+        info->~shared_internal();
+        ::operator delete(info);
+    }
+};
+
+/**
+ * Allocates control blocks from the pool
+ */
+struct pool_allocator {
+    static jfern::fd::shared_internal* create(int fd) {
+        return new jfern::fd::shared_internal(fd);
+    }
+
+    static void destroy(jfern::fd::shared_internal* info) {
+        delete info;
+    }
+};
+
+/**
+ * Simulate accepting bursts of short-lived connections, creating a control
+ * block per connection and destroying them all once the burst closes
+ *
+ * @tparam Allocator Creates and destroys control blocks
+ *
+ * @param[in] num_threads The number of threads accepting concurrently
+ *
+ * @return The wall-clock nanoseconds per connection accepted, across all
+ *         threads
+ */
+template <class Allocator>
+double run(std::size_t num_threads) {
+    auto task = []() {
+        std::vector<jfern::fd::shared_internal*> open(burst_size);
+
+        for (std::size_t burst = 0; burst < num_bursts; burst++) {
+            for (std::size_t i = 0; i < burst_size; i++) {
+                open[i] = Allocator::create(static_cast<int>(i));
+            }
+
+            for (std::size_t i = 0; i < burst_size; i++) {
+                Allocator::destroy(open[i]);
+            }
+        }
+    };
+
+    // Warm up, so neither allocator pays for first-touch page faults
+    task();
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < num_threads; i++) {
+        threads.emplace_back(task);
+    }
+
+    for (auto& thread : threads) thread.join();
+
+    const std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    return elapsed.count() / (num_threads * burst_size * num_bursts);
+}
+
+}  // namespace
+
+int main() {
+    std::printf("control block cost per accepted connection "
+                "(bursts of %zu)\n\n", burst_size);
+    std::printf("%8s %12s %12s\n", "threads", "heap (ns)", "pool (ns)");
+
+    for (const std::size_t num_threads : {1, 2, 4, 8}) {
+        const double heap = run<heap_allocator>(num_threads);
+        const double pool = run<pool_allocator>(num_threads);
+
+        std::printf("%8zu %12.2f %12.2f\n", num_threads, heap, pool);
+    }
+
+    return 0;
+}
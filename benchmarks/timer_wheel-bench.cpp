@@ -0,0 +1,151 @@
+/**
+ *  \file   timer_wheel-bench.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <vector>
+
+#include "networking/timer_wheel.h"
+
+namespace {
+/**
+ * The number of timers pending at once
+ */
+constexpr std::size_t n_timers = 2000000;
+
+/**
+ * Keeps the optimizer from discarding the callbacks
+ */
+volatile std::size_t sink_total;
+
+/**
+ * Get the nanoseconds elapsed per timer since a given time
+ *
+ * @param[in] start The start time
+ *
+ * @return The nanoseconds per timer
+ */
+double ns_per_timer(std::chrono::steady_clock::time_point start) {
+    const std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    return elapsed.count() / n_timers;
+}
+
+/**
+ * Get a pseudo-random delay of up to about 10 minutes, as for a mix of
+ * retransmit and idle timers
+ *
+ * @param[in] i The timer number
+ *
+ * @return The delay
+ */
+std::chrono::milliseconds delay_of(std::size_t i) {
+    const std::uint64_t x = (i + 1) * 0x9e3779b97f4a7c15ull;
+    return std::chrono::milliseconds((x >> 40) % 600000);
+}
+
+/**
+ * Schedule, cancel half of, and expire the rest of \ref n_timers timers
+ */
+void run_wheel() {
+    jfern::timer_wheel wheel;
+    std::size_t total = 0;
+
+    std::vector<jfern::timer_wheel::timer_id> ids(n_timers);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < n_timers; i++) {
+        ids[i] = wheel.schedule(delay_of(i), [&total]() { total++; });
+    }
+
+    const double schedule_ns = ns_per_timer(start);
+
+    start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < n_timers; i += 2) {
+        wheel.cancel(ids[i]);
+    }
+
+    const double cancel_ns = 2 * ns_per_timer(start);
+
+    start = std::chrono::steady_clock::now();
+
+    wheel.advance(jfern::timer_wheel::clock::now() + std::chrono::hours(1));
+
+    const double expire_ns = 2 * ns_per_timer(start);
+
+    sink_total = total;
+
+    std::printf("%-14s %10.2f %10.2f %10.2f\n", "timer_wheel",
+                schedule_ns, cancel_ns, expire_ns);
+}
+
+/**
+ * The same workload with timers kept in an ordered multimap
+ */
+void run_multimap() {
+    using clock = std::chrono::steady_clock;
+    using callback_t = jfern::timer_wheel::callback_t;
+
+    std::multimap<clock::time_point, callback_t> timers;
+    std::size_t total = 0;
+
+    std::vector<std::multimap<clock::time_point, callback_t>::iterator>
+        ids(n_timers);
+
+    auto start = clock::now();
+
+    for (std::size_t i = 0; i < n_timers; i++) {
+        ids[i] = timers.emplace(clock::now() + delay_of(i),
+                                [&total]() { total++; });
+    }
+
+    const double schedule_ns = ns_per_timer(start);
+
+    start = clock::now();
+
+    for (std::size_t i = 0; i < n_timers; i += 2) {
+        timers.erase(ids[i]);
+    }
+
+    const double cancel_ns = 2 * ns_per_timer(start);
+
+    start = clock::now();
+
+    const clock::time_point end = clock::now() + std::chrono::hours(1);
+
+    while (!timers.empty() && timers.begin()->first <= end) {
+        callback_t callback = std::move(timers.begin()->second);
+        timers.erase(timers.begin());
+        callback();
+    }
+
+    const double expire_ns = 2 * ns_per_timer(start);
+
+    sink_total = total;
+
+    std::printf("%-14s %10.2f %10.2f %10.2f\n", "std::multimap",
+                schedule_ns, cancel_ns, expire_ns);
+}
+
+}  // namespace
+
+int main() {
+    std::printf("%zu timers, ns/timer\n\n", n_timers);
+    std::printf("%-14s %10s %10s %10s\n", "", "schedule", "cancel", "expire");
+
+    run_wheel();
+    run_multimap();
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+/**
+ *  \file   basic_fd.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#ifndef NETWORKING_BASIC_FD_H_
+#define NETWORKING_BASIC_FD_H_
+
+#include <type_traits>
+#include <utility>
+
+namespace jfern {
+/**
+ * @class basic_fd
+ *
+ * Statically dispatched counterpart of \ref fd_interface
+ *
+ * @details
+ * A basic_fd supplies the handler-taking poll() overloads to a file
+ * descriptor type \a Derived, which must itself provide get(), poll(short)
+ * and poll(short, int). Handlers are taken by their own type rather than as
+ * a std::function, and are passed \a Derived rather than an fd_interface, so
+ * the compiler may inline the whole path from poll() to the handler. Neither
+ * class has a vtable
+ *
+ * @tparam Derived The file descriptor type, e.g. \ref basic_unique_fd
+ */
+template <typename Derived>
+class basic_fd {
+    /**
+     * True if \a Handler can be called with a mask of returned events and
+     * a \a Derived
+     */
+    template <typename Handler>
+    using enable_if_handler_t = std::enable_if_t<
+        std::is_invocable<Handler&, short, Derived&>::value>;
+
+public:
+    template <typename Handler, typename = enable_if_handler_t<Handler>>
+    int poll(short events, Handler&& handler);
+
+    template <typename Handler, typename = enable_if_handler_t<Handler>>
+    int poll(short events, int timeout, Handler&& handler);
+
+protected:
+    basic_fd() = default;
+
+    basic_fd(const basic_fd& fd)            = default;
+    basic_fd(basic_fd&& fd)                 = default;
+    basic_fd& operator=(const basic_fd& fd) = default;
+    basic_fd& operator=(basic_fd&& fd)      = default;
+
+    ~basic_fd() = default;
+
+private:
+    Derived& derived() noexcept;
+};
+
+/**
+ * Poll for file descriptor events without waiting
+ *
+ * @param[in] events  A mask of events to poll for
+ * @param[in] handler Callable which receives a mask of returned events along
+ *                    with the file descriptor
+ *
+ * @return The mask of returned events, or -1 on error
+ */
+template <typename Derived>
+template <typename Handler, typename>
+int basic_fd<Derived>::poll(short events, Handler&& handler) {
+    const int revents = derived().poll(events);
+    if (revents != -1) handler(static_cast<short>(revents), derived());
+
+    return revents;
+}
+
+/**
+ * Poll for file descriptor events
+ *
+ * @param[in] events  A mask of events to poll for
+ * @param[in] timeout Wait at most this many milliseconds for events
+ * @param[in] handler Callable which receives a mask of returned events along
+ *                    with the file descriptor
+ *
+ * @return The mask of returned events, or -1 on error
+ */
+template <typename Derived>
+template <typename Handler, typename>
+int basic_fd<Derived>::poll(short events, int timeout, Handler&& handler) {
+    const int revents = derived().poll(events, timeout);
+    if (revents != -1) handler(static_cast<short>(revents), derived());
+
+    return revents;
+}
+
+/**
+ * Get the file descriptor type
+ *
+ * @return *this as a \a Derived
+ */
+template <typename Derived>
+Derived& basic_fd<Derived>::derived() noexcept {
+    return static_cast<Derived&>(*this);
+}
+
+}  // namespace jfern
+
+#endif  // NETWORKING_BASIC_FD_H_
@@ -0,0 +1,373 @@
+/**
+ *  \file   basic_fd_event_sink.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#ifndef NETWORKING_BASIC_FD_EVENT_SINK_H_
+#define NETWORKING_BASIC_FD_EVENT_SINK_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace jfern {
+/**
+ * @class basic_fd_event_sink
+ *
+ * Statically dispatched counterpart of \ref fd_event_sink
+ *
+ * @details
+ * The file descriptor is held by value and handlers by their own type, so
+ * handle_events() calls each handler directly, with no virtual call or
+ * std::function in between, and the compiler may inline the handler into
+ * the dispatch loop. Only level-triggered handlers are supported
+ *
+ * As with \ref fd_event_sink, each event bit is owned by at most one handler
+ * and handlers live in a fixed array of slots, so handlers may add and remove
+ * handlers, themselves included, while they run
+ *
+ * @tparam Fd      The file descriptor type, e.g. \ref basic_unique_fd
+ * @tparam Handler The handler type, which is called with the returned events
+ *                 and an \a Fd&, e.g. a lambda or a function pointer
+ */
+template <typename Fd, typename Handler>
+class basic_fd_event_sink final {
+    static_assert(std::is_invocable<Handler&, short, Fd&>::value,
+                  "basic_fd_event_sink: Handler must be callable with "
+                  "(short, Fd&)");
+
+public:
+    explicit basic_fd_event_sink(Fd fd);
+
+    basic_fd_event_sink(const basic_fd_event_sink& sink)            = default;
+    basic_fd_event_sink(basic_fd_event_sink&& sink)                 = default;
+    basic_fd_event_sink& operator=(const basic_fd_event_sink& sink) = default;
+    basic_fd_event_sink& operator=(basic_fd_event_sink&& sink)      = default;
+
+    ~basic_fd_event_sink() = default;
+
+    bool add_events(short events, Handler handler);
+
+    void clear_events();
+
+    short events() const noexcept;
+
+    Fd& fd() noexcept;
+
+    int get() const noexcept;
+
+    void handle_events(short events);
+
+    void remove_events(short events);
+
+private:
+    /**
+     * The number of distinct event bits, and so the most handlers a sink may
+     * hold at once
+     */
+    static constexpr std::size_t max_handlers = 8 * sizeof(short);
+
+    /**
+     * The number of handler slots. One more than \ref max_handlers, since a
+     * handler which removes itself keeps its slot until it returns
+     */
+    static constexpr std::size_t max_slots = max_handlers + 1;
+
+    /**
+     * Marks that no handler is running
+     */
+    static constexpr std::size_t npos = max_slots;
+
+    void attach_events(std::uint16_t events, std::size_t index);
+
+    void detach_events(std::uint16_t events);
+
+    std::size_t allocate_slot();
+
+    void release_slot(std::size_t index);
+
+    /**
+     * @brief A handler and the events it owns
+     */
+    struct callback_info {
+        callback_info() : handler(), mask(0) {}
+
+        /**
+         * Called back in reponse to one or more of the events specified
+         * in the event mask. Empty if this slot is free
+         */
+        std::optional<Handler> handler;
+
+        /**
+         * Bitmask of events that will trigger the handler. Zero if this slot
+         * is free
+         */
+        std::uint16_t mask;
+    };
+
+    /**
+     * Bit i is set if m_handlers[i] holds no handler
+     */
+    std::uint32_t m_free_slots;
+
+    /**
+     * Handler slots. Slots are reused once free. Their addresses never
+     * change, so handlers may add and remove handlers while they run
+     */
+    std::array<callback_info, max_slots> m_handlers;
+
+    /**
+     * Bitmask of all events which have a handler
+     */
+    std::uint16_t m_mask;
+
+    /**
+     * For each event bit in \ref m_mask, the index of the handler that owns it
+     */
+    std::array<std::uint8_t, max_handlers> m_owners;
+
+    /**
+     * True if the running handler removed itself, so that its slot must be
+     * freed once it returns
+     */
+    bool m_retired;
+
+    /**
+     * The slot of the handler being dispatched, or \ref npos
+     */
+    std::size_t m_running;
+
+    /**
+     * Slots still to be dispatched by the current call to handle_events()
+     */
+    std::uint32_t m_targets;
+
+    /**
+     * The file descriptor itself (owned by *this)
+     */
+    Fd m_fd;
+};
+
+/**
+ * @brief Constructor
+ *
+ * @param fd The file descriptor to acquire ownership of
+ */
+template <typename Fd, typename Handler>
+basic_fd_event_sink<Fd, Handler>::basic_fd_event_sink(Fd fd)
+    : m_free_slots((1u << max_slots) - 1),
+      m_handlers(),
+      m_mask(0),
+      m_owners(),
+      m_retired(false),
+      m_running(npos),
+      m_targets(0),
+      m_fd(std::move(fd)) {
+}
+
+/**
+ * @brief Add events of interest for this file descriptor
+ *
+ * @param events  Bitmask of events to handle
+ * @param handler Called back in reponse to any events specified in \a events
+ *
+ * @note If any event in \a events already has an associated handler, the
+ *       handler for that event will be replaced by \a handler
+ *
+ * @return True on success
+ */
+template <typename Fd, typename Handler>
+bool basic_fd_event_sink<Fd, Handler>::add_events(short events,
+                                                  Handler handler) {
+    if (events == 0) return false;
+
+    const auto mask = static_cast<std::uint16_t>(events);
+
+    detach_events(mask);
+
+    const std::size_t index = allocate_slot();
+
+    m_handlers[index].handler.emplace(std::move(handler));
+
+    attach_events(mask, index);
+
+    return true;
+}
+
+/**
+ * @brief Clear all events/event handlers for this file descriptor
+ */
+template <typename Fd, typename Handler>
+void basic_fd_event_sink<Fd, Handler>::clear_events() {
+    detach_events(0xffff);
+}
+
+/**
+ * @brief Get the events of interest for this file descriptor
+ *
+ * @return Bitmask of all events which currently have a handler
+ */
+template <typename Fd, typename Handler>
+short basic_fd_event_sink<Fd, Handler>::events() const noexcept {
+    return static_cast<short>(m_mask);
+}
+
+/**
+ * @brief Get the file descriptor owned by this sink
+ *
+ * @return The file descriptor
+ */
+template <typename Fd, typename Handler>
+Fd& basic_fd_event_sink<Fd, Handler>::fd() noexcept {
+    return m_fd;
+}
+
+/**
+ * @brief Get the underlying file descriptor
+ *
+ * @return The file descriptor, or -1 if not assigned
+ */
+template <typename Fd, typename Handler>
+int basic_fd_event_sink<Fd, Handler>::get() const noexcept {
+    return m_fd.get();
+}
+
+/**
+ * @brief Handle file desciptor events
+ *
+ * @param events Bitmask specifying which events occurred
+ */
+template <typename Fd, typename Handler>
+void basic_fd_event_sink<Fd, Handler>::handle_events(short events) {
+    const auto mask = static_cast<std::uint16_t>(events);
+
+    // Collect the owners of the events that occurred, so that each handler
+    // runs once however many of its events occurred
+    std::uint32_t targets = 0;
+    for (std::uint32_t bits = m_mask & mask; bits != 0; bits &= bits - 1) {
+        targets |= 1u << m_owners[__builtin_ctz(bits)];
+    }
+
+    // Handlers may add and remove handlers, which updates the targets left
+    m_targets = targets;
+
+    while (m_targets != 0) {
+        const std::size_t index = __builtin_ctz(m_targets);
+        m_targets &= m_targets - 1;
+
+        callback_info& event = m_handlers[index];
+        if ((event.mask & mask) == 0) continue;
+
+        m_running = index;
+
+        (*event.handler)(events, m_fd);
+
+        m_running = npos;
+
+        // The handler removed itself; destroy it now that it has returned
+        if (m_retired) {
+            m_retired = false;
+            release_slot(index);
+        }
+    }
+}
+
+/**
+ * @brief Remove previously added events
+ *
+ * @param events Bitmask specifying which events to no longer check for
+ *
+ * @note No-op if no events in \a events were previously added
+ */
+template <typename Fd, typename Handler>
+void basic_fd_event_sink<Fd, Handler>::remove_events(short events) {
+    detach_events(static_cast<std::uint16_t>(events));
+}
+
+/**
+ * @brief Assign events to a handler
+ *
+ * @param events Bitmask of events, none of which may have a handler
+ * @param index  The slot holding the handler
+ */
+template <typename Fd, typename Handler>
+void basic_fd_event_sink<Fd, Handler>::attach_events(std::uint16_t events,
+                                                     std::size_t index) {
+    m_handlers[index].mask = events;
+
+    for (std::uint32_t bits = events; bits != 0; bits &= bits - 1) {
+        m_owners[__builtin_ctz(bits)] = static_cast<std::uint8_t>(index);
+    }
+
+    m_mask |= events;
+}
+
+/**
+ * @brief Detach events from whichever handlers currently respond to them,
+ *        freeing the slots of handlers left with no events
+ *
+ * @param events Bitmask of events to detach
+ */
+template <typename Fd, typename Handler>
+void basic_fd_event_sink<Fd, Handler>::detach_events(std::uint16_t events) {
+    for (std::uint32_t bits = m_mask & events; bits != 0; bits &= bits - 1) {
+        const unsigned int bit = __builtin_ctz(bits);
+        const std::size_t index = m_owners[bit];
+
+        callback_info& event = m_handlers[index];
+        event.mask &= ~(1u << bit);
+
+        if (event.mask == 0) {
+            // Skip it if it has yet to be dispatched, and keep it alive
+            // if it is running
+            m_targets &= ~(1u << index);
+
+            if (index == m_running) {
+                m_retired = true;
+            } else {
+                release_slot(index);
+            }
+        }
+    }
+
+    m_mask &= ~events;
+}
+
+/**
+ * @brief Get a free handler slot
+ *
+ * @details Every handler owns at least one event bit, and at most one more
+ *          slot is held by a running handler which removed itself, so a
+ *          slot is always free
+ *
+ * @return The index of the slot
+ */
+template <typename Fd, typename Handler>
+std::size_t basic_fd_event_sink<Fd, Handler>::allocate_slot() {
+    const std::size_t index = __builtin_ctz(m_free_slots);
+    m_free_slots &= m_free_slots - 1;
+
+    return index;
+}
+
+/**
+ * @brief Destroy the handler in a slot and mark the slot free
+ *
+ * @param index The slot, which must own no events
+ */
+template <typename Fd, typename Handler>
+void basic_fd_event_sink<Fd, Handler>::release_slot(std::size_t index) {
+    m_handlers[index].handler.reset();
+
+    m_free_slots |= 1u << index;
+}
+
+}  // namespace jfern
+
+#endif  // NETWORKING_BASIC_FD_EVENT_SINK_H_
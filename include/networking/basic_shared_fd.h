@@ -0,0 +1,87 @@
+/**
+ *  \file   basic_shared_fd.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#ifndef NETWORKING_BASIC_SHARED_FD_H_
+#define NETWORKING_BASIC_SHARED_FD_H_
+
+#include <cstddef>
+
+#include "basic_fd.h"
+#include "fd_internal.h"
+
+namespace jfern {
+/**
+ * @class basic_shared_fd
+ *
+ * A \ref shared_fd without virtual functions
+ *
+ * @details
+ * Manages a single file descriptor with the same semantics as shared_fd,
+ * including its concurrency modes, but is not an fd_interface. Handlers
+ * passed to poll() are statically dispatched (see \ref basic_fd). shared_fd
+ * is implemented in terms of this class
+ */
+class basic_shared_fd final : public basic_fd<basic_shared_fd> {
+public:
+    basic_shared_fd();
+
+    explicit basic_shared_fd(int fd);
+
+    basic_shared_fd(int fd, fd::concurrency mode);
+
+    basic_shared_fd(const basic_shared_fd& fd);
+    basic_shared_fd(basic_shared_fd&& fd);
+    basic_shared_fd& operator=(const basic_shared_fd& fd);
+    basic_shared_fd& operator=(basic_shared_fd&& fd);
+
+    ~basic_shared_fd();
+
+    explicit operator bool() const noexcept;
+
+    fd::concurrency concurrency_mode() const noexcept;
+
+    int get() const noexcept;
+
+    bool is_blocking() const noexcept;
+
+    using basic_fd<basic_shared_fd>::poll;
+
+    int poll(short events) noexcept;
+
+    int poll(short events, int timeout) noexcept;
+
+    bool reset(int fd) noexcept;
+
+    bool set_blocking(bool enable) noexcept;
+
+    void swap(basic_shared_fd& fd) noexcept;
+
+    std::size_t use_count() const noexcept;
+
+private:
+    // Give the shared_fd family access to the control block
+    friend class local_shared_fd;
+    friend class shared_fd;
+    friend class weak_fd;
+
+    explicit basic_shared_fd(fd::shared_internal* shared_info);
+
+    void drop_reference();
+
+    /** True if blocking behavior is enabled */
+    bool m_blocking;
+
+    /**
+     * Data shared between owners of the file descriptor
+     */
+    fd::shared_internal* m_shared_info;
+};
+
+}  // namespace jfern
+
+#endif  // NETWORKING_BASIC_SHARED_FD_H_
@@ -0,0 +1,68 @@
+/**
+ *  \file   basic_unique_fd.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#ifndef NETWORKING_BASIC_UNIQUE_FD_H_
+#define NETWORKING_BASIC_UNIQUE_FD_H_
+
+#include "basic_fd.h"
+
+namespace jfern {
+/**
+ * @class basic_unique_fd
+ *
+ * A \ref unique_fd without virtual functions
+ *
+ * @details
+ * Manages a single file descriptor with the same semantics as unique_fd, but
+ * is not an fd_interface. Handlers passed to poll() are statically dispatched
+ * (see \ref basic_fd). unique_fd is implemented in terms of this class
+ */
+class basic_unique_fd final : public basic_fd<basic_unique_fd> {
+public:
+    basic_unique_fd();
+
+    explicit basic_unique_fd(int fd);
+
+    basic_unique_fd(const basic_unique_fd& fd)            = delete;
+    basic_unique_fd(basic_unique_fd&& fd);
+    basic_unique_fd& operator=(const basic_unique_fd& fd) = delete;
+    basic_unique_fd& operator=(basic_unique_fd&& fd);
+
+    ~basic_unique_fd();
+
+    explicit operator bool() const noexcept;
+
+    int get() const noexcept;
+
+    bool is_blocking() const noexcept;
+
+    using basic_fd<basic_unique_fd>::poll;
+
+    int poll(short events) noexcept;
+
+    int poll(short events, int timeout) noexcept;
+
+    int release();
+
+    bool reset(int fd) noexcept;
+
+    bool set_blocking(bool enable) noexcept;
+
+    void swap(basic_unique_fd& fd) noexcept;
+
+private:
+    /** True if blocking behavior is enabled */
+    bool m_blocking;
+
+    /** The actual file descriptor */
+    int m_fd;
+};
+
+}  // namespace jfern
+
+#endif  // NETWORKING_BASIC_UNIQUE_FD_H_
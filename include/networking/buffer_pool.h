@@ -0,0 +1,69 @@
+/**
+ *  \file   buffer_pool.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#ifndef NETWORKING_BUFFER_POOL_H_
+#define NETWORKING_BUFFER_POOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace jfern {
+/**
+ * A free list of equally sized memory blocks, from which growable buffers
+ * draw their storage
+ *
+ * @details Blocks are obtained from the heap only when the free list is
+ *          empty, and are kept for reuse once released, so a steady stream of
+ *          messages stops allocating once the pool is warm
+ *
+ * @note This class is not thread-safe. Typically one pool is shared by all
+ *       connections serviced by an event loop. Every block must be released
+ *       before the pool is destroyed
+ */
+class buffer_pool final {
+public:
+    /**
+     * The default block size, in bytes
+     */
+    static constexpr std::size_t default_block_size = 4096;
+
+    explicit buffer_pool(std::size_t block_size = default_block_size);
+
+    buffer_pool(const buffer_pool& pool)            = delete;
+    buffer_pool(buffer_pool&& pool)                 = delete;
+    buffer_pool& operator=(const buffer_pool& pool) = delete;
+    buffer_pool& operator=(buffer_pool&& pool)      = delete;
+
+    ~buffer_pool();
+
+    std::uint8_t* allocate() noexcept;
+
+    std::size_t available() const noexcept;
+
+    std::size_t block_size() const noexcept;
+
+    void release(std::uint8_t* block);
+
+    std::size_t reserve(std::size_t n);
+
+private:
+    /**
+     * The size of each block, in bytes
+     */
+    std::size_t m_block_size;
+
+    /**
+     * Blocks available for reuse
+     */
+    std::vector<std::uint8_t*> m_free;
+};
+
+}  // namespace jfern
+
+#endif  // NETWORKING_BUFFER_POOL_H_
@@ -0,0 +1,170 @@
+/**
+ *  \file   chain_buffer.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#ifndef NETWORKING_CHAIN_BUFFER_H_
+#define NETWORKING_CHAIN_BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "networking/buffer_pool.h"
+#include "networking/iovec_builder.h"
+#include "networking/net.h"
+
+namespace jfern {
+/**
+ * Implements a growable buffer as a chain of fixed-size blocks
+ *
+ * @details A chain_buffer supports the same file stream semantics as
+ *          input_buffer and output_buffer combined. Writing past the end of
+ *          the last block appends another block from a buffer_pool, so a
+ *          message may grow without bound, and bytes already written are
+ *          never reallocated or moved. Reads and seeks are limited to the
+ *          bytes written so far
+ *
+ *          The blocks holding the written bytes can be handed to an
+ *          iovec_builder, so the contents are sent with a single writev()
+ *          without first being copied together
+ */
+class chain_buffer final {
+public:
+    explicit chain_buffer(buffer_pool& pool);
+
+    chain_buffer(const chain_buffer& buffer)            = delete;
+    chain_buffer(chain_buffer&& buffer);
+    chain_buffer& operator=(const chain_buffer& buffer) = delete;
+    chain_buffer& operator=(chain_buffer&& buffer);
+
+    ~chain_buffer();
+
+    template <std::size_t M>
+    bool append_to(iovec_builder<M>& iov) const noexcept;
+
+    std::size_t capacity() const noexcept;
+
+    void clear();
+
+    template <typename T>
+    bool read(T* data, bool bswap) noexcept;
+
+    bool read(std::uint8_t* data, std::size_t nbytes) noexcept;
+
+    bool reserve(std::size_t nbytes);
+
+    void rewind() noexcept;
+
+    bool seek(long int delta) noexcept;
+
+    bool seek_absolute(std::size_t new_offset) noexcept;
+
+    std::size_t segments() const noexcept;
+
+    std::size_t size() const noexcept;
+
+    std::size_t tell() const noexcept;
+
+    template <typename T>
+    bool write(const T& data, bool bswap);
+
+    bool write(const std::uint8_t* data, std::size_t nbytes);
+
+private:
+    void copy_in(const std::uint8_t* data, std::size_t nbytes) noexcept;
+
+    void copy_out(std::uint8_t* data, std::size_t nbytes) noexcept;
+
+    void release_blocks();
+
+    /**
+     * The blocks, in order
+     */
+    std::vector<std::uint8_t*> m_blocks;
+
+    /**
+     * The current buffer offset, in bytes
+     */
+    std::size_t m_offset;
+
+    /**
+     * The pool supplying our blocks
+     */
+    buffer_pool* m_pool;
+
+    /**
+     * The number of bytes written, i.e. one past the furthest offset written
+     */
+    std::size_t m_size;
+};
+
+/**
+ * Append the blocks holding the bytes written so far to a vectored transfer
+ *
+ * @param[in] iov The segments to append to
+ *
+ * @return True on success, or false if \a iov does not have room for all of
+ *         our segments, in which case those that fit were appended
+ */
+template <std::size_t M>
+bool chain_buffer::append_to(iovec_builder<M>& iov) const noexcept {
+    const std::size_t block_size = m_pool->block_size();
+
+    std::size_t remaining = m_size;
+
+    for (std::size_t i = 0; remaining > 0; i++) {
+        const std::size_t nbytes =
+            remaining < block_size ? remaining : block_size;
+
+        if (!iov.add(m_blocks[i], nbytes)) return false;
+
+        remaining -= nbytes;
+    }
+
+    return true;
+}
+
+/**
+ * Read an element from the buffer and advance the buffer pointer by the
+ * number of bytes read (i.e. the size of the element)
+ *
+ * @param data  The data element that was read
+ * @param bswap If true, byte swap \a data before returning
+ *
+ * @return True on success, or false if reading would pass the last byte
+ *         written
+ */
+template <typename T>
+bool chain_buffer::read(T* data, bool bswap) noexcept {
+    if (m_offset + sizeof(T) > m_size) return false;
+
+    copy_out(reinterpret_cast<std::uint8_t*>(data), sizeof(T));
+
+    if (bswap) *data = byte_swap<T>(*data);
+
+    return true;
+}
+
+/**
+ * Write an element to the buffer and advance the buffer pointer by the
+ * number of bytes written (i.e. the size of the element)
+ *
+ * @param data  The data element to write
+ * @param bswap If true, byte swap \a data before writing
+ *
+ * @return True on success, or false if a block could not be allocated
+ */
+template <typename T>
+bool chain_buffer::write(const T& data, bool bswap) {
+    const T output = bswap ? byte_swap<T>(data) : data;
+
+    return write(reinterpret_cast<const std::uint8_t*>(&output), sizeof(T));
+}
+
+}  // namespace jfern
+
+#endif  // NETWORKING_CHAIN_BUFFER_H_
@@ -27,21 +27,23 @@ namespace jfern {
  *          to or read from the buffer with the desired endianness. An internal
  *          pointer keeps track of the current buffer offset, enabling
  *          operations such as seek(), rewind(), and tell()
+ *
+ *          When the layout of a record is known, its size can be checked once
+ *          with input_buffer::require() or output_buffer::reserve(), after
+ *          which its fields are transferred with read_unchecked() or
+ *          write_unchecked(). These take the byte order as a template
+ *          argument, so a record compiles to a straight sequence of loads or
+ *          stores with no per-field branches
+ *
+ *          data_buffer is a base for input_buffer and output_buffer only, and
+ *          is not polymorphic: it has protected constructors and a protected,
+ *          non-virtual destructor, so buffers carry no vtable pointer
  * 
  * @tparam N The size of the buffer in bytes
  */
 template <std::size_t N>
 class data_buffer {
 public:
-    data_buffer();
-
-    data_buffer(const data_buffer& buffer)            = default;
-    data_buffer(data_buffer&& buffer)                 = default;
-    data_buffer& operator=(const data_buffer& buffer) = default;
-    data_buffer& operator=(data_buffer&& buffer)      = default;
-
-    virtual ~data_buffer() = 0;
-
     const std::uint8_t* data() const noexcept;
 
     void rewind() noexcept;
@@ -55,6 +57,15 @@ public:
     std::size_t tell() const noexcept;
 
 protected:
+    data_buffer();
+
+    data_buffer(const data_buffer& buffer)            = default;
+    data_buffer(data_buffer&& buffer)                 = default;
+    data_buffer& operator=(const data_buffer& buffer) = default;
+    data_buffer& operator=(data_buffer&& buffer)      = default;
+
+    ~data_buffer() = default;
+
     /**
      * The underlying buffer
      */
@@ -81,10 +92,19 @@ public:
 
     ~input_buffer() = default;
 
+    using data_buffer<N>::data;
+
+    std::uint8_t* data() noexcept;
+
     template <typename T>
     bool read(T* data, bool bswap) noexcept;
 
     bool read(std::uint8_t* data, std::size_t nbytes) noexcept;
+
+    template <bool Bswap, typename T>
+    void read_unchecked(T* data) noexcept;
+
+    bool require(std::size_t nbytes) const noexcept;
 };
 
 /**
@@ -102,10 +122,15 @@ public:
 
     ~output_buffer() = default;
 
+    bool reserve(std::size_t nbytes) const noexcept;
+
     template <typename T>
     bool write(const T& data, bool bswap) noexcept;
 
     bool write(const std::uint8_t* data, std::size_t nbytes) noexcept;
+
+    template <bool Bswap, typename T>
+    void write_unchecked(const T& data) noexcept;
 };
 
 /**
@@ -202,7 +227,18 @@ std::size_t data_buffer<N>::tell() const noexcept {
  * Constructor
  */
 template <std::size_t N>
-input_buffer<N>::input_buffer() : data_buffer() {
+input_buffer<N>::input_buffer() : data_buffer<N>() {
+}
+
+/**
+ * Returns a writable pointer to the underlying storage, e.g. for filling the
+ * buffer directly from a file descriptor
+ *
+ * @return A pointer to the underlying storage
+ */
+template <std::size_t N>
+std::uint8_t* input_buffer<N>::data() noexcept {
+    return this->m_buf.data();
 }
 
 /**
@@ -217,14 +253,14 @@ input_buffer<N>::input_buffer() : data_buffer() {
 template <std::size_t N>
 template <typename T>
 bool input_buffer<N>::read(T* data, bool bswap) noexcept {
-    const std::size_t new_pos = m_offset + sizeof(T);
+    const std::size_t new_pos = this->m_offset + sizeof(T);
     if (new_pos > N) return false;
 
-    std::memcpy(data, &m_buf[ m_offset ], sizeof(T));
+    std::memcpy(data, &this->m_buf[ this->m_offset ], sizeof(T));
 
     if (bswap) *data = byte_swap<T>(*data);
 
-    m_offset = new_pos;
+    this->m_offset = new_pos;
     return true;
 }
 
@@ -239,20 +275,67 @@ bool input_buffer<N>::read(T* data, bool bswap) noexcept {
  */
 template <std::size_t N>
 bool input_buffer<N>::read(std::uint8_t* data, std::size_t nbytes) noexcept {
-    const std::size_t new_pos = m_offset + nbytes;
+    const std::size_t new_pos = this->m_offset + nbytes;
     if (new_pos > N) return false;
 
-    std::memcpy(data, &m_buf[ m_offset ], nbytes);
+    std::memcpy(data, &this->m_buf[ this->m_offset ], nbytes);
 
-    m_offset = new_pos;
+    this->m_offset = new_pos;
     return true;
 }
 
+/**
+ * Read an element from the data buffer without checking bounds, and advance
+ * the buffer pointer by the number of bytes read
+ *
+ * @note The caller must first ensure, e.g. via require(), that the element
+ *       lies within the buffer
+ *
+ * @tparam Bswap If true, byte swap \a data before returning
+ *
+ * @param data The data element that was read
+ */
+template <std::size_t N>
+template <bool Bswap, typename T>
+void input_buffer<N>::read_unchecked(T* data) noexcept {
+    std::memcpy(data, this->m_buf.data() + this->m_offset, sizeof(T));
+
+    if constexpr (Bswap) *data = byte_swap<T>(*data);
+
+    this->m_offset += sizeof(T);
+}
+
+/**
+ * Check whether a number of bytes can be read from the current offset, e.g.
+ * before reading a record with read_unchecked()
+ *
+ * @param nbytes The number of bytes to be read
+ *
+ * @return True if reading \a nbytes would not overrun the buffer
+ */
+template <std::size_t N>
+bool input_buffer<N>::require(std::size_t nbytes) const noexcept {
+    return nbytes <= N - this->m_offset;
+}
+
 /**
  * Constructor
  */
 template <std::size_t N>
-output_buffer<N>::output_buffer() : data_buffer() {
+output_buffer<N>::output_buffer() : data_buffer<N>() {
+}
+
+/**
+ * Check whether a number of bytes can be written at the current offset, e.g.
+ * before writing a record with write_unchecked()
+ *
+ * @param nbytes The number of bytes to be written
+ *
+ * @return True if writing \a nbytes would not overrun the buffer
+ */
+template <std::size_t N>
+bool output_buffer<N>::reserve(std::size_t nbytes) const noexcept {
+    return nbytes <= N - this->m_offset;
 }
 
 /**
@@ -267,14 +350,14 @@ output_buffer<N>::output_buffer() : data_buffer() {
 template <std::size_t N>
 template <typename T>
 bool output_buffer<N>::write(const T& data, bool bswap) noexcept {
-    const std::size_t new_pos = m_offset + sizeof(T);
+    const std::size_t new_pos = this->m_offset + sizeof(T);
     if (new_pos > N) return false;
 
     T output = bswap ? byte_swap<T>(data) : data;
 
-    std::memcpy(&m_buf[m_offset], &output, sizeof(T));
+    std::memcpy(&this->m_buf[this->m_offset], &output, sizeof(T));
 
-    m_offset = new_pos;
+    this->m_offset = new_pos;
     return true;
 }
 
@@ -290,15 +373,37 @@ bool output_buffer<N>::write(const T& data, bool bswap) noexcept {
 template <size_t N>
 bool output_buffer<N>::write(const std::uint8_t* data,
                              std::size_t nbytes) noexcept {
-    const std::size_t new_pos = m_offset + nbytes;
+    const std::size_t new_pos = this->m_offset + nbytes;
     if (new_pos > N) return false;
 
-    std::memcpy(&m_buf[ m_offset ], data, nbytes);
+    std::memcpy(&this->m_buf[ this->m_offset ], data, nbytes);
 
-    m_offset = new_pos;
+    this->m_offset = new_pos;
     return true;
 }
 
+/**
+ * Write an element to the data buffer without checking bounds, and advance
+ * the buffer pointer by the number of bytes written
+ *
+ * @note The caller must first ensure, e.g. via reserve(), that the element
+ *       fits within the buffer
+ *
+ * @tparam Bswap If true, byte swap \a data before writing
+ *
+ * @param data The data element to write
+ */
+template <std::size_t N>
+template <bool Bswap, typename T>
+void output_buffer<N>::write_unchecked(const T& data) noexcept {
+    T output = data;
+    if constexpr (Bswap) output = byte_swap<T>(data);
+
+    std::memcpy(this->m_buf.data() + this->m_offset, &output, sizeof(T));
+
+    this->m_offset += sizeof(T);
+}
+
 }  // namespace jfern
 
 #endif  // NETWORKING_DATA_BUFFER_H_
@@ -0,0 +1,101 @@
+/**
+ *  \file   edge_io.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#ifndef NETWORKING_EDGE_IO_H_
+#define NETWORKING_EDGE_IO_H_
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "networking/fd_interface.h"
+
+namespace jfern {
+/**
+ * @class edge_io
+ *
+ * Performs reads and writes on an edge-triggered file descriptor
+ *
+ * @details
+ * With edge triggering, readiness is only reported when it changes, so a
+ * handler must keep reading (or writing) until the kernel reports EAGAIN or
+ * the next wakeup may never come. An edge_io loops over posix_read() and
+ * posix_write() until the descriptor would block, but stops early once a
+ * per-wakeup byte budget is consumed so that a single busy descriptor cannot
+ * starve the others. Any direction left undrained is reported by pending(),
+ * which lets the reactor re-dispatch the handler without waiting for a new
+ * edge
+ *
+ * @note The file descriptor must be non-blocking
+ */
+class edge_io final {
+public:
+    edge_io(fd_interface& fd, std::size_t budget) noexcept;
+
+    edge_io(const edge_io& io)            = delete;
+    edge_io(edge_io&& io)                 = delete;
+    edge_io& operator=(const edge_io& io) = delete;
+    edge_io& operator=(edge_io&& io)      = delete;
+
+    ~edge_io() = default;
+
+    bool eof() const noexcept;
+
+    bool exhausted() const noexcept;
+
+    fd_interface& fd() noexcept;
+
+    short pending() const noexcept;
+
+    ssize_t read(std::uint8_t* buf, std::size_t nbytes) noexcept;
+
+    bool read_blocked() const noexcept;
+
+    std::size_t remaining() const noexcept;
+
+    ssize_t write(const std::uint8_t* buf, std::size_t nbytes) noexcept;
+
+    bool write_blocked() const noexcept;
+
+private:
+    /**
+     * The number of bytes that may still be transferred during this wakeup
+     */
+    std::size_t m_budget;
+
+    /**
+     * True if a read returned end-of-file
+     */
+    bool m_eof;
+
+    /**
+     * The file descriptor being drained
+     */
+    fd_interface& m_fd;
+
+    /**
+     * Mask of events (POLLIN and/or POLLOUT) for which the descriptor was
+     * not driven to EAGAIN
+     */
+    short m_pending;
+
+    /**
+     * True if the last read stopped because the descriptor would block
+     */
+    bool m_read_blocked;
+
+    /**
+     * True if the last write stopped because the descriptor would block
+     */
+    bool m_write_blocked;
+};
+
+}  // namespace jfern
+
+#endif  // NETWORKING_EDGE_IO_H_
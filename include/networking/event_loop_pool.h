@@ -0,0 +1,177 @@
+/**
+ *  \file   event_loop_pool.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#ifndef NETWORKING_EVENT_LOOP_POOL_H_
+#define NETWORKING_EVENT_LOOP_POOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "networking/fd_event_sink.h"
+#include "networking/reactor.h"
+
+namespace jfern {
+/**
+ * @class event_loop_pool
+ *
+ * Runs a fixed number of event loops, each on its own thread
+ *
+ * @details
+ * Each loop owns a \ref reactor, i.e. its own epoll set of fd_event_sinks,
+ * and an eventfd used to wake it. A sink added with add() is assigned to the
+ * loop with the fewest sinks and stays there, so its handlers always run on
+ * the same thread and need no locking among themselves
+ *
+ * Handlers should not do CPU-heavy work inline, since that delays every
+ * other descriptor on the same loop. Instead, they may hand the work off as a
+ * continuation with spawn(). Continuations are queued on the spawning loop
+ * and run between polls, one per iteration, so readiness processing keeps
+ * flowing; loops with nothing to do steal queued continuations from the
+ * others
+ *
+ * From within a handler, continuation, or task, this_loop() gives the
+ * calling loop's reactor, e.g. to schedule timers or to update() a sink
+ *
+ * @note Continuations and tasks which have not run when the pool is
+ *       destroyed are discarded
+ */
+class event_loop_pool final {
+public:
+    explicit event_loop_pool(std::size_t n_loops =
+                                 std::thread::hardware_concurrency());
+
+    event_loop_pool(const event_loop_pool& pool)            = delete;
+    event_loop_pool(event_loop_pool&& pool)                 = delete;
+    event_loop_pool& operator=(const event_loop_pool& pool) = delete;
+    event_loop_pool& operator=(event_loop_pool&& pool)      = delete;
+
+    ~event_loop_pool();
+
+    explicit operator bool() const noexcept;
+
+    int add(std::shared_ptr<fd_event_sink> sink);
+
+    std::size_t load(std::size_t index) const noexcept;
+
+    bool post(std::size_t index, std::function<void()> task);
+
+    bool remove(int fd);
+
+    std::size_t size() const noexcept;
+
+    bool spawn(std::function<void()> task);
+
+    static reactor* this_loop() noexcept;
+
+private:
+    /**
+     * @brief An event loop and its thread
+     */
+    struct loop {
+        loop();
+
+        /**
+         * Guards \ref inbox
+         */
+        std::mutex inbox_mutex;
+
+        /**
+         * Tasks posted to this loop by other threads
+         */
+        std::vector<std::function<void()>> inbox;
+
+        /**
+         * The number of sinks assigned to this loop
+         */
+        std::atomic<std::size_t> load;
+
+        /**
+         * True while the loop is blocked waiting for events
+         */
+        std::atomic<bool> sleeping;
+
+        /**
+         * Guards \ref tasks
+         */
+        std::mutex task_mutex;
+
+        /**
+         * Continuations spawned on this loop. The loop pops from the back,
+         * thieves take from the front
+         */
+        std::deque<std::function<void()>> tasks;
+
+        /**
+         * The thread running the loop
+         */
+        std::thread thread;
+
+        /**
+         * Owns the eventfd which is written to wake the loop
+         */
+        std::shared_ptr<fd_event_sink> wakeup;
+
+        /**
+         * The epoll set of the loop
+         */
+        reactor events;
+    };
+
+    void run(std::size_t index);
+
+    bool run_task(std::size_t index);
+
+    void wake(loop& target);
+
+    /**
+     * The event loops
+     */
+    std::vector<std::unique_ptr<loop>> m_loops;
+
+    /**
+     * Guards \ref m_owners
+     */
+    std::mutex m_owners_mutex;
+
+    /**
+     * The index of the loop each registered file descriptor is assigned to
+     */
+    std::unordered_map<int, std::size_t> m_owners;
+
+    /**
+     * The number of continuations queued on all loops
+     */
+    std::atomic<std::size_t> m_queued;
+
+    /**
+     * Picks the loop which receives continuations spawned from outside
+     * the pool
+     */
+    std::atomic<std::size_t> m_next;
+
+    /**
+     * Set when the pool is being destroyed
+     */
+    std::atomic<bool> m_stopping;
+
+    /**
+     * True if every loop was created successfully
+     */
+    bool m_valid;
+};
+
+}  // namespace jfern
+
+#endif  // NETWORKING_EVENT_LOOP_POOL_H_
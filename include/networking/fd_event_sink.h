@@ -9,46 +9,118 @@
 #ifndef NETWORKING_FD_EVENT_SINK_H_
 #define NETWORKING_FD_EVENT_SINK_H_
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
-#include <vector>
+#include <utility>
 
+#include "edge_io.h"
 #include "fd_interface.h"
+#include "inplace_function.h"
 
 namespace jfern {
 /**
  * @class fd_event_sink
  *
  * Dispatches handlers that respond to file descriptor events
+ *
+ * @details
+ * Handlers are either level-triggered, receiving the file descriptor itself,
+ * or edge-triggered, receiving an \ref edge_io which drains the descriptor
+ * until it would block. The handlers of a sink must all be of one kind, and
+ * a sink with edge-triggered handlers is registered with EPOLLET by the
+ * \ref reactor. Edge-triggered handlers share a per-wakeup byte budget (see
+ * set_budget()), and any events left undrained are returned from
+ * handle_events() so they can be dispatched again
+ *
+ * Each event bit is owned by at most one handler, the one most recently
+ * added for it. A table indexed by event bit records the owner of each, so
+ * adding, removing, and dispatching handlers take time proportional to the
+ * number of event bits involved, never to the number of handlers. A handler
+ * is called at most once per call to handle_events(), however many of its
+ * events occurred
  */
 class fd_event_sink final {
 public:
+    /**
+     * Callback invoked with an edge_io that drains the file descriptor
+     */
+    using edge_handler_t = inplace_function<void(short revents, edge_io& io)>;
+
+    /**
+     * The default number of bytes edge-triggered handlers may transfer per
+     * wakeup
+     */
+    static constexpr std::size_t default_budget = 64 * 1024;
+
     explicit fd_event_sink(std::unique_ptr<fd_interface> fd);
 
-    fd_event_sink(const fd_event_sink& sink)            = default;
+    fd_event_sink(const fd_event_sink& sink)            = delete;
     fd_event_sink(fd_event_sink&& sink)                 = default;
-    fd_event_sink& operator=(const fd_event_sink& sink) = default;
+    fd_event_sink& operator=(const fd_event_sink& sink) = delete;
     fd_event_sink& operator=(fd_event_sink&& sink)      = default;
 
     ~fd_event_sink() = default;
 
+    bool add_edge_events(short events, edge_handler_t handler);
+
     bool add_events(short events, fd_interface::event_handler_t handler);
 
+    std::size_t budget() const noexcept;
+
     void clear_events();
 
-    void handle_events(short events);
+    bool edge_triggered() const noexcept;
+
+    short events() const noexcept;
+
+    int get() const noexcept;
+
+    short handle_events(short events);
 
     void remove_events(short events);
 
+    void set_budget(std::size_t nbytes) noexcept;
+
 private:
-    void erase_null_events();
+    /**
+     * The number of distinct event bits, and so the most handlers a sink may
+     * hold at once
+     */
+    static constexpr std::size_t max_handlers = 8 * sizeof(short);
+
+    /**
+     * The number of handler slots. One more than \ref max_handlers, since a
+     * handler which removes itself keeps its slot until it returns
+     */
+    static constexpr std::size_t max_slots = max_handlers + 1;
+
+    /**
+     * Marks that no handler is running
+     */
+    static constexpr std::size_t npos = max_slots;
+
+    void attach_events(std::uint16_t events, std::size_t index);
+
+    void detach_events(std::uint16_t events);
+
+    bool mixes_modes(std::uint16_t events, bool edge) const;
+
+    std::size_t allocate_slot();
+
+    void release_slot(std::size_t index);
 
     /**
-     * @brief Mapping from event(s) to event handler
+     * @brief A handler and the events it owns
      */
     struct callback_info {
-        callback_info(short mask_,
-                      fd_interface::event_handler_t handler_)
-            : handler(handler_), mask(mask_) {}
+        callback_info() : edge_handler(), handler(), mask(0) {}
+
+        /**
+         * Edge-triggered handler, if this is not a level-triggered event
+         */
+        edge_handler_t edge_handler;
 
         /**
          * Called back in reponse to one or more of the events specified
@@ -57,15 +129,58 @@ private:
         fd_interface::event_handler_t handler;
 
         /**
-         * Bitmask of events that will trigger the handler
+         * Bitmask of events that will trigger the handler. Zero if this slot
+         * is free
          */
-        short mask;
+        std::uint16_t mask;
     };
 
     /**
-     * Events of interest on the file descriptor and their handlers
+     * Maximum bytes transferred per wakeup by edge-triggered handlers
+     */
+    std::size_t m_budget;
+
+    /**
+     * Bit i is set if m_handlers[i] is edge-triggered
+     */
+    std::uint32_t m_edge_slots;
+
+    /**
+     * Bit i is set if m_handlers[i] holds no handler
+     */
+    std::uint32_t m_free_slots;
+
+    /**
+     * Handler slots. Slots are reused once free. Their addresses never
+     * change, so handlers may add and remove handlers while they run
+     */
+    std::array<callback_info, max_slots> m_handlers;
+
+    /**
+     * Bitmask of all events which have a handler
+     */
+    std::uint16_t m_mask;
+
+    /**
+     * For each event bit in \ref m_mask, the index of the handler that owns it
+     */
+    std::array<std::uint8_t, max_handlers> m_owners;
+
+    /**
+     * True if the running handler removed itself, so that its slot must be
+     * freed once it returns
+     */
+    bool m_retired;
+
+    /**
+     * The slot of the handler being dispatched, or \ref npos
+     */
+    std::size_t m_running;
+
+    /**
+     * Slots still to be dispatched by the current call to handle_events()
      */
-    std::vector<callback_info> m_events;
+    std::uint32_t m_targets;
 
     /**
      * The file descriptor itself (owned by *this)
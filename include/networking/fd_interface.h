@@ -9,7 +9,7 @@
 #ifndef NETWORKING_FD_INTERFACE_H_
 #define NETWORKING_FD_INTERFACE_H_
 
-#include <functional>
+#include "inplace_function.h"
 
 namespace jfern {
 /**
@@ -18,9 +18,11 @@ namespace jfern {
 class fd_interface {
 public:
     /**
-     * Callback invoked when \ref poll() returns valid events
+     * Callback invoked when \ref poll() returns valid events. Its captures
+     * are stored inline, so registering a handler never allocates
      */
-    using event_handler_t = std::function<void(short revents, fd_interface&)>;
+    using event_handler_t =
+        inplace_function<void(short revents, fd_interface&)>;
 
     virtual ~fd_interface() = default;
 
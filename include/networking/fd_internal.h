@@ -11,10 +11,31 @@
 
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <mutex>
+#include <thread>
+
+#include "networking/ref_counts.h"
 
 namespace jfern {
 namespace fd {
+/**
+ * Determines how owners in different threads coordinate system calls on a
+ * shared file descriptor
+ */
+enum class concurrency {
+    /**
+     * Polling and flag changes are serialized on a per-descriptor mutex
+     */
+    serialized,
+
+    /**
+     * Polls proceed concurrently, and flag changes are made against a cached
+     * copy of the file status flags using compare-and-swap
+     */
+    lock_free
+};
+
 /**
  * Maintains data shared between all owners of the file descriptor, including
  * owners in other threads
@@ -27,16 +48,43 @@ namespace fd {
  *       reference count is always at least equal to the strong reference count,
  *       the destruction of *this is guaranteed not to happen before the file
  *       descriptor is closed
+ *
+ * @note The file descriptor is only closed once the last strong reference is
+ *       released. Since any thread making a system call on it must hold such
+ *       a reference, no call is ever in flight when the descriptor is closed,
+ *       with or without the mutex
+ *
+ * @note Instances are carved from a pool of fixed-size blocks rather than the
+ *       general-purpose heap. Each thread keeps a small cache of free blocks
+ *       and exchanges them with a shared free list in batches, so creating and
+ *       destroying shared_fds at high rates (e.g. one per accepted connection)
+ *       rarely takes a lock and never calls malloc() once the pool is warm
+ *
+ * @note By default the strong and weak reference counts each occupy their own
+ *       cache line, so threads copying shared_fds do not contend with threads
+ *       copying weak_fds. See \ref counter_layout
  */
 class shared_internal final {
 public:
-    explicit shared_internal(int fd);
+    explicit shared_internal(int fd,
+                             concurrency mode = concurrency::serialized);
+
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size) noexcept;
+
+    static std::size_t reserve(std::size_t n);
 
     std::size_t count() const;
     std::size_t weak_count() const;
 
     int get() const;
 
+    std::uint32_t generation() const;
+    int is_blocking() const;
+    concurrency mode() const;
+    int poll(short events, int timeout);
+    bool set_blocking(bool enable);
+
     void add_reference();
     bool add_reference_if_valid();
     bool release();
@@ -50,15 +98,79 @@ public:
      */
     std::mutex m_mutex;
 
+private:
+    std::uint64_t load_status();
+
+    /** The actual file descriptor */
+    int m_fd;
+
+    /** How concurrent system calls are coordinated */
+    concurrency m_mode;
+
+    /**
+     * Cached file status flags (low word) and the number of times they have
+     * been changed plus one (high word). Zero until the flags are first read
+     */
+    std::atomic<std::uint64_t> m_status;
+
+    /**
+     * The strong and weak reference counts. Placed last so that, when padded,
+     * the fields above share the first cache line
+     */
+    ref_counts<default_counter_layout> m_counts;
+};
+
+/**
+ * Maintains data shared between owners of a file descriptor which all live in
+ * the same thread. Reference counting is not atomic
+ *
+ * @details Once promoted, the file descriptor is managed by a shared_internal
+ *          which may be shared with other threads. *this then holds a single
+ *          strong reference to it on behalf of all local owners, and releases
+ *          it instead of closing the file descriptor
+ *
+ * @note With the exception of owner(), all members must be called from the
+ *       owning thread
+ */
+class local_internal final {
+public:
+    explicit local_internal(int fd);
+
+    local_internal(const local_internal& info)            = delete;
+    local_internal(local_internal&& info)                 = delete;
+    local_internal& operator=(const local_internal& info) = delete;
+    local_internal& operator=(local_internal&& info)      = delete;
+
+    ~local_internal() = default;
+
+    std::size_t count() const;
+
+    int get() const;
+
+    std::thread::id owner() const;
+
+    shared_internal* promote(concurrency mode);
+
+    shared_internal* shared() const;
+
+    void add_reference();
+    bool release();
+
+    /** True if blocking behavior is enabled */
+    bool m_blocking;
+
 private:
     /** The reference count */
-    std::atomic<std::size_t> m_count;
+    std::size_t m_count;
 
     /** The actual file descriptor */
     int m_fd;
 
-    /** The weak reference count */
-    std::atomic<std::size_t> m_weak_count;
+    /** The thread which created *this */
+    std::thread::id m_owner;
+
+    /** The shared control block, if promoted */
+    shared_internal* m_shared;
 };
 
 }  // namespace fd
@@ -0,0 +1,342 @@
+/**
+ *  \file   inplace_function.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#ifndef NETWORKING_INPLACE_FUNCTION_H_
+#define NETWORKING_INPLACE_FUNCTION_H_
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace jfern {
+template <typename Signature,
+          std::size_t Capacity  = 48,
+          std::size_t Alignment = alignof(std::max_align_t)>
+class inplace_function;
+
+/**
+ * @class inplace_function
+ *
+ * A move-only callable wrapper, similar to std::function, whose target is
+ * always stored inline
+ *
+ * @details
+ * The target is constructed in a fixed buffer of \a Capacity bytes, so
+ * creating, moving, and destroying an inplace_function never allocates. A
+ * target which does not fit is rejected at compile time rather than moved to
+ * the heap. Targets need not be copyable, so e.g. lambdas which capture a
+ * unique_ptr may be stored. With the default capacity, an inplace_function
+ * occupies a single cache line
+ *
+ * @tparam R         The return type
+ * @tparam Args      The argument types
+ * @tparam Capacity  The size of the inline buffer, in bytes
+ * @tparam Alignment The alignment of the inline buffer
+ */
+template <typename R, typename... Args,
+          std::size_t Capacity, std::size_t Alignment>
+class inplace_function<R(Args...), Capacity, Alignment> final {
+    /**
+     * True if \a F may be stored as a target
+     */
+    template <typename F>
+    using enable_if_target_t = std::enable_if_t<
+        !std::is_same<std::decay_t<F>, inplace_function>::value &&
+        std::is_invocable_r<R, std::decay_t<F>&, Args...>::value>;
+
+public:
+    /**
+     * The size of the inline buffer, in bytes
+     */
+    static constexpr std::size_t capacity = Capacity;
+
+    inplace_function() noexcept;
+
+    inplace_function(std::nullptr_t) noexcept;  // NOLINT
+
+    template <typename F, typename = enable_if_target_t<F>>
+    inplace_function(F&& f);  // NOLINT
+
+    inplace_function(const inplace_function& f)            = delete;
+    inplace_function(inplace_function&& f) noexcept;
+    inplace_function& operator=(const inplace_function& f) = delete;
+    inplace_function& operator=(inplace_function&& f) noexcept;
+
+    inplace_function& operator=(std::nullptr_t) noexcept;
+
+    ~inplace_function();
+
+    explicit operator bool() const noexcept;
+
+    R operator()(Args... args) const;
+
+private:
+    /**
+     * @brief Type-erased operations on a target
+     */
+    struct operations {
+        /**
+         * Call the target
+         */
+        R (*invoke)(void* target, Args&&... args);
+
+        /**
+         * Move-construct the target at \a from into \a to, then destroy
+         * the target at \a from
+         */
+        void (*relocate)(void* from, void* to) noexcept;
+
+        /**
+         * Destroy the target
+         */
+        void (*destroy)(void* target) noexcept;
+    };
+
+    template <typename F>
+    static R invoke(void* target, Args&&... args);
+
+    template <typename F>
+    static void relocate(void* from, void* to) noexcept;
+
+    template <typename F>
+    static void destroy(void* target) noexcept;
+
+    /**
+     * The operations for targets of type \a F
+     */
+    template <typename F>
+    static constexpr operations operations_for = {
+        &invoke<F>, &relocate<F>, &destroy<F>
+    };
+
+    void clear() noexcept;
+
+    /**
+     * Operations on the current target, or null if there is none
+     */
+    const operations* m_ops;
+
+    /**
+     * Inline storage for the target
+     */
+    alignas(Alignment) unsigned char m_storage[Capacity];
+};
+
+/**
+ * Default constructor. Creates an inplace_function with no target
+ */
+template <typename R, typename... Args,
+          std::size_t Capacity, std::size_t Alignment>
+inplace_function<R(Args...), Capacity, Alignment>::inplace_function() noexcept
+    : m_ops(nullptr) {
+}
+
+/**
+ * Constructor. Creates an inplace_function with no target
+ */
+template <typename R, typename... Args,
+          std::size_t Capacity, std::size_t Alignment>
+inplace_function<R(Args...), Capacity, Alignment>::inplace_function(
+    std::nullptr_t) noexcept : m_ops(nullptr) {
+}
+
+/**
+ * Constructor
+ *
+ * @param[in] f The target, which is moved or copied into the inline buffer.
+ *              A null function or member pointer yields an empty
+ *              inplace_function
+ */
+template <typename R, typename... Args,
+          std::size_t Capacity, std::size_t Alignment>
+template <typename F, typename>
+inplace_function<R(Args...), Capacity, Alignment>::inplace_function(F&& f)
+    : m_ops(nullptr) {
+    using target_t = std::decay_t<F>;
+
+    static_assert(sizeof(target_t) <= Capacity,
+                  "inplace_function: target exceeds the inline capacity");
+    static_assert(Alignment % alignof(target_t) == 0,
+                  "inplace_function: target is over-aligned");
+    static_assert(std::is_nothrow_move_constructible<target_t>::value,
+                  "inplace_function: target must be nothrow movable");
+
+    // A function reference decays to a pointer, but is never null
+    using argument_t = std::remove_reference_t<F>;
+
+    if constexpr (std::is_pointer<argument_t>::value ||
+                  std::is_member_pointer<argument_t>::value) {
+        if (f == nullptr) return;
+    }
+
+    ::new (static_cast<void*>(m_storage)) target_t(std::forward<F>(f));
+    m_ops = &operations_for<target_t>;
+}
+
+/**
+ * Move constructor
+ *
+ * @param[in] f The inplace_function whose target is moved into *this. It is
+ *              left empty
+ */
+template <typename R, typename... Args,
+          std::size_t Capacity, std::size_t Alignment>
+inplace_function<R(Args...), Capacity, Alignment>::inplace_function(
+    inplace_function&& f) noexcept : m_ops(f.m_ops) {
+    if (m_ops) {
+        m_ops->relocate(f.m_storage, m_storage);
+        f.m_ops = nullptr;
+    }
+}
+
+/**
+ * Move assignment operator
+ *
+ * @param[in] f The inplace_function whose target is moved into *this. It is
+ *              left empty
+ *
+ * @return *this
+ */
+template <typename R, typename... Args,
+          std::size_t Capacity, std::size_t Alignment>
+auto inplace_function<R(Args...), Capacity, Alignment>::operator=(
+    inplace_function&& f) noexcept -> inplace_function& {
+    if (this != &f) {
+        clear();
+
+        if (f.m_ops) {
+            f.m_ops->relocate(f.m_storage, m_storage);
+            m_ops = f.m_ops;
+            f.m_ops = nullptr;
+        }
+    }
+
+    return *this;
+}
+
+/**
+ * Destroy the current target, if any
+ *
+ * @return *this
+ */
+template <typename R, typename... Args,
+          std::size_t Capacity, std::size_t Alignment>
+auto inplace_function<R(Args...), Capacity, Alignment>::operator=(
+    std::nullptr_t) noexcept -> inplace_function& {
+    clear();
+    return *this;
+}
+
+/**
+ * Destructor
+ */
+template <typename R, typename... Args,
+          std::size_t Capacity, std::size_t Alignment>
+inplace_function<R(Args...), Capacity, Alignment>::~inplace_function() {
+    clear();
+}
+
+/**
+ * Check whether there is a target
+ *
+ * @return True if this inplace_function may be called
+ */
+template <typename R, typename... Args,
+          std::size_t Capacity, std::size_t Alignment>
+inplace_function<R(Args...), Capacity, Alignment>::operator bool()
+    const noexcept {
+    return m_ops != nullptr;
+}
+
+/**
+ * Call the target
+ *
+ * @note There must be a target
+ *
+ * @param[in] args The arguments to forward to the target
+ *
+ * @return The result of the call
+ */
+template <typename R, typename... Args,
+          std::size_t Capacity, std::size_t Alignment>
+R inplace_function<R(Args...), Capacity, Alignment>::operator()(
+    Args... args) const {
+    // As with std::function, a const wrapper may call a non-const target
+    return m_ops->invoke(const_cast<unsigned char*>(m_storage),
+                         std::forward<Args>(args)...);
+}
+
+/**
+ * Call a target of type \a F
+ *
+ * @param[in] target The target
+ * @param[in] args   The arguments to forward to the target
+ *
+ * @return The result of the call
+ */
+template <typename R, typename... Args,
+          std::size_t Capacity, std::size_t Alignment>
+template <typename F>
+R inplace_function<R(Args...), Capacity, Alignment>::invoke(
+    void* target, Args&&... args) {
+    F& f = *std::launder(static_cast<F*>(target));
+
+    if constexpr (std::is_void<R>::value) {
+        std::invoke(f, std::forward<Args>(args)...);
+    } else {
+        return std::invoke(f, std::forward<Args>(args)...);
+    }
+}
+
+/**
+ * Move a target of type \a F to new storage
+ *
+ * @param[in] from The target to move, which is destroyed
+ * @param[in] to   The storage to move it into
+ */
+template <typename R, typename... Args,
+          std::size_t Capacity, std::size_t Alignment>
+template <typename F>
+void inplace_function<R(Args...), Capacity, Alignment>::relocate(
+    void* from, void* to) noexcept {
+    F* source = std::launder(static_cast<F*>(from));
+
+    ::new (to) F(std::move(*source));
+    source->~F();
+}
+
+/**
+ * Destroy a target of type \a F
+ *
+ * @param[in] target The target
+ */
+template <typename R, typename... Args,
+          std::size_t Capacity, std::size_t Alignment>
+template <typename F>
+void inplace_function<R(Args...), Capacity, Alignment>::destroy(
+    void* target) noexcept {
+    std::launder(static_cast<F*>(target))->~F();
+}
+
+/**
+ * Destroy the current target, if any
+ */
+template <typename R, typename... Args,
+          std::size_t Capacity, std::size_t Alignment>
+void inplace_function<R(Args...), Capacity, Alignment>::clear() noexcept {
+    if (m_ops) {
+        m_ops->destroy(m_storage);
+        m_ops = nullptr;
+    }
+}
+
+}  // namespace jfern
+
+#endif  // NETWORKING_INPLACE_FUNCTION_H_
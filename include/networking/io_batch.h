@@ -0,0 +1,192 @@
+/**
+ *  \file   io_batch.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#ifndef NETWORKING_IO_BATCH_H_
+#define NETWORKING_IO_BATCH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "networking/fd_event_sink.h"
+
+struct io_uring_cqe;
+struct io_uring_sqe;
+
+namespace jfern {
+/**
+ * @class io_batch
+ *
+ * Queues reads, writes, polls, and closes and submits them together
+ *
+ * @details
+ * On kernels which support it, requests are placed on an io_uring submission
+ * queue and handed to the kernel with a single io_uring_enter() per call to
+ * submit(). Completions are reaped from the completion queue and passed to
+ * the handler supplied with each request. If io_uring is unavailable (e.g.
+ * disabled by seccomp or an older kernel) the same requests are serviced at
+ * submit() time through the posix_api wrappers, with all outstanding polls
+ * combined into a single poll(2). A read or write which would block joins
+ * that poll(2) and is retried once its descriptor is ready, so on either
+ * backend it completes with data rather than -EAGAIN
+ *
+ * As with io_uring, a handler receives the result of its request: the number
+ * of bytes transferred for reads and writes, the returned events for polls,
+ * and zero for closes. On failure it receives a negated errno value
+ *
+ * @note Buffers passed to read() and write() must remain valid until their
+ *       handler is called, or until the batch is destroyed. This class is
+ *       not thread-safe
+ */
+class io_batch final {
+public:
+    /**
+     * Callback invoked with the result of a request
+     */
+    using completion_handler_t = std::function<void(int result)>;
+
+    explicit io_batch(unsigned entries = 256, bool use_io_uring = true);
+
+    io_batch(const io_batch& batch)            = delete;
+    io_batch(io_batch&& batch)                 = delete;
+    io_batch& operator=(const io_batch& batch) = delete;
+    io_batch& operator=(io_batch&& batch)      = delete;
+
+    ~io_batch();
+
+    bool close(int fd, completion_handler_t handler);
+
+    std::size_t in_flight() const noexcept;
+
+    bool poll(int fd, short events, completion_handler_t handler);
+
+    bool poll(const std::shared_ptr<fd_event_sink>& sink);
+
+    bool read(int fd, std::uint8_t* buf, std::size_t nbytes,
+              completion_handler_t handler);
+
+    int submit(unsigned min_complete = 0);
+
+    bool using_io_uring() const noexcept;
+
+    bool write(int fd, const std::uint8_t* buf, std::size_t nbytes,
+               completion_handler_t handler);
+
+private:
+    /**
+     * The supported operations
+     */
+    enum class opcode {
+        close,
+        poll,
+        read,
+        write
+    };
+
+    /**
+     * @brief A queued or in-flight request
+     */
+    struct request {
+        opcode op;
+        int fd;
+        std::uint8_t* buf;
+        std::size_t nbytes;
+        short events;
+
+        /**
+         * Called back with the result
+         */
+        completion_handler_t handler;
+
+        /**
+         * For polls made on behalf of an event sink, the sink to dispatch
+         */
+        std::weak_ptr<fd_event_sink> sink;
+    };
+
+    /**
+     * @brief Submission and completion queues shared with the kernel
+     */
+    struct ring {
+        int fd;
+
+        void*       sq_ptr;
+        std::size_t sq_size;
+        void*       cq_ptr;
+        std::size_t cq_size;
+
+        io_uring_sqe* sqes;
+        std::size_t   sqes_size;
+
+        unsigned* sq_head;
+        unsigned* sq_tail;
+        unsigned* sq_mask;
+        unsigned* sq_array;
+        unsigned  sq_entries;
+
+        unsigned*     cq_head;
+        unsigned*     cq_tail;
+        unsigned*     cq_mask;
+        io_uring_cqe* cqes;
+
+        /**
+         * Entries placed on the submission queue but not yet submitted
+         */
+        unsigned to_submit;
+    };
+
+    void cancel_all();
+
+    void complete(std::size_t slot, int result);
+
+    bool enqueue(request&& req);
+
+    int enter(unsigned wait);
+
+    io_uring_sqe* get_sqe();
+
+    bool perform(std::size_t slot, int* result);
+
+    bool push_sqe(std::size_t slot);
+
+    int reap();
+
+    bool setup_ring(unsigned entries);
+
+    int submit_fallback(unsigned min_complete);
+
+    int submit_ring(unsigned min_complete);
+
+    void teardown_ring();
+
+    /**
+     * Indices of unused entries in \ref m_requests
+     */
+    std::vector<std::size_t> m_free;
+
+    /**
+     * Requests not yet serviced (fallback mode only), in FIFO order
+     */
+    std::vector<std::size_t> m_queue;
+
+    /**
+     * Outstanding requests. The index of each is its io_uring user data
+     */
+    std::vector<request> m_requests;
+
+    /**
+     * The io_uring instance. Its fd is -1 in fallback mode
+     */
+    ring m_ring;
+};
+
+}  // namespace jfern
+
+#endif  // NETWORKING_IO_BATCH_H_
@@ -0,0 +1,330 @@
+/**
+ *  \file   iovec_builder.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#ifndef NETWORKING_IOVEC_BUILDER_H_
+#define NETWORKING_IOVEC_BUILDER_H_
+
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+
+#include "networking/data_buffer.h"
+#include "networking/posix_api.h"
+
+namespace jfern {
+/**
+ * Assembles a list of buffers to be transferred with a single readv() or
+ * writev(), so that e.g. a header, payload, and trailer held in separate
+ * data_buffers reach the kernel without first being copied together
+ *
+ * @details Transfers may be partial, as with non-blocking sockets. Each
+ *          transfer consumes the bytes moved, so that calling read_from() or
+ *          write_to() again resumes where the last call left off
+ *
+ * @note Buffers must remain valid until the transfer completes
+ *
+ * @tparam MaxSegments The maximum number of buffers
+ */
+template <std::size_t MaxSegments = 16>
+class iovec_builder final {
+    static_assert(MaxSegments > 0 && MaxSegments <= IOV_MAX,
+                  "iovec_builder: invalid number of segments");
+
+public:
+    iovec_builder();
+
+    iovec_builder(const iovec_builder& builder)            = default;
+    iovec_builder(iovec_builder&& builder)                 = default;
+    iovec_builder& operator=(const iovec_builder& builder) = default;
+    iovec_builder& operator=(iovec_builder&& builder)      = default;
+
+    ~iovec_builder() = default;
+
+    template <std::size_t N>
+    bool add(const output_buffer<N>& buffer) noexcept;
+
+    template <std::size_t N>
+    bool add(input_buffer<N>& buffer) noexcept;
+
+    bool add(const std::uint8_t* data, std::size_t nbytes) noexcept;
+
+    std::size_t bytes() const noexcept;
+
+    void clear() noexcept;
+
+    void consume(std::size_t nbytes) noexcept;
+
+    const struct iovec* data() const noexcept;
+
+    bool empty() const noexcept;
+
+    ssize_t read_from(int fd) noexcept;
+
+    std::size_t size() const noexcept;
+
+    ssize_t write_to(int fd) noexcept;
+
+private:
+    /**
+     * Index of the first segment not yet fully transferred
+     */
+    std::size_t m_begin;
+
+    /**
+     * The total number of bytes not yet transferred
+     */
+    std::size_t m_bytes;
+
+    /**
+     * One past the index of the last segment
+     */
+    std::size_t m_end;
+
+    /**
+     * The segments
+     */
+    std::array<struct iovec, MaxSegments> m_iov;
+};
+
+/**
+ * Constructor
+ */
+template <std::size_t MaxSegments>
+iovec_builder<MaxSegments>::iovec_builder()
+    : m_begin(0), m_bytes(0), m_end(0), m_iov() {
+}
+
+/**
+ * Append the contents of an output buffer, i.e. the bytes written to it so
+ * far
+ *
+ * @param[in] buffer The buffer to send from
+ *
+ * @return True on success, or false if there are already \a MaxSegments
+ *         segments
+ */
+template <std::size_t MaxSegments>
+template <std::size_t N>
+bool iovec_builder<MaxSegments>::add(const output_buffer<N>& buffer) noexcept {
+    return add(buffer.data(), buffer.tell());
+}
+
+/**
+ * Append the free space in an input buffer, i.e. from its current offset to
+ * its end
+ *
+ * @param[in] buffer The buffer to receive into
+ *
+ * @return True on success, or false if there are already \a MaxSegments
+ *         segments
+ */
+template <std::size_t MaxSegments>
+template <std::size_t N>
+bool iovec_builder<MaxSegments>::add(input_buffer<N>& buffer) noexcept {
+    return add(buffer.data() + buffer.tell(), buffer.size() - buffer.tell());
+}
+
+/**
+ * Append a raw buffer
+ *
+ * @param[in] data   The start of the buffer
+ * @param[in] nbytes The size of the buffer. Empty buffers are ignored
+ *
+ * @return True on success, or false if there are already \a MaxSegments
+ *         segments
+ */
+template <std::size_t MaxSegments>
+bool iovec_builder<MaxSegments>::add(const std::uint8_t* data,
+                                     std::size_t nbytes) noexcept {
+    if (nbytes == 0) return true;
+    if (m_end == MaxSegments) return false;
+
+    // iovec is shared by readv() and writev(), hence not const-qualified
+    m_iov[m_end].iov_base = const_cast<std::uint8_t*>(data);
+    m_iov[m_end].iov_len  = nbytes;
+
+    m_end++;
+    m_bytes += nbytes;
+
+    return true;
+}
+
+/**
+ * Get the number of bytes left to transfer
+ *
+ * @return The total size of the remaining segments
+ */
+template <std::size_t MaxSegments>
+std::size_t iovec_builder<MaxSegments>::bytes() const noexcept {
+    return m_bytes;
+}
+
+/**
+ * Remove all segments
+ */
+template <std::size_t MaxSegments>
+void iovec_builder<MaxSegments>::clear() noexcept {
+    m_begin = m_end = m_bytes = 0;
+}
+
+/**
+ * Mark bytes as transferred, removing fully transferred segments and trimming
+ * a partially transferred one
+ *
+ * @param[in] nbytes The number of bytes transferred. Clamped to bytes()
+ */
+template <std::size_t MaxSegments>
+void iovec_builder<MaxSegments>::consume(std::size_t nbytes) noexcept {
+    if (nbytes >= m_bytes) {
+        clear();
+        return;
+    }
+
+    m_bytes -= nbytes;
+
+    while (nbytes > 0) {
+        struct iovec& iov = m_iov[m_begin];
+
+        if (nbytes < iov.iov_len) {
+            iov.iov_base = static_cast<std::uint8_t*>(iov.iov_base) + nbytes;
+            iov.iov_len -= nbytes;
+            return;
+        }
+
+        nbytes -= iov.iov_len;
+        m_begin++;
+    }
+}
+
+/**
+ * Get the remaining segments, e.g. for use with sendmsg()
+ *
+ * @return The first of size() segments
+ */
+template <std::size_t MaxSegments>
+const struct iovec* iovec_builder<MaxSegments>::data() const noexcept {
+    return m_iov.data() + m_begin;
+}
+
+/**
+ * Check whether there is anything left to transfer
+ *
+ * @return True if there are no remaining segments
+ */
+template <std::size_t MaxSegments>
+bool iovec_builder<MaxSegments>::empty() const noexcept {
+    return m_begin == m_end;
+}
+
+/**
+ * Fill the remaining segments, in order, with a single readv()
+ *
+ * @param[in] fd The file descriptor to read from
+ *
+ * @return The number of bytes read, which are consumed. On error, returns -1
+ *         and sets errno
+ */
+template <std::size_t MaxSegments>
+ssize_t iovec_builder<MaxSegments>::read_from(int fd) noexcept {
+    const ssize_t n = posix_readv(fd, data(), static_cast<int>(size()));
+    if (n > 0) consume(static_cast<std::size_t>(n));
+
+    return n;
+}
+
+/**
+ * Get the number of segments left to transfer
+ *
+ * @return The number of segments
+ */
+template <std::size_t MaxSegments>
+std::size_t iovec_builder<MaxSegments>::size() const noexcept {
+    return m_end - m_begin;
+}
+
+/**
+ * Send the remaining segments, in order, with a single writev()
+ *
+ * @param[in] fd The file descriptor to write to
+ *
+ * @return The number of bytes written, which are consumed. On error, returns
+ *         -1 and sets errno
+ */
+template <std::size_t MaxSegments>
+ssize_t iovec_builder<MaxSegments>::write_to(int fd) noexcept {
+    const ssize_t n = posix_writev(fd, data(), static_cast<int>(size()));
+    if (n > 0) consume(static_cast<std::size_t>(n));
+
+    return n;
+}
+
+/**
+ * Fill several input buffers, in order, with a single readv(). Each buffer
+ * receives data from its current offset to its end, and its offset is then
+ * advanced past the bytes it received. A partial read thus resumes where it
+ * left off when called again; rewind() the buffers to read what they hold
+ *
+ * @param[in] fd      The file descriptor to read from
+ * @param[in] buffers The buffers to fill
+ *
+ * @return The total number of bytes read. On error, returns -1 and sets errno
+ */
+template <std::size_t... N>
+ssize_t read_buffers(int fd, input_buffer<N>&... buffers) noexcept {
+    static_assert(sizeof...(N) > 0, "read_buffers: no buffers");
+
+    iovec_builder<sizeof...(N)> iov;
+    (iov.add(buffers), ...);
+
+    const ssize_t n = iov.read_from(fd);
+
+    // readv() fills the buffers in order, so the bytes read are spread
+    // across them the same way
+    auto left = static_cast<std::size_t>(std::max<ssize_t>(n, 0));
+
+    auto advance = [&left](auto& buffer) {
+        const std::size_t received =
+            std::min(left, buffer.size() - buffer.tell());
+
+        buffer.seek(static_cast<long int>(received));
+        left -= received;
+    };
+
+    (advance(buffers), ...);
+
+    return n;
+}
+
+/**
+ * Send the contents of several output buffers, in order, with a single
+ * writev(). Nothing is copied
+ *
+ * @param[in] fd      The file descriptor to write to
+ * @param[in] buffers The buffers to send, e.g. a header, payload, and trailer
+ *
+ * @return The total number of bytes written, which may be fewer than
+ *         requested. On error, returns -1 and sets errno
+ */
+template <std::size_t... N>
+ssize_t write_buffers(int fd, const output_buffer<N>&... buffers) noexcept {
+    static_assert(sizeof...(N) > 0, "write_buffers: no buffers");
+
+    iovec_builder<sizeof...(N)> iov;
+    (iov.add(buffers), ...);
+
+    return iov.write_to(fd);
+}
+
+}  // namespace jfern
+
+#endif  // NETWORKING_IOVEC_BUILDER_H_
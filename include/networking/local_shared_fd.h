@@ -0,0 +1,97 @@
+/**
+ *  \file   local_shared_fd.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#ifndef NETWORKING_LOCAL_SHARED_FD_H_
+#define NETWORKING_LOCAL_SHARED_FD_H_
+
+#include <cstddef>
+#include <thread>
+
+#include "fd_interface.h"
+#include "fd_internal.h"
+#include "shared_fd.h"
+
+namespace jfern {
+/**
+ * @class local_shared_fd
+ *
+ * A shared_fd for file descriptors which are owned by a single thread, such as
+ * those serviced by an event loop
+ *
+ * @details
+ * Copies share ownership of the file descriptor as with shared_fd, but the
+ * reference count is a plain integer, so copying or destroying a
+ * local_shared_fd costs no atomic read-modify-write. System calls are made
+ * without locking
+ *
+ * To hand the file descriptor to another thread, call share(). This promotes
+ * it to an atomically counted shared_fd, which from then on manages the file
+ * descriptor, and which may be copied to any thread. The local owners
+ * together hold one strong reference to it, so the file descriptor stays open
+ * until both the local and the shared owners are gone
+ *
+ * @note All operations on a local_shared_fd, including copying and
+ *       destroying it, must be performed by the thread which created it.
+ *       share() verifies this; other operations do not
+ */
+class local_shared_fd final : public fd_interface {
+public:
+    local_shared_fd();
+
+    explicit local_shared_fd(int fd);
+
+    local_shared_fd(const local_shared_fd& fd);
+    local_shared_fd(local_shared_fd&& fd);
+    local_shared_fd& operator=(const local_shared_fd& fd);
+    local_shared_fd& operator=(local_shared_fd&& fd);
+
+    ~local_shared_fd();
+
+    explicit operator bool() const noexcept override;
+
+    int get() const noexcept override;
+
+    bool is_blocking() const noexcept override;
+
+    std::thread::id owner() const noexcept;
+
+    int poll(short events) noexcept override;
+
+    int poll(short events,
+             fd_interface::event_handler_t handler) override;
+
+    int poll(short events, int timeout) noexcept override;
+
+    int poll(short events, int timeout,
+             fd_interface::event_handler_t handler) override;
+
+    bool promoted() const noexcept;
+
+    bool reset(int fd) noexcept override;
+
+    bool set_blocking(bool enable) noexcept override;
+
+    shared_fd share(
+        fd::concurrency mode = fd::concurrency::serialized) const;
+
+    void swap(local_shared_fd& fd) noexcept;
+
+    std::size_t use_count() const noexcept;
+
+private:
+    void drop_reference();
+
+    /**
+     * Data shared between owners of the file descriptor
+     */
+    fd::local_internal* m_local_info;
+};
+
+}  // namespace jfern
+
+#endif  // NETWORKING_LOCAL_SHARED_FD_H_
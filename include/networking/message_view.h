@@ -0,0 +1,288 @@
+/**
+ *  \file   message_view.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#ifndef NETWORKING_MESSAGE_VIEW_H_
+#define NETWORKING_MESSAGE_VIEW_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+
+#include "networking/data_buffer.h"
+#include "networking/net.h"
+
+namespace jfern {
+/**
+ * The byte order in which a field is encoded
+ */
+enum class byte_order {
+    /**
+     * Most significant byte first, i.e. network byte order
+     */
+    big,
+
+    /**
+     * Least significant byte first
+     */
+    little
+};
+
+/**
+ * Describes a scalar field of a message
+ *
+ * @tparam T     The field type, e.g. std::uint32_t, double, or an enum
+ * @tparam Order The byte order in which the field is encoded
+ */
+template <typename T, byte_order Order = byte_order::big>
+struct field {
+    static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value,
+                  "field: only arithmetic and enum types are supported");
+
+    /**
+     * The type a view returns for this field
+     */
+    using value_type = T;
+
+    /**
+     * The encoded size of the field, in bytes
+     */
+    static constexpr std::size_t size = sizeof(T);
+
+    /**
+     * @brief Decode the field
+     *
+     * @param[in] data The first byte of the encoded field
+     *
+     * @return The field value, in host byte order
+     */
+    static T load(const std::uint8_t* data) noexcept {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+
+        if constexpr ((Order == byte_order::big) != is_big_endian()) {
+            return byte_swap<T>(value);
+        } else {
+            return value;
+        }
+    }
+};
+
+/**
+ * Describes a run of raw bytes within a message, e.g. a fixed-width string
+ * or reserved space. Viewing it returns a pointer into the message, so
+ * nothing is copied
+ *
+ * @tparam N The number of bytes
+ */
+template <std::size_t N>
+struct raw_field {
+    /**
+     * The type a view returns for this field
+     */
+    using value_type = const std::uint8_t*;
+
+    /**
+     * The encoded size of the field, in bytes
+     */
+    static constexpr std::size_t size = N;
+
+    /**
+     * @brief "Decode" the field
+     *
+     * @param[in] data The first byte of the field
+     *
+     * @return \a data
+     */
+    static value_type load(const std::uint8_t* data) noexcept {
+        return data;
+    }
+};
+
+/**
+ * Describes the layout of a packed message as a sequence of fields, e.g.
+ *
+ * @code
+ * using header = message_schema<field<std::uint16_t>,         // type
+ *                               field<std::uint32_t>,         // sequence
+ *                               raw_field<8>,                 // symbol
+ *                               field<std::int64_t,
+ *                                     byte_order::little>>;   // price
+ * @endcode
+ *
+ * @tparam Fields The fields, in the order they are encoded, with no padding
+ *                in between
+ */
+template <typename... Fields>
+struct message_schema {
+    /**
+     * The number of fields
+     */
+    static constexpr std::size_t count = sizeof...(Fields);
+
+    /**
+     * The encoded size of the message, in bytes
+     */
+    static constexpr std::size_t size = (Fields::size + ... + 0);
+
+    /**
+     * The description of field \a I
+     */
+    template <std::size_t I>
+    using field_t = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    /**
+     * @brief Get the offset of a field from the start of the message
+     *
+     * @tparam I The index of the field
+     *
+     * @return The offset, in bytes
+     */
+    template <std::size_t I>
+    static constexpr std::size_t offset() noexcept {
+        static_assert(I < count, "message_schema: field index out of range");
+
+        constexpr std::size_t sizes[] = {Fields::size..., 0};
+
+        std::size_t result = 0;
+        for (std::size_t i = 0; i < I; i++) result += sizes[i];
+
+        return result;
+    }
+};
+
+/**
+ * A read-only view of a message laid out according to a message_schema,
+ * directly over the bytes received
+ *
+ * @details The length of the message is validated once, when the view is
+ *          created. After that, each field is decoded (and byte swapped if
+ *          needed) only when accessed, from an offset computed at compile
+ *          time, so fields which are never read cost nothing
+ *
+ * @note The bytes must remain valid for as long as the view is used
+ *
+ * @tparam Schema The message_schema describing the message
+ */
+template <typename Schema>
+class message_view final {
+public:
+    message_view() noexcept;
+
+    message_view(const std::uint8_t* data, std::size_t nbytes) noexcept;
+
+    message_view(const message_view& view)            = default;
+    message_view(message_view&& view)                 = default;
+    message_view& operator=(const message_view& view) = default;
+    message_view& operator=(message_view&& view)      = default;
+
+    ~message_view() = default;
+
+    explicit operator bool() const noexcept;
+
+    const std::uint8_t* data() const noexcept;
+
+    template <std::size_t I>
+    typename Schema::template field_t<I>::value_type get() const noexcept;
+
+    static constexpr std::size_t size() noexcept;
+
+private:
+    /**
+     * The first byte of the message, or null if the view is empty
+     */
+    const std::uint8_t* m_data;
+};
+
+/**
+ * Constructor. Creates an empty view
+ */
+template <typename Schema>
+message_view<Schema>::message_view() noexcept : m_data(nullptr) {
+}
+
+/**
+ * Constructor
+ *
+ * @param[in] data   The start of the message
+ * @param[in] nbytes The number of bytes available at \a data. If fewer than
+ *                   the size of the message, the view is empty
+ */
+template <typename Schema>
+message_view<Schema>::message_view(const std::uint8_t* data,
+                                   std::size_t nbytes) noexcept
+    : m_data(data && nbytes >= Schema::size ? data : nullptr) {
+}
+
+/**
+ * Check whether the view refers to a message
+ *
+ * @return True unless the view is empty
+ */
+template <typename Schema>
+message_view<Schema>::operator bool() const noexcept {
+    return m_data != nullptr;
+}
+
+/**
+ * Get the raw bytes of the message
+ *
+ * @return The first byte, or null if the view is empty
+ */
+template <typename Schema>
+const std::uint8_t* message_view<Schema>::data() const noexcept {
+    return m_data;
+}
+
+/**
+ * Decode a field. The view must not be empty
+ *
+ * @tparam I The index of the field
+ *
+ * @return The field value, in host byte order
+ */
+template <typename Schema>
+template <std::size_t I>
+typename Schema::template field_t<I>::value_type
+message_view<Schema>::get() const noexcept {
+    using field_type = typename Schema::template field_t<I>;
+    return field_type::load(m_data + Schema::template offset<I>());
+}
+
+/**
+ * Get the encoded size of the message
+ *
+ * @return The size, in bytes
+ */
+template <typename Schema>
+constexpr std::size_t message_view<Schema>::size() noexcept {
+    return Schema::size;
+}
+
+/**
+ * View the message at the current offset of an input buffer and, if it fits,
+ * advance the buffer pointer past it
+ *
+ * @param[in] buffer The buffer holding the message
+ *
+ * @return The view, which is empty if the message would overrun the buffer
+ */
+template <typename Schema, std::size_t N>
+message_view<Schema> view_message(input_buffer<N>& buffer) noexcept {
+    const message_view<Schema> view(buffer.data() + buffer.tell(),
+                                    buffer.size() - buffer.tell());
+
+    if (view) buffer.seek(static_cast<long int>(Schema::size));
+
+    return view;
+}
+
+}  // namespace jfern
+
+#endif  // NETWORKING_MESSAGE_VIEW_H_
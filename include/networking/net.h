@@ -13,126 +13,200 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <type_traits>
 
+#if __cplusplus >= 202002L
+#include <bit>
+#endif
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_bit_cast)
+#define NETWORKING_HAS_BUILTIN_BIT_CAST 1
+#endif
+#endif
+
 namespace jfern {
 namespace internal {
-template <typename T, std::size_t I>
-struct byte_swap {
-    static constexpr T calculate(const T& data) noexcept;
+/**
+ * The unsigned integer type of a given size
+ *
+ * @tparam N The size, in bytes
+ */
+template <std::size_t N>
+struct uint_of_size {
+    static_assert(N == 0, "uint_of_size: invalid size");
 };
 
-template <typename T>
-struct byte_swap<T, 1u> {
-    static constexpr T calculate(const T& data) noexcept;
+template <>
+struct uint_of_size<1u> {
+    using type = std::uint8_t;
 };
 
-template <typename T>
-struct byte_swap<T, 2u> {
-    static constexpr T calculate(const T& data) noexcept;
+template <>
+struct uint_of_size<2u> {
+    using type = std::uint16_t;
 };
 
-template <typename T>
-struct byte_swap<T, 4u> {
-    static constexpr T calculate(const T& data) noexcept;
+template <>
+struct uint_of_size<4u> {
+    using type = std::uint32_t;
 };
 
-template <typename T>
-struct byte_swap<T, 8u> {
-    static constexpr T calculate(const T& data) noexcept;
+template <>
+struct uint_of_size<8u> {
+    using type = std::uint64_t;
 };
 
-template <typename T, std::size_t I>
-constexpr T byte_swap<T, I>::calculate(const T& data) noexcept {
-    static_assert(I == 0, "byte_swap: invalid size");
+/**
+ * Reinterpret the bits of a value as another type of the same size, as with
+ * C++20 std::bit_cast
+ *
+ * @param[in] from The value to reinterpret
+ *
+ * @return The value with the same bits as \a from. Usable in constant
+ *         expressions if the compiler provides __builtin_bit_cast
+ */
+template <typename To, typename From>
+constexpr To bit_cast(const From& from) noexcept {
+    static_assert(sizeof(To) == sizeof(From), "bit_cast: size mismatch");
+
+#if NETWORKING_HAS_BUILTIN_BIT_CAST
+    return __builtin_bit_cast(To, from);
+#else
+    To to{};
+    std::memcpy(&to, &from, sizeof(To));
+    return to;
+#endif
 }
 
 /**
- * Reverse the bytes of a single-byte value
+ * Reverse the bytes of an unsigned integer. Each overload compiles to a
+ * single instruction (e.g. bswap, or movbe when fused with a load or store)
  *
- * @param[in] data The element whose bytes to reverse
+ * @param[in] data The integer whose bytes to reverse
  *
  * @return \a data with its bytes reversed
  */
-template <typename T>
-constexpr T byte_swap<T, 1u>::calculate(const T& data) noexcept {
+constexpr std::uint8_t reverse_bytes(std::uint8_t data) noexcept {
     return data;
 }
 
 /**
- * Reverse the bytes of a two-byte value
- *
- * @param[in] data The element whose bytes to reverse
- *
- * @return \a data with its bytes reversed
+ * @see reverse_bytes(std::uint8_t)
  */
-template <typename T>
-constexpr T byte_swap<T, 2u>::calculate(const T& data) noexcept {
-    static_assert(std::is_integral<T>::value);
-    return ((data >> 8) & 0xff) | ((data << 8) & 0xff00);
+constexpr std::uint16_t reverse_bytes(std::uint16_t data) noexcept {
+    return __builtin_bswap16(data);
 }
 
 /**
- * Reverse the bytes of a four-byte value
- *
- * @param[in] data The element whose bytes to reverse
- *
- * @return \a data with its bytes reversed
+ * @see reverse_bytes(std::uint8_t)
  */
-template <typename T>
-constexpr T byte_swap<T, 4u>::calculate(const T& data) noexcept {
-    static_assert(std::is_integral<T>::value);
+constexpr std::uint32_t reverse_bytes(std::uint32_t data) noexcept {
+    return __builtin_bswap32(data);
+}
 
-    T x(data);
+/**
+ * @see reverse_bytes(std::uint8_t)
+ */
+constexpr std::uint64_t reverse_bytes(std::uint64_t data) noexcept {
+    return __builtin_bswap64(data);
+}
 
-    x = (x & 0x0000ffff) << 16 | (x & 0xffff0000u) >> 16;
-    x = (x & 0x00ff00ff) << 8  | (x & 0xff00ff00u) >> 8;
+/**
+ * Instruction sets used by the bulk byte swap kernels
+ */
+enum class simd_level {
+    /**
+     * One element at a time
+     */
+    scalar,
 
-    return x;
-}
+    /**
+     * 16 bytes at a time with SSSE3 pshufb
+     */
+    ssse3,
+
+    /**
+     * 32 bytes at a time with AVX2 vpshufb
+     */
+    avx2
+};
+
+simd_level max_simd_level() noexcept;
+
+void bulk_byte_swap(const void* in, void* out, std::size_t count,
+                    std::size_t width, simd_level level) noexcept;
+
+}  // namespace internal
 
 /**
- * Reverse the bytes of an eight-byte value
+ * Reverse the bytes of an integer, enumerator, or floating point value
  *
  * @param[in] data The element whose bytes to reverse
  *
  * @return \a data with its bytes reversed
  */
 template <typename T>
-constexpr T byte_swap<T, 8u>::calculate(const T& data) noexcept {
-    static_assert(std::is_integral<T>::value);
-
-    T x(data);
+constexpr T byte_swap(const T& data) noexcept {
+    static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value,
+                  "byte_swap: only arithmetic and enum types are supported");
 
-    x = (x & 0x00000000ffffffff) << 32 | (x & 0xffffffff00000000u) >> 32;
-    x = (x & 0x0000ffff0000ffff) << 16 | (x & 0xffff0000ffff0000u) >> 16;
-    x = (x & 0x00ff00ff00ff00ff) << 8  | (x & 0xff00ff00ff00ff00u) >> 8;
+    using bits_t = typename internal::uint_of_size<sizeof(T)>::type;
 
-    return x;
+    if constexpr (std::is_floating_point<T>::value) {
+        return internal::bit_cast<T>(
+            internal::reverse_bytes(internal::bit_cast<bits_t>(data)));
+    } else {
+        return static_cast<T>(
+            internal::reverse_bytes(static_cast<bits_t>(data)));
+    }
 }
 
-}  // namespace internal
-
 /**
- * Reverse the bytes of a generic type
+ * Reverse the bytes of each element of an array, using the widest vector
+ * instructions this CPU supports
  *
- * @param[in] data The element whose bytes to reverse
+ * @param[in]  in    The elements to convert
+ * @param[out] out   The converted elements. May be the same as \a in, but must
+ *                   not otherwise overlap it
+ * @param[in]  count The number of elements
+ */
+template <typename T>
+void byte_swap(const T* in, T* out, std::size_t count) noexcept {
+    static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value,
+                  "byte_swap: only arithmetic and enum types are supported");
+
+    if constexpr (sizeof(T) == 1) {
+        if (in != out) std::memcpy(out, in, count);
+    } else {
+        static const internal::simd_level level = internal::max_simd_level();
+        internal::bulk_byte_swap(in, out, count, sizeof(T), level);
+    }
+}
+
+/**
+ * Reverse the bytes of each element of an array in place
  *
- * @return \a data with its bytes reversed
+ * @param[in,out] data  The elements to convert
+ * @param[in]     count The number of elements
  */
 template <typename T>
-constexpr T byte_swap(const T& data) noexcept {
-    return internal::byte_swap<T, sizeof(T)>::calculate(data);
+void byte_swap(T* data, std::size_t count) noexcept {
+    byte_swap<T>(data, data, count);
 }
 
 /**
- * Check the endianness of this system
+ * Check the endianness of this system, at compile time
  *
  * @return True if the current system is big endian
  */
-constexpr bool is_big_endian() {
-    constexpr int n = 1;
-    return *reinterpret_cast<const std::uint8_t*>(&n) == 1;
+constexpr bool is_big_endian() noexcept {
+#if __cplusplus >= 202002L
+    return std::endian::native == std::endian::big;
+#else
+    return __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__;
+#endif
 }
 
 /**
@@ -145,7 +219,11 @@ constexpr bool is_big_endian() {
  */
 template <typename T>
 constexpr T to_host_order(const T& data) noexcept {
-    return is_big_endian() ? data : byte_swap<T>(data);
+    if constexpr (is_big_endian()) {
+        return data;
+    } else {
+        return byte_swap<T>(data);
+    }
 }
 
 /**
@@ -161,6 +239,89 @@ constexpr T to_network_order(const T& data) noexcept {
     return to_host_order(data);
 }
 
+/**
+ * Convert an array from network to host byte order
+ *
+ * @param[in]  in    The elements to convert
+ * @param[out] out   The converted elements. May be the same as \a in, but must
+ *                   not otherwise overlap it
+ * @param[in]  count The number of elements
+ */
+template <typename T>
+void to_host_order(const T* in, T* out, std::size_t count) noexcept {
+    if constexpr (!is_big_endian()) {
+        byte_swap<T>(in, out, count);
+    } else if (in != out) {
+        std::memcpy(out, in, count * sizeof(T));
+    }
+}
+
+/**
+ * Convert an array from network to host byte order in place
+ *
+ * @param[in,out] data  The elements to convert
+ * @param[in]     count The number of elements
+ */
+template <typename T>
+void to_host_order(T* data, std::size_t count) noexcept {
+    to_host_order<T>(data, data, count);
+}
+
+/**
+ * Convert an array from host to network byte order
+ *
+ * @param[in]  in    The elements to convert
+ * @param[out] out   The converted elements. May be the same as \a in, but must
+ *                   not otherwise overlap it
+ * @param[in]  count The number of elements
+ */
+template <typename T>
+void to_network_order(const T* in, T* out, std::size_t count) noexcept {
+    to_host_order<T>(in, out, count);
+}
+
+/**
+ * Convert an array from host to network byte order in place
+ *
+ * @param[in,out] data  The elements to convert
+ * @param[in]     count The number of elements
+ */
+template <typename T>
+void to_network_order(T* data, std::size_t count) noexcept {
+    to_host_order<T>(data, data, count);
+}
+
+/**
+ * The outcome of an operation on a network channel
+ */
+enum class NetError {
+    /**
+     * The operation completed
+     */
+    kSuccess,
+
+    /**
+     * The operation could not complete without blocking; try again once the
+     * descriptor is ready
+     */
+    kWouldBlock,
+
+    /**
+     * The peer closed the connection, or the channel is not open
+     */
+    kClosed,
+
+    /**
+     * An argument was invalid, e.g. an address that could not be resolved
+     */
+    kInvalidArgument,
+
+    /**
+     * A system call failed; errno holds the reason
+     */
+    kSystemError
+};
+
 }  // namespace jfern
 
 #endif  // NETWORKING_NET_H_
@@ -11,16 +11,44 @@
 
 #include <fcntl.h>
 #include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <cstddef>
 #include <cstdint>
+#include <utility>
+
+struct io_uring_params;
 
 namespace jfern {
+int posix_accept4(int, struct sockaddr*, socklen_t*, int);
+int posix_bind(int, const struct sockaddr*, socklen_t);
 int posix_close(int);
+int posix_connect(int, const struct sockaddr*, socklen_t);
+int posix_epoll_create1(int);
+int posix_epoll_ctl(int, int, int, struct epoll_event*);
+int posix_epoll_wait(int, struct epoll_event*, int, int);
+int posix_eventfd(unsigned int, int);
+int posix_io_uring_enter(int, unsigned, unsigned, unsigned);
+int posix_io_uring_register(int, unsigned, void*, unsigned);
+int posix_io_uring_setup(unsigned, struct io_uring_params*);
 template <typename... T> int posix_fcntl(int, int, T&&...);
+int posix_getsockname(int, struct sockaddr*, socklen_t*);
+int posix_listen(int, int);
 int posix_poll(struct pollfd[], nfds_t, int);
 ssize_t posix_read(int, std::uint8_t*, std::size_t);
+ssize_t posix_readv(int, const struct iovec*, int);
+ssize_t posix_send(int, const std::uint8_t*, std::size_t, int);
+int posix_setsockopt(int, int, int, const void*, socklen_t);
+int posix_socket(int, int, int);
+int posix_timerfd_create(int, int);
+int posix_timerfd_settime(int, int, const struct itimerspec*,
+                          struct itimerspec*);
 ssize_t posix_write(int, const std::uint8_t*, std::size_t);
+ssize_t posix_writev(int, const struct iovec*, int);
 
 /**
  * @brief Wrapper to the POSIX fcntl() function
@@ -0,0 +1,165 @@
+/**
+ *  \file   reactor.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#ifndef NETWORKING_REACTOR_H_
+#define NETWORKING_REACTOR_H_
+
+#include <sys/epoll.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "networking/fd_event_sink.h"
+#include "networking/timer_wheel.h"
+#include "networking/unique_fd.h"
+
+namespace jfern {
+/**
+ * @class reactor
+ *
+ * Demultiplexes events across many file descriptors using a single epoll(7)
+ * instance
+ *
+ * @details
+ * Each registered fd_event_sink is keyed by its file descriptor. A call to
+ * run_once() issues one epoll_wait() and dispatches the handlers of every
+ * sink with pending events, so the cost of an iteration scales with the
+ * number of ready descriptors rather than the number registered
+ *
+ * Each registration is also tagged with a number which epoll hands back
+ * alongside the descriptor. An event reported for a sink which a handler
+ * has since removed is dropped, even if its descriptor number was reused by
+ * a sink registered in the meantime
+ *
+ * Sinks with edge-triggered handlers are registered with EPOLLET. If such a
+ * sink exhausts its per-wakeup budget before draining its descriptor, it is
+ * placed on a backlog and dispatched again on the next call to run_once(),
+ * after the descriptors that became ready in the meantime
+ *
+ * Work may also be deferred to the end of the current iteration with
+ * defer(), e.g. to coalesce the output produced by several handlers into one
+ * write per descriptor
+ *
+ * Timers scheduled on timers() bound the wait in run_once() and expire after
+ * the handlers of each iteration have been dispatched, before deferred tasks
+ * run
+ */
+class reactor final {
+public:
+    explicit reactor(std::size_t max_events = 64);
+
+    reactor(const reactor& r)            = delete;
+    reactor(reactor&& r)                 = delete;
+    reactor& operator=(const reactor& r) = delete;
+    reactor& operator=(reactor&& r)      = delete;
+
+    ~reactor() = default;
+
+    explicit operator bool() const noexcept;
+
+    bool add(std::shared_ptr<fd_event_sink> sink);
+
+    bool contains(int fd) const;
+
+    void defer(std::function<void()> task);
+
+    std::shared_ptr<fd_event_sink> find(int fd) const;
+
+    bool remove(int fd);
+
+    int run_once(int timeout);
+
+    std::size_t size() const noexcept;
+
+    timer_wheel& timers() noexcept;
+
+    bool update(int fd);
+
+private:
+    /**
+     * @brief A registered sink along with its dispatch state
+     */
+    struct sink_info {
+        sink_info(std::shared_ptr<fd_event_sink> sink_, std::uint32_t id_)
+            : id(id_), pending(0), round(0), sink(std::move(sink_)) {}
+
+        /**
+         * Distinguishes this registration from earlier ones of the same file
+         * descriptor
+         */
+        std::uint32_t id;
+
+        /**
+         * Events left undrained by an edge-triggered handler
+         */
+        short pending;
+
+        /**
+         * The iteration of run_once() during which the sink was last
+         * dispatched
+         */
+        std::size_t round;
+
+        /**
+         * The event sink itself
+         */
+        std::shared_ptr<fd_event_sink> sink;
+    };
+
+    bool dispatch(int fd, std::uint32_t id, short events);
+
+    /**
+     * File descriptors whose sinks have undrained events
+     */
+    std::vector<int> m_backlog;
+
+    /**
+     * Tasks to run at the end of the current iteration
+     */
+    std::vector<std::function<void()>> m_deferred;
+
+    /**
+     * The epoll instance
+     */
+    unique_fd m_epoll;
+
+    /**
+     * The registration number given to the next sink added
+     */
+    std::uint32_t m_next_id;
+
+    /**
+     * Buffer which receives ready events from epoll_wait()
+     */
+    std::vector<struct epoll_event> m_ready;
+
+    /**
+     * The number of calls made to run_once()
+     */
+    std::size_t m_round;
+
+    /**
+     * Registered event sinks, keyed by file descriptor
+     */
+    std::unordered_map<int, sink_info>
+        m_sinks;
+
+    /**
+     * Timers which expire during run_once()
+     */
+    timer_wheel m_timers;
+};
+
+}  // namespace jfern
+
+#endif  // NETWORKING_REACTOR_H_
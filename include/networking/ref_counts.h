@@ -0,0 +1,191 @@
+/**
+ *  \file   ref_counts.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#ifndef NETWORKING_REF_COUNTS_H_
+#define NETWORKING_REF_COUNTS_H_
+
+#include <atomic>
+#include <cstddef>
+
+namespace jfern {
+namespace fd {
+/**
+ * The size of a cache line on the platforms we target. We avoid
+ * std::hardware_destructive_interference_size, whose value may differ
+ * between compilers and so is unsuitable for use in headers
+ */
+constexpr std::size_t cache_line_size = 64;
+
+/**
+ * How the strong and weak reference counters are laid out in memory
+ */
+enum class counter_layout {
+    /**
+     * Both counters share a cache line. Smallest, but threads copying owners
+     * and threads copying weak references contend for the same line
+     */
+    packed,
+
+    /**
+     * Each counter occupies its own cache line, so strong and weak reference
+     * traffic do not interfere
+     */
+    padded
+};
+
+/**
+ * The layout used by shared_fd. Padded unless NETWORKING_PACKED_FD_COUNTERS is
+ * defined
+ */
+#ifdef NETWORKING_PACKED_FD_COUNTERS
+constexpr counter_layout default_counter_layout = counter_layout::packed;
+#else
+constexpr counter_layout default_counter_layout = counter_layout::padded;
+#endif
+
+/**
+ * Strong and weak reference counters for a shared resource
+ *
+ * @tparam Layout How the counters are laid out in memory
+ *
+ * @note Both counters start at one. The weak count includes one reference on
+ *       behalf of all strong references, which release() drops along with the
+ *       last strong reference
+ */
+template <counter_layout Layout>
+class alignas(Layout == counter_layout::padded
+                  ? cache_line_size
+                  : alignof(std::atomic<std::size_t>)) ref_counts final {
+public:
+    /**
+     * The alignment of each counter
+     */
+    static constexpr std::size_t alignment =
+        Layout == counter_layout::padded ? cache_line_size
+                                         : alignof(std::atomic<std::size_t>);
+
+    ref_counts() : m_count(1), m_weak_count(1) {}
+
+    ref_counts(const ref_counts& counts)            = delete;
+    ref_counts(ref_counts&& counts)                 = delete;
+    ref_counts& operator=(const ref_counts& counts) = delete;
+    ref_counts& operator=(ref_counts&& counts)      = delete;
+
+    ~ref_counts() = default;
+
+    /**
+     * @brief Get the current reference count
+     *
+     * @return The reference count
+     */
+    std::size_t count() const {
+        return m_count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the current weak reference count
+     *
+     * @return The weak reference count
+     */
+    std::size_t weak_count() const {
+        return m_weak_count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Increment the reference count
+     */
+    void add_reference() {
+        m_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Increment the reference count only if the use count
+     *        is non-zero
+     *
+     * @return True if the increment succeeded
+     */
+    bool add_reference_if_valid() {
+        return increment_if_valid(m_count);
+    }
+
+    /**
+     * @brief Decrement the reference count
+     *
+     * @return True if this dropped the last strong reference, in which case
+     *         the caller must release the resource and then call
+     *         release_weak_reference()
+     */
+    bool release() {
+        return m_count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    /**
+     * @brief Increment the weak reference count
+     */
+    void add_weak_reference() {
+        m_weak_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Increment the weak reference count only if its value
+     *        is non-zero
+     *
+     * @return True if the increment succeeded
+     */
+    bool add_weak_reference_if_valid() {
+        return increment_if_valid(m_weak_count);
+    }
+
+    /**
+     * @brief Decrement the weak reference count
+     *
+     * @return True if all references have been dropped
+     */
+    bool release_weak_reference() {
+        return m_weak_count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+private:
+    /**
+     * Increment a counter unless it has reached zero
+     *
+     * @param[in] counter The counter to increment
+     *
+     * @return True if the increment succeeded
+     */
+    static bool increment_if_valid(std::atomic<std::size_t>& counter) {
+        std::size_t count = counter.load(std::memory_order_relaxed);
+
+        for (;;) {
+            if (count == 0) return false;
+            if (counter.compare_exchange_weak(
+                    count, count+1, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
+    /** The reference count */
+    alignas(alignment) std::atomic<std::size_t> m_count;
+
+    /** The weak reference count */
+    alignas(alignment) std::atomic<std::size_t> m_weak_count;
+};
+
+static_assert(sizeof(ref_counts<counter_layout::packed>)
+                == 2 * sizeof(std::atomic<std::size_t>),
+              "packed counters must share a cache line");
+
+static_assert(sizeof(ref_counts<counter_layout::padded>)
+                == 2 * cache_line_size,
+              "padded counters must each occupy a cache line");
+
+}  // namespace fd
+}  // namespace jfern
+
+#endif  // NETWORKING_REF_COUNTS_H_
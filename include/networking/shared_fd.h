@@ -13,6 +13,7 @@
 #include <cstddef>
 #include <mutex>
 
+#include "basic_shared_fd.h"
 #include "fd_interface.h"
 #include "fd_internal.h"
 
@@ -33,6 +34,15 @@ namespace jfern {
  * @note
  * For the purposes of concurrency - all operations on a shared_fd (including
  * the use of any of the polling interfaces) may be treated as atomic
+ *
+ * By default, polls and flag changes made through different owners are
+ * serialized on a per-descriptor mutex, so a blocking poll() in one thread
+ * delays every other thread's poll() or set_blocking(). Constructing with
+ * fd::concurrency::lock_free lifts this: polls run concurrently, and flag
+ * changes are made against cached flags shared by all owners
+ *
+ * Where the file descriptor type is known at compile time, prefer
+ * \ref basic_shared_fd, which has no vtable and dispatches handlers statically
  */
 class shared_fd final : public fd_interface {
 public:
@@ -40,6 +50,8 @@ public:
 
     explicit shared_fd(int fd);
 
+    shared_fd(int fd, fd::concurrency mode);
+
     shared_fd(const shared_fd& fd);
     shared_fd(shared_fd&& fd);
     shared_fd& operator=(const shared_fd& fd);
@@ -49,6 +61,8 @@ public:
 
     explicit operator bool() const noexcept override;
 
+    fd::concurrency concurrency_mode() const noexcept;
+
     int get() const noexcept override;
 
     bool is_blocking() const noexcept override;
@@ -72,20 +86,19 @@ public:
     std::size_t use_count() const noexcept;
 
 private:
-    // Give weak_fd access to the control block
+    // Give weak_fd and local_shared_fd access to the control block
+    friend class local_shared_fd;
     friend class weak_fd;
 
-    void drop_reference();
-
-    /** True if blocking behavior is enabled */
-    bool m_blocking;
+    explicit shared_fd(fd::shared_internal* shared_info);
 
-    /**
-     * Data shared between owners of the file descriptor
-     */
-    fd::shared_internal* m_shared_info;
+    /** The file descriptor, to which all operations are forwarded */
+    basic_shared_fd m_fd;
 };
 
+shared_fd make_shared_fd(int fd,
+                         fd::concurrency mode = fd::concurrency::serialized);
+
 /**
  * @class weak_fd
  *
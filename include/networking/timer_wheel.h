@@ -0,0 +1,215 @@
+/**
+ *  \file   timer_wheel.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#ifndef NETWORKING_TIMER_WHEEL_H_
+#define NETWORKING_TIMER_WHEEL_H_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "networking/fd_event_sink.h"
+#include "networking/inplace_function.h"
+#include "networking/shared_fd.h"
+
+namespace jfern {
+/**
+ * @class timer_wheel
+ *
+ * Schedules callbacks to run after a delay, using a hierarchical timing wheel
+ *
+ * @details
+ * Time is divided into ticks (1 ms by default). Timers due within the next
+ * 256 ticks are kept in one of 256 slots of the first wheel; timers due
+ * later are kept in coarser wheels, each 256 times the span of the one below
+ * it, and are cascaded into finer wheels as their time approaches. Scheduling
+ * and cancelling a timer take constant time regardless of how many are
+ * pending, which suits per-connection timers such as idle timeouts (see
+ * reschedule()) and retransmissions
+ *
+ * The wheel does not keep time on its own. Either call advance() from an
+ * event loop, using next_timeout() as its wait timeout (the \ref reactor
+ * does both), or register the sink returned by event_sink() with any loop,
+ * in which case a timerfd wakes the loop when the next timer is due
+ *
+ * @note A timer_wheel must only be used from one thread
+ */
+class timer_wheel final {
+public:
+    /**
+     * The callback invoked when a timer expires. Captures are stored inline
+     */
+    using callback_t = inplace_function<void(), 24, alignof(void*)>;
+
+    /**
+     * The clock timers are measured against
+     */
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * Identifies a pending timer. Identifiers of expired or cancelled timers
+     * are never reused, so stale ones are rejected by cancel()
+     */
+    using timer_id = std::uint64_t;
+
+    /**
+     * An identifier which never refers to a timer
+     */
+    static constexpr timer_id invalid_timer = 0;
+
+    explicit timer_wheel(
+        std::chrono::milliseconds tick = std::chrono::milliseconds(1));
+
+    timer_wheel(const timer_wheel& wheel)            = delete;
+    timer_wheel(timer_wheel&& wheel)                 = delete;
+    timer_wheel& operator=(const timer_wheel& wheel) = delete;
+    timer_wheel& operator=(timer_wheel&& wheel)      = delete;
+
+    ~timer_wheel() = default;
+
+    std::size_t advance();
+
+    std::size_t advance(clock::time_point now);
+
+    bool cancel(timer_id id) noexcept;
+
+    std::shared_ptr<fd_event_sink> event_sink();
+
+    int next_timeout();
+
+    int next_timeout(clock::time_point now);
+
+    bool pending(timer_id id) const noexcept;
+
+    bool reschedule(timer_id id, std::chrono::milliseconds delay);
+
+    timer_id schedule(std::chrono::milliseconds delay, callback_t callback);
+
+    std::size_t size() const noexcept;
+
+    std::chrono::milliseconds tick() const noexcept;
+
+private:
+    /**
+     * The number of bits of the tick count resolved by each wheel
+     */
+    static constexpr unsigned int bits_per_level = 8;
+
+    /**
+     * The number of wheels. Together they span 2^32 ticks
+     */
+    static constexpr std::size_t levels = 4;
+
+    /**
+     * The number of slots per wheel
+     */
+    static constexpr std::size_t slots_per_level = 1u << bits_per_level;
+
+    /**
+     * Marks the end of a list of timers
+     */
+    static constexpr std::uint32_t npos = 0xffffffff;
+
+    /**
+     * @brief A pending (or free) timer
+     */
+    struct timer_node {
+        /** The tick at which the timer expires */
+        std::uint64_t expires;
+
+        /** The callback to invoke */
+        callback_t callback;
+
+        /** Incremented each time the node is freed */
+        std::uint32_t generation;
+
+        /** The next node in the same slot, or in the free list */
+        std::uint32_t next;
+
+        /** The previous node in the same slot */
+        std::uint32_t prev;
+
+        /** The slot holding the node, or npos if it is free */
+        std::uint32_t slot;
+    };
+
+    void arm_timerfd();
+
+    void cascade(std::size_t level, std::size_t index);
+
+    std::uint32_t find(timer_id id) const noexcept;
+
+    void free_node(std::uint32_t index) noexcept;
+
+    void link(std::uint32_t index);
+
+    std::uint64_t next_expiry() const noexcept;
+
+    std::uint64_t to_ticks(clock::time_point now) const noexcept;
+
+    void unlink(std::uint32_t index) noexcept;
+
+    /**
+     * The tick at which the timerfd is set to fire, or 0 if it is disarmed
+     */
+    std::uint64_t m_armed;
+
+    /**
+     * The head of the list of free nodes
+     */
+    std::uint32_t m_free;
+
+    /**
+     * The head of the list of timers in each slot, for each wheel. The last
+     * list holds timers whose callbacks are about to run
+     */
+    std::array<std::uint32_t, levels * slots_per_level + 1> m_heads;
+
+    /**
+     * Timer storage. Nodes are recycled through \ref m_free
+     */
+    std::vector<timer_node> m_nodes;
+
+    /**
+     * The next tick to be processed. All earlier ticks have expired
+     */
+    std::uint64_t m_now;
+
+    /**
+     * For each wheel, a bitmap of its non-empty slots
+     */
+    std::array<std::array<std::uint64_t, slots_per_level / 64>, levels>
+        m_occupied;
+
+    /**
+     * The number of pending timers
+     */
+    std::size_t m_size;
+
+    /**
+     * The time of tick 0
+     */
+    clock::time_point m_start;
+
+    /**
+     * The length of a tick
+     */
+    std::chrono::milliseconds m_tick;
+
+    /**
+     * The timerfd used by event_sink(), if one was requested
+     */
+    shared_fd m_timerfd;
+};
+
+}  // namespace jfern
+
+#endif  // NETWORKING_TIMER_WHEEL_H_
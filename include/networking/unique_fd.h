@@ -9,6 +9,7 @@
 #ifndef NETWORKING_UNIQUE_FD_H_
 #define NETWORKING_UNIQUE_FD_H_
 
+#include "basic_unique_fd.h"
 #include "fd_interface.h"
 
 namespace jfern {
@@ -19,6 +20,10 @@ namespace jfern {
  * std::unique_ptr. A unique_fd cannot be copied, but ownership of the file
  * descriptor it manages can be transferred to another instance. The file
  * descriptor is closed once the owning instance is destroyed
+ *
+ * @note Where the file descriptor type is known at compile time, prefer
+ *       \ref basic_unique_fd, which has no vtable and dispatches handlers
+ *       statically
  */
 class unique_fd final : public fd_interface {
 public:
@@ -58,11 +63,8 @@ public:
     void swap(unique_fd& fd) noexcept;
 
 private:
-    /** True if blocking behavior is enabled */
-    bool m_blocking;
-
-    /** The actual file descriptor */
-    int m_fd;
+    /** The file descriptor, to which all operations are forwarded */
+    basic_unique_fd m_fd;
 };
 
 }  // namespace jfern
@@ -11,17 +11,33 @@
 #ifndef CHANNEL_H_
 #define CHANNEL_H_
 
-#include "jfern/data_buffer.h"
-#include "jfern/net.h"
+#include <cstddef>
+#include <cstdint>
+
+#include "networking/net.h"
 
 namespace jfern {
 
+/**
+ * A bidirectional byte channel to a remote peer
+ */
 class Channel {
 public:
     Channel();
 
+    Channel(const Channel& channel)            = delete;
+    Channel(Channel&& channel)                 = delete;
+    Channel& operator=(const Channel& channel) = delete;
+    Channel& operator=(Channel&& channel)      = delete;
+
     virtual ~Channel();
 
+    virtual NetError Close() = 0;
+
+    virtual NetError Read(std::uint8_t* data, std::size_t* nbytes) = 0;
+
+    virtual NetError Write(const std::uint8_t* data, std::size_t nbytes) = 0;
+
     template <typename T>
     NetError Read(T* data);
 
@@ -29,9 +45,42 @@ public:
     NetError Write(const T& data);
 
 protected:
-    DataBuffer m_buf;
+    virtual NetError Flush() = 0;
 };
 
+/**
+ * @brief Read a single element, in host byte order, from the channel
+ *
+ * @param[out] data The element read
+ *
+ * @return kSuccess if all of \a data was read
+ */
+template <typename T>
+NetError Channel::Read(T* data) {
+    std::size_t nbytes = sizeof(T);
+
+    const NetError error = Read(reinterpret_cast<std::uint8_t*>(data),
+                                &nbytes);
+    if (error != NetError::kSuccess) return error;
+
+    *data = to_host_order(*data);
+    return NetError::kSuccess;
+}
+
+/**
+ * @brief Write a single element to the channel in network byte order
+ *
+ * @param[in] data The element to write
+ *
+ * @return kSuccess if all of \a data was written
+ */
+template <typename T>
+NetError Channel::Write(const T& data) {
+    const T output = to_network_order(data);
+
+    return Write(reinterpret_cast<const std::uint8_t*>(&output), sizeof(T));
+}
+
 }  // namespace jfern
 
 #endif  // CHANNEL_H_
@@ -0,0 +1,26 @@
+/**
+ *  \file   socket_address.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/io_tools
+ */
+
+#ifndef SOCKET_ADDRESS_H_
+#define SOCKET_ADDRESS_H_
+
+#include <netinet/in.h>
+
+#include <cstdint>
+#include <string>
+
+#include "networking/net.h"
+
+namespace jfern {
+
+NetError MakeSocketAddress(const std::string& host, std::uint16_t port,
+                           struct sockaddr_in* addr);
+
+}  // namespace jfern
+
+#endif  // SOCKET_ADDRESS_H_
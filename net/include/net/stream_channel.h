@@ -1,36 +1,207 @@
+/**
+ *  \file   stream_channel.h
+ *  \author Jason Fernandez
+ *  \date   09/26/2021
+ *
+ *  Copyright 2021 Jason Fernandez
+ *
+ *  https://github.com/jfern2011/io_tools
+ */
+
 #ifndef STREAM_CHANNEL_H_
 #define STREAM_CHANNEL_H_
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
-#include "jfern/net.h"
+#include "net/channel.h"
+#include "networking/fd_event_sink.h"
+#include "networking/net.h"
+#include "networking/reactor.h"
+#include "networking/shared_fd.h"
 
 namespace jfern {
 
-class StreamChannel final : public Channel {
+/**
+ * A buffered channel over a connected, non-blocking TCP socket
+ *
+ * @details
+ * Writes are appended to an output buffer and only sent when Flush() is
+ * called, when the buffer fills, or, if the channel is attached to a reactor
+ * via FlushOnTick(), at the end of the reactor iteration in which they were
+ * made. Many small writes thus cost a single send(). If the socket cannot
+ * take all of a deferred flush, the channel waits for POLLOUT through the
+ * reactor and sends the rest once the socket is writable. Since we coalesce
+ * in userspace, the socket is set to TCP_NODELAY so the kernel sends each
+ * flush right away rather than waiting on Nagle's algorithm
+ *
+ * Reads are served from an input buffer which is refilled with as much data
+ * as the socket has available, so small typed reads do not each cost a
+ * read(2). A read either completes in full or consumes nothing
+ *
+ * The stream operators behave like those of std::iostream: the first failure
+ * is recorded in Status(), and later operations do nothing until the status
+ * is cleared
+ */
+class StreamChannel final
+    : public Channel, public std::enable_shared_from_this<StreamChannel> {
 public:
-    StreamChannel(const std::string& host, std::uint16_t);
+    /**
+     * The default size of each of the input and output buffers
+     */
+    static constexpr std::size_t kDefaultBufferSize = 16 * 1024;
+
+    explicit StreamChannel(shared_fd fd,
+                           std::size_t buffer_size = kDefaultBufferSize);
+
+    StreamChannel(const std::string& host, std::uint16_t port,
+                  std::size_t buffer_size = kDefaultBufferSize);
 
     ~StreamChannel();
 
+    explicit operator bool() const noexcept;
+
+    std::size_t Available() const noexcept;
+
+    void ClearStatus() noexcept;
+
     NetError Close() override;
 
+    const shared_fd& Fd() const noexcept;
+
+    NetError Fill();
+
+    NetError Flush() override;
+
+    void FlushOnTick(reactor* loop) noexcept;
+
+    std::size_t Pending() const noexcept;
+
+    using Channel::Read;
+    using Channel::Write;
+
     NetError Read(std::uint8_t* data, std::size_t* nbytes) override;
 
+    NetError Status() const noexcept;
+
     NetError Write(const std::uint8_t* data, std::size_t nbytes) override;
 
     template <typename T>
     StreamChannel& operator<<(const T& data);
 
     template <typename T>
-    StreamChannel& operator>>(const T& data);
+    StreamChannel& operator>>(T& data);
 
 private:
-    NetError Flush() override;
+    void DeferredFlush();
+
+    void OnWritable();
+
+    void Record(NetError error) noexcept;
+
+    void ScheduleFlush();
+
+    void StopWatchingWritable();
+
+    void WatchWritable();
+
+    /**
+     * Nominal size of each buffer
+     */
+    std::size_t m_capacity;
+
+    /**
+     * True once the peer has closed its end of the connection
+     */
+    bool m_eof;
+
+    /**
+     * The connected socket
+     */
+    shared_fd m_fd;
+
+    /**
+     * True while a flush is deferred to the end of a reactor iteration
+     */
+    bool m_flush_scheduled;
+
+    /**
+     * Bytes received but not yet read. Valid from m_in_begin to m_in_end
+     */
+    std::vector<std::uint8_t> m_in;
+
+    /**
+     * Offset of the first unread byte in m_in
+     */
+    std::size_t m_in_begin;
+
+    /**
+     * One past the offset of the last unread byte in m_in
+     */
+    std::size_t m_in_end;
+
+    /**
+     * If set, the reactor at the end of whose iterations we flush
+     */
+    reactor* m_loop;
+
+    /**
+     * Bytes written but not yet sent, from m_out_begin onward
+     */
+    std::vector<std::uint8_t> m_out;
+
+    /**
+     * Offset of the first unsent byte in m_out
+     */
+    std::size_t m_out_begin;
+
+    /**
+     * True if m_write_sink was registered with the reactor by us, rather
+     * than being a sink already registered for the socket
+     */
+    bool m_owns_write_sink;
+
+    /**
+     * The first error encountered by a stream operator
+     */
+    NetError m_status;
+
+    /**
+     * While output is backed up, the sink through which we wait for the
+     * socket to become writable. Null otherwise
+     */
+    std::shared_ptr<fd_event_sink> m_write_sink;
 };
 
+/**
+ * @brief Write a single element to the channel in network byte order
+ *
+ * @param[in] data The element to write
+ *
+ * @return *this
+ */
+template <typename T>
+StreamChannel& StreamChannel::operator<<(const T& data) {
+    if (m_status == NetError::kSuccess) Record(Write(data));
+    return *this;
+}
+
+/**
+ * @brief Read a single element, in host byte order, from the channel
+ *
+ * @param[out] data The element read. Unchanged on failure
+ *
+ * @return *this
+ */
+template <typename T>
+StreamChannel& StreamChannel::operator>>(T& data) {
+    if (m_status == NetError::kSuccess) Record(Read(&data));
+    return *this;
+}
+
 }  // namespace jfern
 
 #endif  // STREAM_CHANNEL_H_
@@ -1,26 +1,116 @@
+/**
+ *  \file   tcp_server.h
+ *  \author Jason Fernandez
+ *  \date   09/26/2021
+ *
+ *  Copyright 2021 Jason Fernandez
+ *
+ *  https://github.com/jfern2011/io_tools
+ */
+
 #ifndef TCP_SERVER_H_
 #define TCP_SERVER_H_
 
+#include <sys/socket.h>
+
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
-#include "jfern/stream_channel.h"
+#include "net/stream_channel.h"
+#include "networking/fd_event_sink.h"
+#include "networking/net.h"
+#include "networking/shared_fd.h"
+#include "networking/unique_fd.h"
 
 namespace jfern {
 
+/**
+ * Accepts TCP connections on a non-blocking listening socket
+ *
+ * @details
+ * Each readiness event on the listening socket may represent any number of
+ * pending connections, so AcceptAll() drains the backlog with accept4() until
+ * it would block. Every connection is handed out as a StreamChannel owned by
+ * the server; callers hold weak references
+ *
+ * To shard accepts across threads, give each thread its own TcpServer bound
+ * to the same address with Options::reuse_port set. The kernel then spreads
+ * incoming connections across the listening sockets
+ *
+ * While listening, the server holds one spare descriptor in reserve. If the
+ * process runs out of descriptors, a pending connection cannot be accepted,
+ * and the level-triggered listener would report it again right away. The
+ * server then closes the spare, accepts the connection into its slot, closes
+ * the connection at once, and reopens the spare. Such connections are dropped
+ * rather than left pending
+ */
 class TcpServer {
 public:
+    /**
+     * Called with each accepted connection
+     */
+    using AcceptHandler = std::function<void(std::weak_ptr<StreamChannel>)>;
+
+    /**
+     * Listening socket configuration
+     */
+    struct Options {
+        /**
+         * The maximum number of connections waiting to be accepted
+         */
+        int backlog = SOMAXCONN;
+
+        /**
+         * If non-zero, set TCP_DEFER_ACCEPT so that a connection is not
+         * reported until the client sends data or this many seconds elapse
+         */
+        int defer_accept_secs = 0;
+
+        /**
+         * The most connections accepted per call to AcceptAll(), or zero
+         * to accept until the backlog is drained
+         */
+        std::size_t max_accepts = 0;
+
+        /**
+         * If true, set SO_REUSEPORT so that several servers may listen on the
+         * same port
+         */
+        bool reuse_port = false;
+    };
+
     TcpServer();
 
     TcpServer(const std::string& host, std::uint16_t port);
 
+    TcpServer(const std::string& host, std::uint16_t port,
+              const Options& options);
+
+    TcpServer(const TcpServer& server)            = delete;
+    TcpServer(TcpServer&& server)                 = delete;
+    TcpServer& operator=(const TcpServer& server) = delete;
+    TcpServer& operator=(TcpServer&& server)      = delete;
+
     ~TcpServer();
 
     std::weak_ptr<StreamChannel> Accept();
 
+    std::size_t AcceptAll(const AcceptHandler& handler);
+
+    std::size_t Channels() const noexcept;
+
+    std::shared_ptr<fd_event_sink> EventSink(AcceptHandler handler);
+
+    bool Listening() const noexcept;
+
+    std::uint16_t Port() const;
+
+    NetError Release(const std::weak_ptr<StreamChannel>& channel);
+
     NetError Reset();
     NetError Reset(const std::string& host, std::uint16_t port);
 
@@ -28,8 +118,41 @@ public:
     NetError Stop();
 
 private:
+    NetError AcceptOne(std::shared_ptr<StreamChannel>* channel);
+
+    NetError ShedOne();
+
+    /**
+     * Connections accepted so far
+     */
     std::vector<std::shared_ptr<StreamChannel>>
         m_channels;
+
+    /**
+     * The local address to listen on
+     */
+    std::string m_host;
+
+    /**
+     * The listening socket, if started
+     */
+    shared_fd m_listener;
+
+    /**
+     * Listening socket configuration
+     */
+    Options m_options;
+
+    /**
+     * The local port to listen on
+     */
+    std::uint16_t m_port;
+
+    /**
+     * A descriptor held in reserve while listening, given up to drop a
+     * connection when the process runs out of descriptors
+     */
+    unique_fd m_spare;
 };
 
 }  // namespace jfern
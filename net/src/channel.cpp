@@ -0,0 +1,25 @@
+/**
+ *  \file   channel.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/io_tools
+ */
+
+#include "net/channel.h"
+
+namespace jfern {
+
+/**
+ * @brief Constructor
+ */
+Channel::Channel() {
+}
+
+/**
+ * @brief Destructor
+ */
+Channel::~Channel() {
+}
+
+}  // namespace jfern
@@ -0,0 +1,62 @@
+/**
+ *  \file   socket_address.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/io_tools
+ */
+
+#include "net/socket_address.h"
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <sys/socket.h>
+
+#include <cstring>
+
+namespace jfern {
+
+/**
+ * @brief Build an IPv4 socket address
+ *
+ * @param[in]  host A host name or IP address. If empty, the address refers
+ *                  to all local interfaces
+ * @param[in]  port The port number, in host byte order
+ * @param[out] addr The socket address
+ *
+ * @return kSuccess, or kInvalidArgument if \a host could not be resolved
+ */
+NetError MakeSocketAddress(const std::string& host, std::uint16_t port,
+                           struct sockaddr_in* addr) {
+    std::memset(addr, 0, sizeof(*addr));
+
+    addr->sin_family = AF_INET;
+    addr->sin_port   = htons(port);
+
+    if (host.empty()) {
+        addr->sin_addr.s_addr = htonl(INADDR_ANY);
+        return NetError::kSuccess;
+    }
+
+    if (::inet_pton(AF_INET, host.c_str(), &addr->sin_addr) == 1) {
+        return NetError::kSuccess;
+    }
+
+    struct addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+
+    hints.ai_family = AF_INET;
+
+    struct addrinfo* result = nullptr;
+    if (::getaddrinfo(host.c_str(), nullptr, &hints, &result) != 0) {
+        return NetError::kInvalidArgument;
+    }
+
+    addr->sin_addr =
+        reinterpret_cast<struct sockaddr_in*>(result->ai_addr)->sin_addr;
+
+    ::freeaddrinfo(result);
+    return NetError::kSuccess;
+}
+
+}  // namespace jfern
@@ -0,0 +1,506 @@
+/**
+ *  \file   stream_channel.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/io_tools
+ */
+
+#include "net/stream_channel.h"
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include "net/socket_address.h"
+#include "networking/posix_api.h"
+
+namespace jfern {
+namespace {
+/**
+ * Disable Nagle's algorithm, since we coalesce writes ourselves
+ *
+ * @param[in] fd The socket
+ */
+void set_no_delay(const shared_fd& fd) {
+    const int enable = 1;
+
+    if (fd) {
+        posix_setsockopt(fd.get(), IPPROTO_TCP, TCP_NODELAY, &enable,
+                         sizeof(enable));
+    }
+}
+
+}  // namespace
+
+/**
+ * @brief Constructor
+ *
+ * @param fd          A connected, non-blocking TCP socket
+ * @param buffer_size The size of each of the input and output buffers
+ */
+StreamChannel::StreamChannel(shared_fd fd, std::size_t buffer_size)
+    : Channel(),
+      m_capacity(buffer_size == 0 ? 1 : buffer_size),
+      m_eof(false),
+      m_fd(std::move(fd)),
+      m_flush_scheduled(false),
+      m_in(m_capacity),
+      m_in_begin(0),
+      m_in_end(0),
+      m_loop(nullptr),
+      m_out(),
+      m_out_begin(0),
+      m_owns_write_sink(false),
+      m_status(NetError::kSuccess),
+      m_write_sink() {
+    m_out.reserve(m_capacity);
+    set_no_delay(m_fd);
+}
+
+/**
+ * @brief Constructor. Connects to a remote host
+ *
+ * @details The connection may still be in progress when this returns, in
+ *          which case flushes report kWouldBlock until it completes. If the
+ *          connection fails outright, the channel is not open
+ *
+ * @param host        The remote host name or IP address
+ * @param port        The remote port number
+ * @param buffer_size The size of each of the input and output buffers
+ */
+StreamChannel::StreamChannel(const std::string& host, std::uint16_t port,
+                             std::size_t buffer_size)
+    : StreamChannel(shared_fd(), buffer_size) {
+    struct sockaddr_in addr;
+    if (MakeSocketAddress(host, port, &addr) != NetError::kSuccess) return;
+
+    shared_fd fd(posix_socket(AF_INET,
+                              SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0));
+    if (!fd) return;
+
+    if (posix_connect(fd.get(), reinterpret_cast<struct sockaddr*>(&addr),
+                      sizeof(addr)) != 0 && errno != EINPROGRESS) {
+        return;
+    }
+
+    m_fd = std::move(fd);
+    set_no_delay(m_fd);
+}
+
+/**
+ * @brief Destructor. Makes a last attempt to send any buffered output
+ */
+StreamChannel::~StreamChannel() {
+    Flush();
+    StopWatchingWritable();
+}
+
+/**
+ * @brief Check whether the channel is open
+ *
+ * @return True if the socket is open
+ */
+StreamChannel::operator bool() const noexcept {
+    return static_cast<bool>(m_fd);
+}
+
+/**
+ * @brief Get the number of bytes buffered for reading
+ *
+ * @return The number of bytes which can be read without a system call
+ */
+std::size_t StreamChannel::Available() const noexcept {
+    return m_in_end - m_in_begin;
+}
+
+/**
+ * @brief Clear the error recorded by the stream operators
+ */
+void StreamChannel::ClearStatus() noexcept {
+    m_status = NetError::kSuccess;
+}
+
+/**
+ * @brief Send any buffered output, then close the connection. Other owners
+ *        of the socket keep it open
+ *
+ * @return The result of the final flush. The channel is closed regardless
+ */
+NetError StreamChannel::Close() {
+    const NetError error = Flush();
+
+    StopWatchingWritable();
+
+    m_fd = shared_fd();
+
+    m_in_begin = m_in_end = 0;
+    m_out.clear();
+    m_out_begin = 0;
+
+    return error;
+}
+
+/**
+ * @brief Get the underlying socket, e.g. to register it with a reactor
+ *
+ * @return The socket
+ */
+const shared_fd& StreamChannel::Fd() const noexcept {
+    return m_fd;
+}
+
+/**
+ * @brief Read as much as the socket has available into the input buffer,
+ *        e.g. upon a readiness event
+ *
+ * @return kSuccess if any bytes were read or the buffer is already full,
+ *         kWouldBlock if none were available, or kClosed if the peer has
+ *         closed the connection
+ */
+NetError StreamChannel::Fill() {
+    if (!m_fd) return NetError::kClosed;
+
+    // Make room at the end by moving unread bytes to the front
+    if (m_in_begin > 0) {
+        std::memmove(m_in.data(), m_in.data() + m_in_begin, Available());
+
+        m_in_end  -= m_in_begin;
+        m_in_begin = 0;
+    }
+
+    if (m_in_end == m_in.size()) return NetError::kSuccess;
+    if (m_eof) return NetError::kClosed;
+
+    while (true) {
+        const ssize_t n = posix_read(m_fd.get(), m_in.data() + m_in_end,
+                                     m_in.size() - m_in_end);
+        if (n > 0) {
+            m_in_end += static_cast<std::size_t>(n);
+            return NetError::kSuccess;
+        } else if (n == 0) {
+            m_eof = true;
+            return NetError::kClosed;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return NetError::kWouldBlock;
+        } else if (errno != EINTR) {
+            return NetError::kSystemError;
+        }
+    }
+}
+
+/**
+ * @brief Send as much buffered output as the socket accepts
+ *
+ * @return kSuccess if all buffered output was sent, kWouldBlock if some
+ *         remains, or kClosed if the peer has closed the connection
+ */
+NetError StreamChannel::Flush() {
+    if (Pending() == 0) return NetError::kSuccess;
+    if (!m_fd) return NetError::kClosed;
+
+    while (m_out_begin < m_out.size()) {
+        // Report a closed peer as an error rather than raising SIGPIPE
+        const ssize_t n = posix_send(m_fd.get(), m_out.data() + m_out_begin,
+                                     m_out.size() - m_out_begin,
+                                     MSG_NOSIGNAL);
+        if (n >= 0) {
+            m_out_begin += static_cast<std::size_t>(n);
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return NetError::kWouldBlock;
+        } else if (errno == EPIPE || errno == ECONNRESET) {
+            return NetError::kClosed;
+        } else if (errno != EINTR) {
+            return NetError::kSystemError;
+        }
+    }
+
+    m_out.clear();
+    m_out_begin = 0;
+
+    return NetError::kSuccess;
+}
+
+/**
+ * @brief Flush automatically at the end of each reactor iteration in which
+ *        output was buffered
+ *
+ * @details If the socket cannot take all of it, the channel adds a POLLOUT
+ *          handler to the sink registered for the socket with \a loop, or
+ *          registers a sink of its own if there is none, and removes it
+ *          once the output is sent. An application which registers the
+ *          socket itself should do so before writing, since the reactor
+ *          holds only one sink per descriptor
+ *
+ * @note The channel must be owned by a std::shared_ptr, as are those handed
+ *       out by a TcpServer, and \a loop must outlive it
+ *
+ * @param loop The reactor, or null to only flush explicitly or when the
+ *             buffer fills
+ */
+void StreamChannel::FlushOnTick(reactor* loop) noexcept {
+    m_loop = loop;
+}
+
+/**
+ * @brief Get the number of bytes buffered for sending
+ *
+ * @return The number of bytes written but not yet sent
+ */
+std::size_t StreamChannel::Pending() const noexcept {
+    return m_out.size() - m_out_begin;
+}
+
+/**
+ * @brief Read from the channel
+ *
+ * @details A request no larger than the input buffer completes in full or
+ *          consumes nothing. Larger requests are served partly from the
+ *          buffer and partly straight from the socket, and may be partial
+ *
+ * @param[out]    data   The bytes read
+ * @param[in,out] nbytes The number of bytes to read. Set to the number of
+ *                       bytes actually read
+ *
+ * @return kSuccess if all bytes requested were read, kWouldBlock if fewer
+ *         were available, or kClosed if the peer closed the connection
+ */
+NetError StreamChannel::Read(std::uint8_t* data, std::size_t* nbytes) {
+    const std::size_t wanted = *nbytes;
+    *nbytes = 0;
+
+    if (wanted <= m_in.size()) {
+        while (Available() < wanted) {
+            const NetError error = Fill();
+            if (error != NetError::kSuccess) return error;
+        }
+
+        std::memcpy(data, m_in.data() + m_in_begin, wanted);
+
+        m_in_begin += wanted;
+        *nbytes     = wanted;
+
+        return NetError::kSuccess;
+    }
+
+    const std::size_t buffered = Available();
+
+    std::memcpy(data, m_in.data() + m_in_begin, buffered);
+    m_in_begin = m_in_end = 0;
+    *nbytes    = buffered;
+
+    if (!m_fd) return NetError::kClosed;
+
+    while (*nbytes < wanted) {
+        const ssize_t n = posix_read(m_fd.get(), data + *nbytes,
+                                     wanted - *nbytes);
+        if (n > 0) {
+            *nbytes += static_cast<std::size_t>(n);
+        } else if (n == 0) {
+            m_eof = true;
+            return NetError::kClosed;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return NetError::kWouldBlock;
+        } else if (errno != EINTR) {
+            return NetError::kSystemError;
+        }
+    }
+
+    return NetError::kSuccess;
+}
+
+/**
+ * @brief Get the first error encountered by a stream operator
+ *
+ * @return kSuccess if all stream operations since the last ClearStatus()
+ *         have succeeded
+ */
+NetError StreamChannel::Status() const noexcept {
+    return m_status;
+}
+
+/**
+ * @brief Write to the channel. The bytes are buffered, and only sent if the
+ *        buffer fills
+ *
+ * @details If the socket is backed up such that the buffer cannot hold
+ *          \a nbytes more, nothing is written. A request larger than the
+ *          buffer is accepted whenever no earlier output is pending
+ *
+ * @param[in] data   The bytes to write
+ * @param[in] nbytes The number of bytes to write
+ *
+ * @return kSuccess if all bytes were accepted, or kWouldBlock if none were
+ */
+NetError StreamChannel::Write(const std::uint8_t* data, std::size_t nbytes) {
+    if (!m_fd) return NetError::kClosed;
+
+    if (Pending() + nbytes > m_capacity) {
+        const NetError error = Flush();
+
+        if (error != NetError::kSuccess && error != NetError::kWouldBlock) {
+            return error;
+        }
+
+        // Don't grow past the buffer size behind output the peer hasn't
+        // taken yet
+        if (Pending() > 0 && Pending() + nbytes > m_capacity) {
+            return NetError::kWouldBlock;
+        }
+    }
+
+    // Reclaim the space taken by bytes already sent
+    if (m_out_begin > 0) {
+        m_out.erase(m_out.begin(), m_out.begin() + m_out_begin);
+        m_out_begin = 0;
+    }
+
+    m_out.insert(m_out.end(), data, data + nbytes);
+
+    if (Pending() >= m_capacity) {
+        const NetError error = Flush();
+
+        if (error != NetError::kSuccess && error != NetError::kWouldBlock) {
+            return error;
+        }
+    }
+
+    ScheduleFlush();
+    return NetError::kSuccess;
+}
+
+/**
+ * @brief Run a flush deferred by ScheduleFlush()
+ *
+ * @details If the socket would block, the rest of the output is sent once
+ *          the reactor reports the socket writable, rather than being left
+ *          buffered until the next write
+ */
+void StreamChannel::DeferredFlush() {
+    m_flush_scheduled = false;
+
+    if (Flush() == NetError::kWouldBlock) WatchWritable();
+}
+
+/**
+ * @brief Send backed up output once the socket is writable, and stop
+ *        waiting once it is all sent or the connection fails
+ */
+void StreamChannel::OnWritable() {
+    if (Flush() != NetError::kWouldBlock) StopWatchingWritable();
+}
+
+/**
+ * @brief Record the result of a stream operation
+ *
+ * @param error The result
+ */
+void StreamChannel::Record(NetError error) noexcept {
+    if (error != NetError::kSuccess) m_status = error;
+}
+
+/**
+ * @brief Defer a flush to the end of the current reactor iteration, if there
+ *        is pending output and neither a deferred flush nor a wait for the
+ *        socket to become writable is under way
+ */
+void StreamChannel::ScheduleFlush() {
+    if (!m_loop || m_flush_scheduled || m_write_sink || Pending() == 0)
+        return;
+
+    std::weak_ptr<StreamChannel> self = weak_from_this();
+    if (self.expired()) return;
+
+    m_flush_scheduled = true;
+
+    m_loop->defer([self]() {
+        if (const std::shared_ptr<StreamChannel> channel = self.lock())
+            channel->DeferredFlush();
+    });
+}
+
+/**
+ * @brief Stop waiting for the socket to become writable, removing the sink
+ *        or handler added by WatchWritable()
+ */
+void StreamChannel::StopWatchingWritable() {
+    if (!m_write_sink) return;
+
+    const int fd = m_write_sink->get();
+
+    if (m_owns_write_sink) {
+        m_loop->remove(fd);
+    } else {
+        m_write_sink->remove_events(POLLOUT);
+        m_loop->update(fd);
+    }
+
+    m_write_sink.reset();
+    m_owns_write_sink = false;
+}
+
+/**
+ * @brief Wait for the socket to become writable, so that backed up output is
+ *        sent without polling for it
+ *
+ * @details The handler is added to the sink already registered for the
+ *          socket, if any. Otherwise we register a sink of our own, which
+ *          also handles POLLERR and POLLHUP, since epoll reports those
+ *          whether asked for or not
+ */
+void StreamChannel::WatchWritable() {
+    if (!m_loop || m_write_sink || !m_fd) return;
+
+    std::weak_ptr<StreamChannel> self = weak_from_this();
+    if (self.expired()) return;
+
+    auto on_writable = [self]() {
+        if (const std::shared_ptr<StreamChannel> channel = self.lock())
+            channel->OnWritable();
+    };
+
+    std::shared_ptr<fd_event_sink> sink = m_loop->find(m_fd.get());
+
+    if (sink) {
+        // Match the sink's triggering mode. We send until the socket would
+        // block, so an edge-triggered handler sees every new edge
+        if (sink->edge_triggered()) {
+            sink->add_edge_events(POLLOUT, [on_writable](short, edge_io&) {
+                on_writable();
+            });
+        } else {
+            sink->add_events(POLLOUT, [on_writable](short, fd_interface&) {
+                on_writable();
+            });
+        }
+
+        if (!m_loop->update(m_fd.get())) {
+            sink->remove_events(POLLOUT);
+            return;
+        }
+
+        m_owns_write_sink = false;
+    } else {
+        sink = std::make_shared<fd_event_sink>(
+            std::unique_ptr<fd_interface>(new shared_fd(m_fd)));
+
+        sink->add_events(POLLOUT | POLLERR | POLLHUP,
+                         [on_writable](short, fd_interface&) {
+                             on_writable();
+                         });
+
+        if (!m_loop->add(sink)) return;
+
+        m_owns_write_sink = true;
+    }
+
+    m_write_sink = std::move(sink);
+}
+
+}  // namespace jfern
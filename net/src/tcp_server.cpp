@@ -0,0 +1,372 @@
+/**
+ *  \file   tcp_server.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/io_tools
+ */
+
+#include "net/tcp_server.h"
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <utility>
+
+#include "net/socket_address.h"
+#include "networking/posix_api.h"
+
+namespace jfern {
+
+/**
+ * @brief Constructor. Listens on all interfaces, on a port chosen by the
+ *        system
+ */
+TcpServer::TcpServer() : TcpServer("", 0, Options()) {
+}
+
+/**
+ * @brief Constructor
+ *
+ * @param host The local address to listen on, or an empty string for all
+ *             interfaces
+ * @param port The local port to listen on, or zero to let the system choose
+ */
+TcpServer::TcpServer(const std::string& host, std::uint16_t port)
+    : TcpServer(host, port, Options()) {
+}
+
+/**
+ * @brief Constructor
+ *
+ * @param host    The local address to listen on, or an empty string for all
+ *                interfaces
+ * @param port    The local port to listen on, or zero to let the system
+ *                choose
+ * @param options Listening socket configuration
+ */
+TcpServer::TcpServer(const std::string& host, std::uint16_t port,
+                     const Options& options)
+    : m_channels(),
+      m_host(host),
+      m_listener(),
+      m_options(options),
+      m_port(port),
+      m_spare() {
+}
+
+/**
+ * @brief Destructor
+ */
+TcpServer::~TcpServer() {
+}
+
+/**
+ * @brief Accept a single pending connection
+ *
+ * @return The new connection, or an expired reference if none was pending
+ */
+std::weak_ptr<StreamChannel> TcpServer::Accept() {
+    std::shared_ptr<StreamChannel> channel;
+    AcceptOne(&channel);
+
+    return channel;
+}
+
+/**
+ * @brief Accept pending connections until accept4() would block, or until
+ *        Options::max_accepts have been accepted
+ *
+ * @details Call this each time the listening socket becomes readable
+ *
+ * @param handler Called with each connection accepted
+ *
+ * @return The number of connections accepted
+ */
+std::size_t TcpServer::AcceptAll(const AcceptHandler& handler) {
+    std::size_t count = 0;
+
+    while (m_options.max_accepts == 0 || count < m_options.max_accepts) {
+        std::shared_ptr<StreamChannel> channel;
+        if (AcceptOne(&channel) != NetError::kSuccess) break;
+
+        count++;
+        if (handler) handler(channel);
+    }
+
+    return count;
+}
+
+/**
+ * @brief Get the number of connections held by the server
+ *
+ * @return The number of connections accepted and not yet released
+ */
+std::size_t TcpServer::Channels() const noexcept {
+    return m_channels.size();
+}
+
+/**
+ * @brief Create an event sink which drains the backlog each time the
+ *        listening socket becomes readable, for registration with a
+ *        \ref reactor
+ *
+ * @param handler Called with each connection accepted
+ *
+ * @note The sink refers back to this server, which must therefore outlive
+ *       it, including any registration of it with a reactor
+ *
+ * @return The event sink, or null if the server is not listening
+ */
+std::shared_ptr<fd_event_sink> TcpServer::EventSink(AcceptHandler handler) {
+    if (!m_listener) return nullptr;
+
+    auto sink = std::make_shared<fd_event_sink>(
+        std::unique_ptr<fd_interface>(new shared_fd(m_listener)));
+
+    sink->add_events(POLLIN,
+                     [this, handler](short, fd_interface&) {
+                         AcceptAll(handler);
+                     });
+
+    return sink;
+}
+
+/**
+ * @brief Check whether the server has been started
+ *
+ * @return True if the listening socket is open
+ */
+bool TcpServer::Listening() const noexcept {
+    return static_cast<bool>(m_listener);
+}
+
+/**
+ * @brief Get the port the server is listening on, which is useful when the
+ *        system chose it
+ *
+ * @return The local port number, or zero if not listening
+ */
+std::uint16_t TcpServer::Port() const {
+    if (!m_listener) return 0;
+
+    struct sockaddr_in addr;
+    socklen_t len = sizeof(addr);
+
+    if (posix_getsockname(m_listener.get(),
+                          reinterpret_cast<struct sockaddr*>(&addr),
+                          &len) != 0) {
+        return 0;
+    }
+
+    return ntohs(addr.sin_port);
+}
+
+/**
+ * @brief Give up the server's ownership of a connection. The connection is
+ *        closed once no one else holds it
+ *
+ * @param channel The connection to release
+ *
+ * @return kSuccess, or kInvalidArgument if \a channel is not held by this
+ *         server
+ */
+NetError TcpServer::Release(const std::weak_ptr<StreamChannel>& channel) {
+    const std::shared_ptr<StreamChannel> target = channel.lock();
+
+    auto iter = std::find(m_channels.begin(), m_channels.end(), target);
+    if (!target || iter == m_channels.end()) {
+        return NetError::kInvalidArgument;
+    }
+
+    m_channels.erase(iter);
+    return NetError::kSuccess;
+}
+
+/**
+ * @brief Stop listening and release all connections
+ *
+ * @return kSuccess
+ */
+NetError TcpServer::Reset() {
+    m_channels.clear();
+    return Stop();
+}
+
+/**
+ * @brief Stop listening, release all connections, and set a new address to
+ *        listen on when next started
+ *
+ * @param host The local address to listen on, or an empty string for all
+ *             interfaces
+ * @param port The local port to listen on, or zero to let the system choose
+ *
+ * @return kSuccess
+ */
+NetError TcpServer::Reset(const std::string& host, std::uint16_t port) {
+    m_host = host;
+    m_port = port;
+
+    return Reset();
+}
+
+/**
+ * @brief Start listening for connections
+ *
+ * @return kSuccess, or the reason the listening socket could not be set up,
+ *         with errno set for kSystemError
+ */
+NetError TcpServer::Start() {
+    if (m_listener) return NetError::kSuccess;
+
+    struct sockaddr_in addr;
+
+    const NetError error = MakeSocketAddress(m_host, m_port, &addr);
+    if (error != NetError::kSuccess) return error;
+
+    shared_fd fd(posix_socket(AF_INET,
+                              SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0));
+    if (!fd) return NetError::kSystemError;
+
+    const int enable = 1;
+
+    if (posix_setsockopt(fd.get(), SOL_SOCKET, SO_REUSEADDR, &enable,
+                         sizeof(enable)) != 0) {
+        return NetError::kSystemError;
+    }
+
+    if (m_options.reuse_port &&
+        posix_setsockopt(fd.get(), SOL_SOCKET, SO_REUSEPORT, &enable,
+                         sizeof(enable)) != 0) {
+        return NetError::kSystemError;
+    }
+
+    if (m_options.defer_accept_secs > 0 &&
+        posix_setsockopt(fd.get(), IPPROTO_TCP, TCP_DEFER_ACCEPT,
+                         &m_options.defer_accept_secs,
+                         sizeof(m_options.defer_accept_secs)) != 0) {
+        return NetError::kSystemError;
+    }
+
+    if (posix_bind(fd.get(), reinterpret_cast<struct sockaddr*>(&addr),
+                   sizeof(addr)) != 0 ||
+        posix_listen(fd.get(), m_options.backlog) != 0) {
+        return NetError::kSystemError;
+    }
+
+    m_listener = std::move(fd);
+
+    // Any descriptor will do; an eventfd is cheap and needs no file system
+    m_spare.reset(posix_eventfd(0, EFD_CLOEXEC));
+
+    return NetError::kSuccess;
+}
+
+/**
+ * @brief Stop listening. Connections already accepted remain open
+ *
+ * @return kSuccess
+ */
+NetError TcpServer::Stop() {
+    m_listener = shared_fd();
+    m_spare.reset(-1);
+
+    return NetError::kSuccess;
+}
+
+/**
+ * @brief Accept a single connection with accept4()
+ *
+ * @details Connections which cannot be accepted because the process is out
+ *          of descriptors are dropped (see ShedOne())
+ *
+ * @param[out] channel The new connection
+ *
+ * @return kSuccess, kWouldBlock if no connection is pending, kClosed if not
+ *         listening, or kSystemError, with errno set. errno is EMFILE or
+ *         ENFILE if the process is out of descriptors and the spare
+ *         descriptor could not be used to drop the connection
+ */
+NetError TcpServer::AcceptOne(std::shared_ptr<StreamChannel>* channel) {
+    if (!m_listener) return NetError::kClosed;
+
+    while (true) {
+        const int fd = posix_accept4(m_listener.get(), nullptr, nullptr,
+                                     SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd >= 0) {
+            *channel = std::make_shared<StreamChannel>(make_shared_fd(fd));
+            m_channels.push_back(*channel);
+
+            return NetError::kSuccess;
+        }
+
+        switch (errno) {
+        case EAGAIN:
+#if EAGAIN != EWOULDBLOCK
+        case EWOULDBLOCK:
+#endif
+            return NetError::kWouldBlock;
+        case ECONNABORTED:
+        case EINTR:
+            // e.g. the client reset before we got to it; try the next one
+            continue;
+        case EMFILE:
+        case ENFILE: {
+            const NetError error = ShedOne();
+            if (error == NetError::kSuccess) continue;
+            return error;
+        }
+        default:
+            return NetError::kSystemError;
+        }
+    }
+}
+
+/**
+ * @brief Drop a pending connection which cannot be accepted because the
+ *        process is out of descriptors
+ *
+ * @details The spare descriptor is closed to make room for the connection,
+ *          which is accepted and closed at once, and then the spare is
+ *          reopened
+ *
+ * @return kSuccess if a connection was dropped, kWouldBlock if none was
+ *         pending, or kSystemError, with errno set, if no room could be
+ *         made for one
+ */
+NetError TcpServer::ShedOne() {
+    if (!m_spare) return NetError::kSystemError;
+
+    m_spare.reset(-1);
+
+    const int fd = posix_accept4(m_listener.get(), nullptr, nullptr,
+                                 SOCK_CLOEXEC);
+    const int error = errno;
+
+    if (fd >= 0) posix_close(fd);
+
+    m_spare.reset(posix_eventfd(0, EFD_CLOEXEC));
+
+    if (fd >= 0) return NetError::kSuccess;
+
+    errno = error;
+
+    switch (error) {
+    case EAGAIN:
+#if EAGAIN != EWOULDBLOCK
+    case EWOULDBLOCK:
+#endif
+        return NetError::kWouldBlock;
+    case ECONNABORTED:
+    case EINTR:
+        return NetError::kSuccess;
+    default:
+        return NetError::kSystemError;
+    }
+}
+
+}  // namespace jfern
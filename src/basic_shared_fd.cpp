@@ -0,0 +1,259 @@
+/**
+ *  \file   basic_shared_fd.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include "networking/basic_shared_fd.h"
+
+#include <utility>
+
+#include "networking/file_descriptor.h"
+
+namespace jfern {
+/**
+ * @brief Default constructor
+ */
+basic_shared_fd::basic_shared_fd()
+    : m_blocking(false), m_shared_info(nullptr) {
+}
+
+/**
+ * @brief Constructor
+ *
+ * @param fd The file descriptor to manage
+ */
+basic_shared_fd::basic_shared_fd(int fd)
+    : m_blocking(false), m_shared_info(new fd::shared_internal(fd)) {
+}
+
+/**
+ * @brief Constructor
+ *
+ * @param fd   The file descriptor to manage
+ * @param mode How owners in different threads coordinate system calls
+ */
+basic_shared_fd::basic_shared_fd(int fd, fd::concurrency mode)
+    : m_blocking(false), m_shared_info(new fd::shared_internal(fd, mode)) {
+}
+
+/**
+ * @brief Copy constructor
+ *
+ * @param fd The basic_shared_fd whose file descriptor will be co-owned with
+ *           *this
+ */
+basic_shared_fd::basic_shared_fd(const basic_shared_fd& fd)
+    : m_blocking(false), m_shared_info(nullptr) {
+    *this = fd;
+}
+
+/**
+ * @brief Move constructor
+ *
+ * @param fd The basic_shared_fd whose file descriptor will be handed to
+ *           *this
+ */
+basic_shared_fd::basic_shared_fd(basic_shared_fd&& fd)
+    : m_blocking(false), m_shared_info(nullptr) {
+    *this = std::move(fd);
+}
+
+/**
+ * @brief Constructor which adopts a strong reference to an existing control
+ *        block
+ *
+ * @param shared_info The control block. Its reference count must already
+ *                    account for *this
+ */
+basic_shared_fd::basic_shared_fd(fd::shared_internal* shared_info)
+    : m_blocking(false), m_shared_info(shared_info) {
+    if (m_shared_info) {
+        const int blocking = m_shared_info->is_blocking();
+        if (blocking >= 0) m_blocking = blocking;
+    }
+}
+
+/**
+ * @brief Copy assignment operator
+ *
+ * @param fd The basic_shared_fd whose file descriptor will be co-owned with
+ *           *this
+ *
+ * @return *this
+ */
+basic_shared_fd& basic_shared_fd::operator=(const basic_shared_fd& fd) {
+    if (this != &fd) {
+        m_blocking = fd.m_blocking;
+
+        // Drop the currently referenced file descriptor
+        drop_reference();
+        m_shared_info = fd.m_shared_info;
+
+        if (m_shared_info) {
+            if (!m_shared_info->add_reference_if_valid()) {
+                m_shared_info = nullptr;
+            }
+        }
+    }
+
+    return *this;
+}
+
+/**
+ * @brief Move assignment operator
+ *
+ * @param fd The basic_shared_fd whose file descriptor will be handed to
+ *           *this
+ *
+ * @return *this
+ */
+basic_shared_fd& basic_shared_fd::operator=(basic_shared_fd&& fd) {
+    if (this != &fd) {
+        m_blocking = fd.m_blocking;
+
+        // Drop the currently referenced file descriptor
+        drop_reference();
+        m_shared_info = fd.m_shared_info;
+
+        fd.m_shared_info = nullptr;
+    }
+
+    return *this;
+}
+
+/**
+ * @brief Destructor. Closes the file descriptor if *this is its only owner
+ */
+basic_shared_fd::~basic_shared_fd() {
+    drop_reference();
+}
+
+/**
+ * @see See fd_interface::operator bool()
+ */
+basic_shared_fd::operator bool() const noexcept {
+    return m_shared_info;
+}
+
+/**
+ * @brief Get the concurrency mode of the managed file descriptor
+ *
+ * @return How owners in different threads coordinate system calls
+ */
+fd::concurrency basic_shared_fd::concurrency_mode() const noexcept {
+    return m_shared_info ? m_shared_info->mode()
+                         : fd::concurrency::serialized;
+}
+
+/**
+ * @see See fd_interface::get()
+ */
+int basic_shared_fd::get() const noexcept {
+    return m_shared_info ? m_shared_info->get() : -1;
+}
+
+/**
+ * @see See fd_interface::is_blocking()
+ */
+bool basic_shared_fd::is_blocking() const noexcept {
+    // In lock-free mode, report changes made through any owner
+    if (m_shared_info) {
+        const int blocking = m_shared_info->is_blocking();
+        if (blocking >= 0) return blocking;
+    }
+
+    return m_blocking;
+}
+
+/**
+ * @see See fd_interface::poll()
+ */
+int basic_shared_fd::poll(short events) noexcept {
+    if (!m_shared_info) return -1;
+
+    return m_shared_info->poll(events, 0);
+}
+
+/**
+ * @see See fd_interface::poll()
+ */
+int basic_shared_fd::poll(short events, int timeout) noexcept {
+    if (!m_shared_info) return -1;
+
+    return m_shared_info->poll(events, timeout);
+}
+
+/**
+ * @see See fd_interface::reset()
+ */
+bool basic_shared_fd::reset(int fd) noexcept {
+    if (!file_descriptor::set_blocking(fd, m_blocking)) {
+        return false;
+    }
+
+    const fd::concurrency mode = concurrency_mode();
+
+    drop_reference();
+
+    m_shared_info = new fd::shared_internal(fd, mode);
+    return m_shared_info;
+}
+
+/**
+ * @see See fd_interface::set_blocking()
+ */
+bool basic_shared_fd::set_blocking(bool enable) noexcept {
+    if (m_shared_info && m_shared_info->set_blocking(enable)) {
+        m_blocking = enable;
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Swap this object's data members with \a fd
+ * 
+ * @param fd The basic_shared_fd to swap with
+ */
+void basic_shared_fd::swap(basic_shared_fd& fd) noexcept {
+    if (this != &fd) {
+        const bool my_blocking = m_blocking;
+        fd::shared_internal* my_shared_info = m_shared_info;
+
+        m_blocking = fd.m_blocking;
+        m_shared_info = fd.m_shared_info;
+
+        fd.m_shared_info = my_shared_info;
+        fd.m_blocking = my_blocking;
+    }
+}
+
+/**
+ * @brief Get the number of objects sharing ownership of the file descriptor
+ *
+ * @return The number of owners
+ */
+std::size_t basic_shared_fd::use_count() const noexcept {
+    if (!m_shared_info) return 0;
+
+    return m_shared_info->count();
+}
+
+/**
+ * @brief Release ownership of the currently held file descriptor
+ */
+void basic_shared_fd::drop_reference() {
+    if (m_shared_info) {
+        if (m_shared_info->release()) {
+            delete m_shared_info;
+        }
+
+        m_shared_info = nullptr;
+    }
+}
+
+}  // namespace jfern
@@ -0,0 +1,147 @@
+/**
+ *  \file   basic_unique_fd.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include "networking/basic_unique_fd.h"
+
+#include <utility>
+
+#include "networking/file_descriptor.h"
+
+namespace jfern {
+/**
+ * Default constructor
+ */
+basic_unique_fd::basic_unique_fd() : m_blocking(false), m_fd(-1) {
+}
+
+/**
+ * Constructor
+ *
+ * @param [in] fd A raw file descriptor
+ */
+basic_unique_fd::basic_unique_fd(int fd) : m_blocking(false), m_fd(fd) {
+}
+
+/**
+ * Move constructor
+ *
+ * @param[in] fd The file descriptor to take ownership of
+ */
+basic_unique_fd::basic_unique_fd(basic_unique_fd&& fd)
+    : m_blocking(false), m_fd(-1) {
+    *this = std::move(fd);
+}
+
+/**
+ * Destructor
+ */
+basic_unique_fd::~basic_unique_fd() {
+    if (*this) file_descriptor::close(m_fd);
+    m_fd = -1;
+}
+
+/**
+ * Move assignment operator
+ *
+ * @note This will also copy the blocking behavior of \a fd
+ *
+ * @param [in] fd  The file descriptor to take ownership of
+ *
+ * @return *this
+ */
+basic_unique_fd& basic_unique_fd::operator=(basic_unique_fd&& fd) {
+    if (this != &fd) {
+        m_blocking = fd.m_blocking;
+
+        m_fd = fd.m_fd; fd.m_fd = -1;
+    }
+
+    return *this;
+}
+
+/**
+ * @see See fd_interface::operator bool()
+ */
+basic_unique_fd::operator bool() const noexcept {
+    return 0 <= m_fd;
+}
+
+/**
+ * @see See fd_interface::get()
+ */
+int basic_unique_fd::get() const noexcept {
+    return m_fd;
+}
+
+/**
+ * @see See fd_interface::is_blocking()
+ */
+bool basic_unique_fd::is_blocking() const noexcept {
+    return m_blocking;
+}
+
+/**
+ * @see See fd_interface::poll()
+ */
+int basic_unique_fd::poll(short events) noexcept {
+    return file_descriptor::poll(m_fd, events, 0);
+}
+
+/**
+ * @see See fd_interface::poll()
+ */
+int basic_unique_fd::poll(short events, int timeout) noexcept {
+    return file_descriptor::poll(m_fd, events, timeout);
+}
+
+/**
+ * Release ownership of the file descriptor currently being managed. This will
+ * not modify its blocking behavior
+ *
+ * @return The file descriptor we were managing
+ */
+int basic_unique_fd::release() {
+    const int fd = m_fd; m_fd = -1;
+
+    return fd;
+}
+
+/**
+ * @see See fd_interface::reset()
+ */
+bool basic_unique_fd::reset(int fd) noexcept {
+    if (*this) file_descriptor::close(m_fd);
+    m_fd = fd;
+
+    return file_descriptor::set_blocking(m_fd, m_blocking);
+}
+
+/**
+ * @see See fd_interface::set_blocking()
+ */
+bool basic_unique_fd::set_blocking(bool enable) noexcept {
+    return file_descriptor::set_blocking(m_fd, enable);
+}
+
+/**
+ * Swap internal file descriptors with another \ref basic_unique_fd
+ *
+ * @param[in,out] fd The \ref basic_unique_fd to swap with
+ */
+void basic_unique_fd::swap(basic_unique_fd& fd) noexcept {
+    const int temp_fd = m_fd;
+    const bool temp_blocking = m_blocking;
+
+    m_blocking = fd.m_blocking;
+    m_fd = fd.m_fd;
+
+    fd.m_blocking = temp_blocking;
+    fd.m_fd = temp_fd;
+}
+
+}  // namespace jfern
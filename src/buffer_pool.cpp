@@ -0,0 +1,95 @@
+/**
+ *  \file   buffer_pool.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include "networking/buffer_pool.h"
+
+#include <new>
+
+namespace jfern {
+/**
+ * @brief Constructor
+ *
+ * @param block_size The size of each block, in bytes. Must be non-zero
+ */
+buffer_pool::buffer_pool(std::size_t block_size)
+    : m_block_size(block_size == 0 ? default_block_size : block_size),
+      m_free() {
+}
+
+/**
+ * @brief Destructor. Returns all free blocks to the heap
+ */
+buffer_pool::~buffer_pool() {
+    for (std::uint8_t* block : m_free) {
+        delete[] block;
+    }
+}
+
+/**
+ * @brief Take a block, allocating one if none are free
+ *
+ * @return The block, or nullptr if the heap is exhausted
+ */
+std::uint8_t* buffer_pool::allocate() noexcept {
+    if (m_free.empty()) {
+        return new (std::nothrow) std::uint8_t[m_block_size];
+    }
+
+    std::uint8_t* block = m_free.back();
+    m_free.pop_back();
+
+    return block;
+}
+
+/**
+ * @brief Get the number of free blocks
+ *
+ * @return The number of blocks which can be taken without allocating
+ */
+std::size_t buffer_pool::available() const noexcept {
+    return m_free.size();
+}
+
+/**
+ * @brief Get the size of each block
+ *
+ * @return The block size, in bytes
+ */
+std::size_t buffer_pool::block_size() const noexcept {
+    return m_block_size;
+}
+
+/**
+ * @brief Return a block for reuse
+ *
+ * @param block A block previously taken from *this. May be nullptr
+ */
+void buffer_pool::release(std::uint8_t* block) {
+    if (block) m_free.push_back(block);
+}
+
+/**
+ * @brief Pre-allocate blocks
+ *
+ * @param n Ensure at least this many blocks are free
+ *
+ * @return The number of free blocks, which is less than \a n only if the heap
+ *         was exhausted
+ */
+std::size_t buffer_pool::reserve(std::size_t n) {
+    while (m_free.size() < n) {
+        std::uint8_t* block = new (std::nothrow) std::uint8_t[m_block_size];
+        if (!block) break;
+
+        m_free.push_back(block);
+    }
+
+    return m_free.size();
+}
+
+}  // namespace jfern
@@ -0,0 +1,287 @@
+/**
+ *  \file   chain_buffer.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include "networking/chain_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace jfern {
+/**
+ * @brief Constructor
+ *
+ * @param pool The pool to draw blocks from. Must outlive *this
+ */
+chain_buffer::chain_buffer(buffer_pool& pool)
+    : m_blocks(), m_offset(0), m_pool(&pool), m_size(0) {
+}
+
+/**
+ * @brief Move constructor
+ *
+ * @param buffer The chain_buffer whose blocks will be handed to *this. It is
+ *               left empty
+ */
+chain_buffer::chain_buffer(chain_buffer&& buffer)
+    : m_blocks(std::move(buffer.m_blocks)),
+      m_offset(buffer.m_offset),
+      m_pool(buffer.m_pool),
+      m_size(buffer.m_size) {
+    buffer.m_blocks.clear();
+    buffer.m_offset = buffer.m_size = 0;
+}
+
+/**
+ * @brief Move assignment operator
+ *
+ * @param buffer The chain_buffer whose blocks will be handed to *this. It is
+ *               left empty
+ *
+ * @return *this
+ */
+chain_buffer& chain_buffer::operator=(chain_buffer&& buffer) {
+    if (this != &buffer) {
+        release_blocks();
+
+        m_blocks = std::move(buffer.m_blocks);
+        m_offset = buffer.m_offset;
+        m_pool   = buffer.m_pool;
+        m_size   = buffer.m_size;
+
+        buffer.m_blocks.clear();
+        buffer.m_offset = buffer.m_size = 0;
+    }
+
+    return *this;
+}
+
+/**
+ * @brief Destructor. Returns all blocks to the pool
+ */
+chain_buffer::~chain_buffer() {
+    release_blocks();
+}
+
+/**
+ * @brief Get the number of bytes which can be written without growing
+ *
+ * @return The total size of all blocks, in bytes
+ */
+std::size_t chain_buffer::capacity() const noexcept {
+    return m_blocks.size() * m_pool->block_size();
+}
+
+/**
+ * @brief Discard the contents and return all blocks to the pool
+ */
+void chain_buffer::clear() {
+    release_blocks();
+    m_offset = m_size = 0;
+}
+
+/**
+ * @brief Read from the buffer and advance the buffer pointer by the number
+ *        of bytes read
+ *
+ * @param data   The buffer to read into
+ * @param nbytes The number of bytes to read
+ *
+ * @return True on success, or false if reading would pass the last byte
+ *         written
+ */
+bool chain_buffer::read(std::uint8_t* data, std::size_t nbytes) noexcept {
+    if (m_offset + nbytes > m_size) return false;
+
+    copy_out(data, nbytes);
+    return true;
+}
+
+/**
+ * @brief Ensure room for writing at the current offset without growing
+ *
+ * @param nbytes The number of bytes to make room for
+ *
+ * @return True on success, or false if a block could not be allocated. The
+ *         blocks which could be allocated are kept
+ */
+bool chain_buffer::reserve(std::size_t nbytes) {
+    const std::size_t wanted = m_offset + nbytes;
+    if (capacity() >= wanted) return true;
+
+    // Grow the block list up front, so that push_back() below cannot throw
+    // and leak a block taken from the pool
+    const std::size_t block_size = m_pool->block_size();
+    m_blocks.reserve((wanted + block_size - 1) / block_size);
+
+    while (capacity() < wanted) {
+        std::uint8_t* block = m_pool->allocate();
+        if (!block) return false;
+
+        m_blocks.push_back(block);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Reset the current buffer pointer to point to the start of the buffer
+ */
+void chain_buffer::rewind() noexcept {
+    m_offset = 0;
+}
+
+/**
+ * @brief Set the current buffer pointer to point to an offset from the current
+ *        location
+ *
+ * @param delta The number of bytes relative to the current buffer offset. Can
+ *              be negative
+ *
+ * @note If this method fails, the state of this object remains unchanged
+ *
+ * @return True if the desired location is within the bytes written
+ */
+bool chain_buffer::seek(long int delta) noexcept {
+    if (delta < 0) {
+        const auto udelta = static_cast<std::size_t>(-delta);
+        if (udelta > m_offset) return false;
+    } else {
+        const auto udelta = static_cast<std::size_t>( delta);
+        if (m_offset + udelta > m_size) return false;
+    }
+
+    m_offset += delta;
+    return true;
+}
+
+/**
+ * @brief Set the current buffer pointer to point to an offset from the start
+ *        of the buffer
+ *
+ * @param new_offset The number of bytes from the buffer start
+ *
+ * @note If this method fails, the state of this object remains unchanged
+ *
+ * @return True if the desired location is within the bytes written
+ */
+bool chain_buffer::seek_absolute(std::size_t new_offset) noexcept {
+    if (new_offset > m_size) return false;
+
+    m_offset = new_offset;
+    return true;
+}
+
+/**
+ * @brief Get the number of blocks holding the bytes written
+ *
+ * @return The number of segments append_to() would add
+ */
+std::size_t chain_buffer::segments() const noexcept {
+    const std::size_t block_size = m_pool->block_size();
+    return (m_size + block_size - 1) / block_size;
+}
+
+/**
+ * @brief Get the number of bytes written
+ *
+ * @return One past the furthest offset written, in bytes
+ */
+std::size_t chain_buffer::size() const noexcept {
+    return m_size;
+}
+
+/**
+ * @brief Get the current position of the buffer pointer as an offset from the
+ *        start of the buffer
+ *
+ * @return The current buffer offset, in bytes
+ */
+std::size_t chain_buffer::tell() const noexcept {
+    return m_offset;
+}
+
+/**
+ * @brief Write to the buffer and advance the buffer pointer by the number of
+ *        bytes written, growing the buffer as needed
+ *
+ * @param data   The bytes to write
+ * @param nbytes The number of bytes to write
+ *
+ * @note If this method fails, the contents and offset remain unchanged
+ *
+ * @return True on success, or false if a block could not be allocated
+ */
+bool chain_buffer::write(const std::uint8_t* data, std::size_t nbytes) {
+    if (!reserve(nbytes)) return false;
+
+    copy_in(data, nbytes);
+
+    m_size = std::max(m_size, m_offset);
+    return true;
+}
+
+/**
+ * @brief Copy bytes in at the current offset, advancing it. There must be
+ *        sufficient capacity
+ *
+ * @param data   The bytes to copy
+ * @param nbytes The number of bytes to copy
+ */
+void chain_buffer::copy_in(const std::uint8_t* data,
+                           std::size_t nbytes) noexcept {
+    const std::size_t block_size = m_pool->block_size();
+
+    while (nbytes > 0) {
+        const std::size_t index  = m_offset / block_size;
+        const std::size_t offset = m_offset % block_size;
+        const std::size_t n = std::min(nbytes, block_size - offset);
+
+        std::memcpy(m_blocks[index] + offset, data, n);
+
+        data     += n;
+        nbytes   -= n;
+        m_offset += n;
+    }
+}
+
+/**
+ * @brief Copy bytes out from the current offset, advancing it. The bytes must
+ *        have been written
+ *
+ * @param data   The buffer to copy into
+ * @param nbytes The number of bytes to copy
+ */
+void chain_buffer::copy_out(std::uint8_t* data, std::size_t nbytes) noexcept {
+    const std::size_t block_size = m_pool->block_size();
+
+    while (nbytes > 0) {
+        const std::size_t index  = m_offset / block_size;
+        const std::size_t offset = m_offset % block_size;
+        const std::size_t n = std::min(nbytes, block_size - offset);
+
+        std::memcpy(data, m_blocks[index] + offset, n);
+
+        data     += n;
+        nbytes   -= n;
+        m_offset += n;
+    }
+}
+
+/**
+ * @brief Return all blocks to the pool
+ */
+void chain_buffer::release_blocks() {
+    for (std::uint8_t* block : m_blocks) {
+        m_pool->release(block);
+    }
+
+    m_blocks.clear();
+}
+
+}  // namespace jfern
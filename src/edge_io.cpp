@@ -0,0 +1,198 @@
+/**
+ *  \file   edge_io.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include "networking/edge_io.h"
+
+#include <poll.h>
+
+#include <algorithm>
+#include <cerrno>
+
+#include "networking/posix_api.h"
+
+namespace jfern {
+/**
+ * @brief Constructor
+ *
+ * @param fd     The (non-blocking) file descriptor to operate on
+ * @param budget The maximum number of bytes to transfer before yielding to
+ *               other file descriptors
+ */
+edge_io::edge_io(fd_interface& fd, std::size_t budget) noexcept
+    : m_budget(budget),
+      m_eof(false),
+      m_fd(fd),
+      m_pending(0),
+      m_read_blocked(false),
+      m_write_blocked(false) {
+}
+
+/**
+ * @brief Check if the peer has closed its end
+ *
+ * @return True if a read returned end-of-file
+ */
+bool edge_io::eof() const noexcept {
+    return m_eof;
+}
+
+/**
+ * @brief Check if the byte budget for this wakeup has been used up
+ *
+ * @return True if no more bytes may be transferred
+ */
+bool edge_io::exhausted() const noexcept {
+    return m_budget == 0;
+}
+
+/**
+ * @brief Get the underlying file descriptor
+ *
+ * @return The file descriptor being drained
+ */
+fd_interface& edge_io::fd() noexcept {
+    return m_fd;
+}
+
+/**
+ * @brief Get the events left undrained
+ *
+ * @return POLLIN if data may remain to be read, and/or POLLOUT if data was
+ *         left unwritten, in either case without the descriptor having
+ *         reported EAGAIN
+ */
+short edge_io::pending() const noexcept {
+    return m_pending;
+}
+
+/**
+ * @brief Read until \a buf is full, the descriptor would block, end-of-file
+ *        is reached, or the budget is exhausted
+ *
+ * @param buf    The buffer to place data into
+ * @param nbytes The maximum number of bytes to read
+ *
+ * @note A read of zero bytes returns at once and leaves pending() unchanged
+ *
+ * @return The number of bytes read. If an error occurs before anything is
+ *         read, returns -1 and sets errno
+ */
+ssize_t edge_io::read(std::uint8_t* buf, std::size_t nbytes) noexcept {
+    // Nothing was asked for, so nothing is left undrained on our account
+    if (nbytes == 0) return 0;
+
+    std::size_t total = 0;
+
+    m_read_blocked = false;
+    m_pending |= POLLIN;
+
+    while (total < nbytes && m_budget > 0) {
+        const std::size_t chunk = std::min(nbytes - total, m_budget);
+
+        const ssize_t n = posix_read(m_fd.get(), buf + total, chunk);
+        if (n > 0) {
+            total    += static_cast<std::size_t>(n);
+            m_budget -= static_cast<std::size_t>(n);
+            continue;
+        }
+
+        if (n < 0 && errno == EINTR) continue;
+
+        m_pending &= ~POLLIN;
+
+        if (n == 0) {
+            m_eof = true;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            m_read_blocked = true;
+        } else if (total == 0) {
+            return -1;
+        }
+
+        break;
+    }
+
+    return static_cast<ssize_t>(total);
+}
+
+/**
+ * @brief Check if the last read drained the descriptor
+ *
+ * @return True if the last read stopped because it would block
+ */
+bool edge_io::read_blocked() const noexcept {
+    return m_read_blocked;
+}
+
+/**
+ * @brief Get the unused portion of the budget
+ *
+ * @return The number of bytes which may still be transferred
+ */
+std::size_t edge_io::remaining() const noexcept {
+    return m_budget;
+}
+
+/**
+ * @brief Write until all of \a buf is written, the descriptor would block, or
+ *        the budget is exhausted
+ *
+ * @param buf    The data to write
+ * @param nbytes The number of bytes to write
+ *
+ * @note A write of zero bytes returns at once and leaves pending() unchanged
+ *
+ * @return The number of bytes written. If an error occurs before anything is
+ *         written, returns -1 and sets errno
+ */
+ssize_t edge_io::write(const std::uint8_t* buf, std::size_t nbytes) noexcept {
+    if (nbytes == 0) return 0;
+
+    std::size_t total = 0;
+
+    m_write_blocked = false;
+    m_pending &= ~POLLOUT;
+
+    while (total < nbytes) {
+        if (m_budget == 0) {
+            m_pending |= POLLOUT;
+            break;
+        }
+
+        const std::size_t chunk = std::min(nbytes - total, m_budget);
+
+        const ssize_t n = posix_write(m_fd.get(), buf + total, chunk);
+        if (n >= 0) {
+            total    += static_cast<std::size_t>(n);
+            m_budget -= static_cast<std::size_t>(n);
+            continue;
+        }
+
+        if (errno == EINTR) continue;
+
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            m_write_blocked = true;
+        } else if (total == 0) {
+            return -1;
+        }
+
+        break;
+    }
+
+    return static_cast<ssize_t>(total);
+}
+
+/**
+ * @brief Check if the last write filled the descriptor's buffer
+ *
+ * @return True if the last write stopped because it would block
+ */
+bool edge_io::write_blocked() const noexcept {
+    return m_write_blocked;
+}
+
+}  // namespace jfern
@@ -0,0 +1,397 @@
+/**
+ *  \file   event_loop_pool.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include "networking/event_loop_pool.h"
+
+#include <poll.h>
+
+#include <cstdint>
+#include <utility>
+
+#include "networking/posix_api.h"
+#include "networking/unique_fd.h"
+
+namespace jfern {
+namespace {
+/**
+ * The pool whose loop is running on this thread, if any
+ */
+thread_local const event_loop_pool* t_pool = nullptr;
+
+/**
+ * The index of the loop running on this thread
+ */
+thread_local std::size_t t_index = 0;
+
+/**
+ * The reactor of the loop running on this thread
+ */
+thread_local reactor* t_reactor = nullptr;
+
+}  // namespace
+
+/**
+ * @brief Constructor
+ */
+event_loop_pool::loop::loop()
+    : inbox_mutex(),
+      inbox(),
+      load(0),
+      sleeping(false),
+      task_mutex(),
+      tasks(),
+      thread(),
+      wakeup(),
+      events() {
+}
+
+/**
+ * @brief Constructor. Starts the loops
+ *
+ * @param n_loops The number of loops (and threads) to run. At least one is
+ *                always created
+ */
+event_loop_pool::event_loop_pool(std::size_t n_loops)
+    : m_loops(),
+      m_owners_mutex(),
+      m_owners(),
+      m_queued(0),
+      m_next(0),
+      m_stopping(false),
+      m_valid(true) {
+    if (n_loops == 0) n_loops = 1;
+
+    for (std::size_t i = 0; i < n_loops; i++) {
+        auto target = std::make_unique<loop>();
+
+        const int fd = posix_eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+        if (fd < 0) {
+            m_valid = false;
+            m_loops.push_back(std::move(target));
+            continue;
+        }
+
+        target->wakeup = std::make_shared<fd_event_sink>(
+            std::make_unique<unique_fd>(fd));
+
+        target->wakeup->add_events(POLLIN, [](short, fd_interface& efd) {
+            std::uint64_t count;
+            posix_read(efd.get(), reinterpret_cast<std::uint8_t*>(&count),
+                       sizeof(count));
+        });
+
+        if (!target->events || !target->events.add(target->wakeup)) {
+            m_valid = false;
+        }
+
+        m_loops.push_back(std::move(target));
+    }
+
+    if (!m_valid) return;
+
+    for (std::size_t i = 0; i < m_loops.size(); i++) {
+        m_loops[i]->thread = std::thread(&event_loop_pool::run, this, i);
+    }
+}
+
+/**
+ * @brief Destructor. Stops the loops and waits for their threads to exit
+ */
+event_loop_pool::~event_loop_pool() {
+    m_stopping.store(true);
+
+    for (auto& target : m_loops) {
+        if (target->thread.joinable()) {
+            wake(*target);
+            target->thread.join();
+        }
+    }
+}
+
+/**
+ * @brief Boolean type conversion operator
+ *
+ * @return True if every loop was started successfully
+ */
+event_loop_pool::operator bool() const noexcept {
+    return m_valid;
+}
+
+/**
+ * @brief Register an event sink with the least loaded loop
+ *
+ * @param sink The sink to register. Its handlers run on the chosen loop's
+ *             thread from then on
+ *
+ * @note Registration completes asynchronously unless called from the chosen
+ *       loop. If it then fails, the sink is silently dropped
+ *
+ * @return The index of the loop the sink was assigned to, or -1 if \a sink
+ *         is invalid or its file descriptor is already registered
+ */
+int event_loop_pool::add(std::shared_ptr<fd_event_sink> sink) {
+    if (!m_valid || !sink || sink->get() < 0) return -1;
+
+    const int fd = sink->get();
+
+    std::size_t index = 0;
+    for (std::size_t i = 1; i < m_loops.size(); i++) {
+        if (m_loops[i]->load.load() < m_loops[index]->load.load())
+            index = i;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_owners_mutex);
+        if (!m_owners.emplace(fd, index).second) return -1;
+    }
+
+    m_loops[index]->load++;
+
+    auto attach = [this, index, fd, sink = std::move(sink)]() {
+        if (!m_loops[index]->events.add(sink)) {
+            std::lock_guard<std::mutex> lock(m_owners_mutex);
+
+            auto iter = m_owners.find(fd);
+            if (iter != m_owners.end() && iter->second == index) {
+                m_owners.erase(iter);
+                m_loops[index]->load--;
+            }
+        }
+    };
+
+    if (t_pool == this && t_index == index) {
+        attach();
+    } else {
+        post(index, std::move(attach));
+    }
+
+    return static_cast<int>(index);
+}
+
+/**
+ * @brief Get the number of sinks assigned to a loop
+ *
+ * @param index The loop
+ *
+ * @return The number of sinks, or 0 if \a index is out of range
+ */
+std::size_t event_loop_pool::load(std::size_t index) const noexcept {
+    return index < m_loops.size() ? m_loops[index]->load.load() : 0;
+}
+
+/**
+ * @brief Run a task on a particular loop, e.g. to act on one of its sinks
+ *
+ * @param index The loop
+ * @param task  The task, which runs on the loop's thread before its next
+ *              poll. Tasks posted to the same loop run in order
+ *
+ * @return True on success, or false if \a index is out of range or \a task
+ *         is empty
+ */
+bool event_loop_pool::post(std::size_t index, std::function<void()> task) {
+    if (!m_valid || index >= m_loops.size() || !task) return false;
+
+    loop& target = *m_loops[index];
+
+    {
+        std::lock_guard<std::mutex> lock(target.inbox_mutex);
+        target.inbox.push_back(std::move(task));
+    }
+
+    wake(target);
+    return true;
+}
+
+/**
+ * @brief Unregister a file descriptor
+ *
+ * @param fd The file descriptor whose sink to unregister
+ *
+ * @note Unless called from the loop the sink is assigned to, removal
+ *       completes asynchronously, and its handlers may run in the meantime
+ *
+ * @return True if \a fd was registered
+ */
+bool event_loop_pool::remove(int fd) {
+    std::size_t index;
+
+    {
+        std::lock_guard<std::mutex> lock(m_owners_mutex);
+
+        auto iter = m_owners.find(fd);
+        if (iter == m_owners.end()) return false;
+
+        index = iter->second;
+        m_owners.erase(iter);
+    }
+
+    m_loops[index]->load--;
+
+    auto detach = [this, index, fd]() {
+        m_loops[index]->events.remove(fd);
+    };
+
+    if (t_pool == this && t_index == index) {
+        detach();
+    } else {
+        post(index, std::move(detach));
+    }
+
+    return true;
+}
+
+/**
+ * @brief Get the number of loops
+ *
+ * @return The number of loops, each with its own thread
+ */
+std::size_t event_loop_pool::size() const noexcept {
+    return m_loops.size();
+}
+
+/**
+ * @brief Queue a continuation, e.g. CPU-heavy work which a handler should
+ *        not do inline
+ *
+ * @param task The continuation. If spawned from a loop, it is queued there,
+ *             otherwise it is queued round-robin. Any idle loop may steal it
+ *
+ * @return True on success, or false if the pool is invalid or \a task is
+ *         empty
+ */
+bool event_loop_pool::spawn(std::function<void()> task) {
+    if (!m_valid || !task) return false;
+
+    const std::size_t index = t_pool == this ?
+        t_index : m_next.fetch_add(1) % m_loops.size();
+
+    // Count the task first, so the count never drops below zero
+    m_queued.fetch_add(1);
+
+    {
+        std::lock_guard<std::mutex> lock(m_loops[index]->task_mutex);
+        m_loops[index]->tasks.push_back(std::move(task));
+    }
+
+    // Loops only block if no continuations are queued. Wake one that may
+    // have blocked before the one above was counted
+    for (std::size_t i = 0; i < m_loops.size(); i++) {
+        loop& target = *m_loops[(index + i) % m_loops.size()];
+
+        if (target.sleeping.exchange(false)) {
+            wake(target);
+            break;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Get the reactor of the loop running on the calling thread
+ *
+ * @return The reactor, or null if not called from a loop
+ */
+reactor* event_loop_pool::this_loop() noexcept {
+    return t_reactor;
+}
+
+/**
+ * @brief Run a loop until the pool is destroyed
+ *
+ * @param index The loop to run
+ */
+void event_loop_pool::run(std::size_t index) {
+    loop& self = *m_loops[index];
+
+    t_pool    = this;
+    t_index   = index;
+    t_reactor = &self.events;
+
+    std::vector<std::function<void()>> inbox;
+
+    while (!m_stopping.load()) {
+        {
+            std::lock_guard<std::mutex> lock(self.inbox_mutex);
+            inbox.swap(self.inbox);
+        }
+
+        for (auto& task : inbox) task();
+        inbox.clear();
+
+        // Block only if there are no continuations to run. See spawn()
+        self.sleeping.store(true);
+
+        const int timeout = m_queued.load() == 0 ? -1 : 0;
+
+        self.events.run_once(timeout);
+        self.sleeping.store(false);
+
+        run_task(index);
+    }
+
+    t_pool    = nullptr;
+    t_reactor = nullptr;
+}
+
+/**
+ * @brief Run one continuation, preferably one spawned on a given loop,
+ *        otherwise one stolen from another
+ *
+ * @param index The loop to run the continuation on
+ *
+ * @return True if a continuation was run
+ */
+bool event_loop_pool::run_task(std::size_t index) {
+    std::function<void()> task;
+
+    {
+        loop& self = *m_loops[index];
+        std::lock_guard<std::mutex> lock(self.task_mutex);
+
+        // Newest first, since its data is most likely still cached
+        if (!self.tasks.empty()) {
+            task = std::move(self.tasks.back());
+            self.tasks.pop_back();
+        }
+    }
+
+    for (std::size_t i = 1; !task && i < m_loops.size(); i++) {
+        loop& victim = *m_loops[(index + i) % m_loops.size()];
+        std::lock_guard<std::mutex> lock(victim.task_mutex);
+
+        // Oldest first, since it has waited longest
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+        }
+    }
+
+    if (!task) return false;
+
+    m_queued.fetch_sub(1);
+    task();
+
+    return true;
+}
+
+/**
+ * @brief Wake a loop blocked waiting for events
+ *
+ * @param target The loop to wake
+ */
+void event_loop_pool::wake(loop& target) {
+    const std::uint64_t one = 1;
+
+    posix_write(target.wakeup->get(),
+                reinterpret_cast<const std::uint8_t*>(&one), sizeof(one));
+}
+
+}  // namespace jfern
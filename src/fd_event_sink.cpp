@@ -8,7 +8,6 @@
 
 #include "networking/fd_event_sink.h"
 
-#include <algorithm>
 #include <utility>
 
 namespace jfern {
@@ -18,7 +17,50 @@ namespace jfern {
  * @param fd The file descriptor to acquire ownership of
  */
 fd_event_sink::fd_event_sink(std::unique_ptr<fd_interface> fd)
-    : m_events(), m_fd(std::move(fd)) {
+    : m_budget(default_budget),
+      m_edge_slots(0),
+      m_free_slots((1u << max_slots) - 1),
+      m_handlers(),
+      m_mask(0),
+      m_owners(),
+      m_retired(false),
+      m_running(npos),
+      m_targets(0),
+      m_fd(std::move(fd)) {
+}
+
+/**
+ * @brief Add edge-triggered events of interest for this file descriptor
+ *
+ * @param events  Bitmask of events to handle
+ * @param handler Called back in reponse to any events specified in \a events
+ *                with an edge_io which drains the file descriptor
+ *
+ * @note If any event in \a events already has an associated handler, the
+ *       handler for that event will be replaced by \a handler
+ *
+ * @return True on success, or false if a level-triggered handler would
+ *         remain for events outside \a events
+ */
+bool fd_event_sink::add_edge_events(short events, edge_handler_t handler) {
+    if (events == 0 || !handler)
+        return false;
+
+    const auto mask = static_cast<std::uint16_t>(events);
+
+    if (mixes_modes(mask, true))
+        return false;
+
+    detach_events(mask);
+
+    const std::size_t index = allocate_slot();
+
+    m_handlers[index].edge_handler = std::move(handler);
+    m_edge_slots |= 1u << index;
+
+    attach_events(mask, index);
+
+    return true;
 }
 
 /**
@@ -30,43 +72,123 @@ fd_event_sink::fd_event_sink(std::unique_ptr<fd_interface> fd)
  * @note If any event in \a events already has an associated handler, the
  *       handler for that event will be replaced by \a handler
  *
- * @return True on success
+ * @return True on success, or false if an edge-triggered handler would
+ *         remain for events outside \a events
  */
 bool fd_event_sink::add_events(short events,
                                fd_interface::event_handler_t handler) {
     if (events == 0 || !handler)
         return false;
 
-    for (auto& event : m_events) {
-        const short common_events = event.mask & events;
+    const auto mask = static_cast<std::uint16_t>(events);
 
-        event.mask ^= common_events;
-    }
+    if (mixes_modes(mask, false))
+        return false;
+
+    detach_events(mask);
 
-    erase_null_events();
+    const std::size_t index = allocate_slot();
 
-    m_events.emplace_back(events, handler);
+    m_handlers[index].handler = std::move(handler);
+
+    attach_events(mask, index);
 
     return true;
 }
 
+/**
+ * @brief Get the number of bytes edge-triggered handlers may transfer per
+ *        wakeup
+ *
+ * @return The budget, in bytes
+ */
+std::size_t fd_event_sink::budget() const noexcept {
+    return m_budget;
+}
+
 /**
  * @brief Clear all events/event handlers for this file descriptor
  */
 void fd_event_sink::clear_events() {
-    m_events.clear();
+    detach_events(0xffff);
+}
+
+/**
+ * @brief Check whether this file descriptor should be edge-triggered
+ *
+ * @return True if any event has an edge-triggered handler
+ */
+bool fd_event_sink::edge_triggered() const noexcept {
+    return m_edge_slots != 0;
+}
+
+/**
+ * @brief Get the events of interest for this file descriptor
+ *
+ * @return Bitmask of all events which currently have a handler
+ */
+short fd_event_sink::events() const noexcept {
+    return static_cast<short>(m_mask);
+}
+
+/**
+ * @brief Get the underlying file descriptor
+ *
+ * @return The file descriptor, or -1 if not assigned
+ */
+int fd_event_sink::get() const noexcept {
+    return m_fd ? m_fd->get() : -1;
 }
 
 /**
  * @brief Handle file desciptor events
  *
  * @param events Bitmask specifying which events occurred
+ *
+ * @return Bitmask of events (POLLIN and/or POLLOUT) which edge-triggered
+ *         handlers left undrained, e.g. because the budget ran out. These
+ *         should be dispatched again since no new edge will be reported
  */
-void fd_event_sink::handle_events(short events) {
-    std::for_each(m_events.begin(), m_events.end(),
-        [&](const callback_info& event) {
-            if (event.mask & events) event.handler(events, *m_fd);
-        });
+short fd_event_sink::handle_events(short events) {
+    const auto mask = static_cast<std::uint16_t>(events);
+
+    // Collect the owners of the events that occurred, so that each handler
+    // runs once however many of its events occurred
+    std::uint32_t targets = 0;
+    for (std::uint32_t bits = m_mask & mask; bits != 0; bits &= bits - 1) {
+        targets |= 1u << m_owners[__builtin_ctz(bits)];
+    }
+
+    edge_io io(*m_fd, m_budget);
+
+    // Handlers may add and remove handlers, which updates the targets left
+    m_targets = targets;
+
+    while (m_targets != 0) {
+        const std::size_t index = __builtin_ctz(m_targets);
+        m_targets &= m_targets - 1;
+
+        const callback_info& event = m_handlers[index];
+        if ((event.mask & mask) == 0) continue;
+
+        m_running = index;
+
+        if (event.edge_handler) {
+            event.edge_handler(events, io);
+        } else {
+            event.handler(events, *m_fd);
+        }
+
+        m_running = npos;
+
+        // The handler removed itself; destroy it now that it has returned
+        if (m_retired) {
+            m_retired = false;
+            release_slot(index);
+        }
+    }
+
+    return io.pending();
 }
 
 /**
@@ -77,22 +199,116 @@ void fd_event_sink::handle_events(short events) {
  * @note No-op if no events in \a events were previously added 
  */
 void fd_event_sink::remove_events(short events) {
-    for (auto& event : m_events) {
-        const short to_remove = event.mask & events;
+    detach_events(static_cast<std::uint16_t>(events));
+}
+
+/**
+ * @brief Set the number of bytes edge-triggered handlers may transfer per
+ *        wakeup before yielding to other file descriptors
+ *
+ * @param nbytes The budget, in bytes
+ */
+void fd_event_sink::set_budget(std::size_t nbytes) noexcept {
+    m_budget = nbytes;
+}
+
+/**
+ * @brief Assign events to a handler
+ *
+ * @param events Bitmask of events, none of which may have a handler
+ * @param index  The slot holding the handler
+ */
+void fd_event_sink::attach_events(std::uint16_t events, std::size_t index) {
+    m_handlers[index].mask = events;
+
+    for (std::uint32_t bits = events; bits != 0; bits &= bits - 1) {
+        m_owners[__builtin_ctz(bits)] = static_cast<std::uint8_t>(index);
+    }
+
+    m_mask |= events;
+}
 
-        event.mask ^= to_remove;
+/**
+ * @brief Detach events from whichever handlers currently respond to them,
+ *        freeing the slots of handlers left with no events
+ *
+ * @param events Bitmask of events to detach
+ */
+void fd_event_sink::detach_events(std::uint16_t events) {
+    for (std::uint32_t bits = m_mask & events; bits != 0; bits &= bits - 1) {
+        const unsigned int bit = __builtin_ctz(bits);
+        const std::size_t index = m_owners[bit];
+
+        callback_info& event = m_handlers[index];
+        event.mask &= ~(1u << bit);
+
+        if (event.mask == 0) {
+            m_edge_slots &= ~(1u << index);
+
+            // Skip it if it has yet to be dispatched, and keep it alive
+            // if it is running
+            m_targets &= ~(1u << index);
+
+            if (index == m_running) {
+                m_retired = true;
+            } else {
+                release_slot(index);
+            }
+        }
     }
 
-    erase_null_events();
+    m_mask &= ~events;
 }
 
 /**
- * @brief Clean up events whose bitmask is zero
+ * @brief Check whether adding a handler would leave the sink with both
+ *        level- and edge-triggered handlers. A descriptor is registered in
+ *        a single mode, so a level-triggered handler on an edge-triggered
+ *        descriptor would miss wakeups
+ *
+ * @param events Bitmask of events the new handler takes over
+ * @param edge   True if the new handler is edge-triggered
+ *
+ * @return True if a handler of the other mode keeps any event outside
+ *         \a events
  */
-void fd_event_sink::erase_null_events() {
-    for (auto iter = m_events.begin(), end = m_events.end(); iter != end; ) {
-        iter = iter->mask == 0 ? m_events.erase(iter) : iter + 1;
+bool fd_event_sink::mixes_modes(std::uint16_t events, bool edge) const {
+    for (std::uint32_t bits = m_mask & ~events; bits != 0; bits &= bits - 1) {
+        const std::size_t index = m_owners[__builtin_ctz(bits)];
+
+        if (((m_edge_slots >> index) & 1u) != (edge ? 1u : 0u))
+            return true;
     }
+
+    return false;
+}
+
+/**
+ * @brief Get a free handler slot
+ *
+ * @details Every handler owns at least one event bit, and at most one more
+ *          slot is held by a running handler which removed itself, so a
+ *          slot is always free
+ *
+ * @return The index of the slot
+ */
+std::size_t fd_event_sink::allocate_slot() {
+    const std::size_t index = __builtin_ctz(m_free_slots);
+    m_free_slots &= m_free_slots - 1;
+
+    return index;
+}
+
+/**
+ * @brief Destroy the handler in a slot and mark the slot free
+ *
+ * @param index The slot, which must own no events
+ */
+void fd_event_sink::release_slot(std::size_t index) {
+    m_handlers[index].edge_handler = nullptr;
+    m_handlers[index].handler      = nullptr;
+
+    m_free_slots |= 1u << index;
 }
 
 }  // namespace jfern
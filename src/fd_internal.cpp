@@ -8,17 +8,304 @@
 
 #include "networking/fd_internal.h"
 
+#include <fcntl.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <mutex>
+#include <new>
+
 #include "networking/file_descriptor.h"
+#include "networking/posix_api.h"
 
 namespace jfern {
 namespace fd {
+namespace {
+/**
+ * Extract the file status flags from a packed status word
+ */
+int status_flags(std::uint64_t status) {
+    return static_cast<int>(status & 0xffffffffu);
+}
+
+/**
+ * Extract the generation from a packed status word
+ */
+std::uint32_t status_generation(std::uint64_t status) {
+    return static_cast<std::uint32_t>(status >> 32);
+}
+
+/**
+ * Pack file status flags and a generation into a status word
+ */
+std::uint64_t make_status(std::uint32_t generation, int flags) {
+    return (static_cast<std::uint64_t>(generation) << 32)
+            | static_cast<std::uint32_t>(flags);
+}
+
+/**
+ * A free pool block, linked through its own storage
+ */
+struct free_block {
+    free_block* next;
+};
+
+/**
+ * The size of each pool block, large enough for either a control block or
+ * a free list link and suitably aligned for both
+ */
+constexpr std::size_t block_size =
+    (std::max(sizeof(shared_internal), sizeof(free_block))
+        + alignof(shared_internal) - 1) & ~(alignof(shared_internal) - 1);
+
+/**
+ * The number of blocks obtained from the heap whenever the pool runs dry
+ */
+constexpr std::size_t slab_blocks = 256;
+
+/**
+ * The number of blocks moved between a thread cache and the shared free list
+ * at a time
+ */
+constexpr std::size_t transfer_blocks = 64;
+
+/**
+ * The most free blocks a thread may cache before returning a batch
+ */
+constexpr std::size_t cache_capacity = 2 * transfer_blocks;
+
+/**
+ * The free list shared by all threads. Slabs are never returned to the heap
+ */
+class central_pool final {
+public:
+    /**
+     * Take up to \a n blocks, growing the pool if it is empty
+     *
+     * @param[in]  n     The number of blocks wanted
+     * @param[out] taken The number of blocks actually taken (at least one)
+     *
+     * @return The first block in the chain taken
+     */
+    free_block* take(std::size_t n, std::size_t* taken) {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_size == 0) grow(std::max(n, slab_blocks));
+
+        free_block* head = m_head;
+        free_block* tail = head;
+
+        std::size_t count = 1;
+        for (; count < n && tail->next; count++) tail = tail->next;
+
+        m_head = tail->next;
+        m_size -= count;
+
+        tail->next = nullptr;
+        *taken = count;
+
+        return head;
+    }
+
+    /**
+     * Return a chain of blocks
+     *
+     * @param[in] head The first block in the chain
+     * @param[in] tail The last block in the chain
+     * @param[in] n    The number of blocks in the chain
+     */
+    void give(free_block* head, free_block* tail, std::size_t n) {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+
+        tail->next = m_head;
+        m_head = head;
+        m_size += n;
+    }
+
+    /**
+     * Ensure at least \a n blocks are on the free list
+     *
+     * @param[in] n The number of blocks wanted
+     *
+     * @return The number of blocks on the free list
+     */
+    std::size_t reserve(std::size_t n) {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_size < n) grow(n - m_size);
+
+        return m_size;
+    }
+
+private:
+    /**
+     * Allocate a slab of \a n blocks and put them on the free list. Must be
+     * called with the mutex held
+     */
+    void grow(std::size_t n) {
+        auto slab = static_cast<unsigned char*>(::operator new(
+            n * block_size, std::align_val_t(alignof(shared_internal))));
+
+        for (std::size_t i = n; i > 0; i--) {
+            auto block = reinterpret_cast<free_block*>(
+                slab + (i - 1) * block_size);
+
+            block->next = m_head;
+            m_head = block;
+        }
+
+        m_size += n;
+    }
+
+    /** The first free block */
+    free_block* m_head = nullptr;
+
+    /** Protects the free list */
+    std::mutex m_mutex;
+
+    /** The number of free blocks */
+    std::size_t m_size = 0;
+};
+
+/**
+ * Get the shared free list. It is intentionally never destroyed, since
+ * control blocks may be released by static destructors in any order
+ */
+central_pool& central() {
+    static central_pool* const pool = new central_pool();
+    return *pool;
+}
+
+/**
+ * Set once the calling thread's cache has been torn down, after which its
+ * blocks go straight to the shared free list
+ */
+thread_local bool t_cache_destroyed = false;
+
+/**
+ * Free blocks private to a thread, handed back when the thread exits
+ */
+struct thread_cache {
+    ~thread_cache() {
+        t_cache_destroyed = true;
+
+        if (head) {
+            free_block* tail = head;
+            while (tail->next) tail = tail->next;
+
+            central().give(head, tail, size);
+        }
+    }
+
+    /** The first cached block */
+    free_block* head = nullptr;
+
+    /** The number of cached blocks */
+    std::size_t size = 0;
+};
+
+thread_local thread_cache t_cache;
+
+}  // namespace
+
 /**
  * @brief Constructor
  *
- * @param[in] fd The file descriptor to manage
+ * @param[in] fd   The file descriptor to manage
+ * @param[in] mode How concurrent system calls on \a fd are coordinated
  */
-shared_internal::shared_internal(int fd)
-    : m_mutex(), m_count(1), m_fd(fd), m_weak_count(1) {
+shared_internal::shared_internal(int fd, concurrency mode)
+    : m_mutex(),
+      m_fd(fd),
+      m_mode(mode),
+      m_status(0),
+      m_counts() {
+}
+
+/**
+ * @brief Allocate storage for a control block from the pool
+ *
+ * @param[in] size The number of bytes requested
+ *
+ * @return The allocated storage. Throws std::bad_alloc if the pool must grow
+ *         and the heap is exhausted
+ */
+void* shared_internal::operator new(std::size_t size) {
+    if (size != sizeof(shared_internal)) return ::operator new(size);
+
+    if (t_cache_destroyed) {
+        std::size_t taken;
+        return central().take(1, &taken);
+    }
+
+    thread_cache& cache = t_cache;
+
+    if (!cache.head) {
+        cache.head = central().take(transfer_blocks, &cache.size);
+    }
+
+    free_block* block = cache.head;
+
+    cache.head = block->next;
+    cache.size--;
+
+    return block;
+}
+
+/**
+ * @brief Return the storage of a control block to the pool
+ *
+ * @details The block goes to the calling thread's cache, which need not be
+ *          the cache it came from. Once the cache is full, a batch is handed
+ *          back to the shared free list
+ *
+ * @param[in] ptr  The storage to free
+ * @param[in] size The size it was allocated with
+ */
+void shared_internal::operator delete(void* ptr, std::size_t size) noexcept {
+    if (!ptr) return;
+
+    if (size != sizeof(shared_internal)) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    auto block = static_cast<free_block*>(ptr);
+
+    if (t_cache_destroyed) {
+        central().give(block, block, 1);
+        return;
+    }
+
+    thread_cache& cache = t_cache;
+
+    block->next = cache.head;
+    cache.head = block;
+
+    if (++cache.size > cache_capacity) {
+        free_block* tail = cache.head;
+        for (std::size_t i = 1; i < transfer_blocks; i++) tail = tail->next;
+
+        free_block* const head = cache.head;
+
+        cache.head  = tail->next;
+        cache.size -= transfer_blocks;
+
+        central().give(head, tail, transfer_blocks);
+    }
+}
+
+/**
+ * @brief Pre-allocate control blocks, e.g. ahead of a burst of connections
+ *
+ * @param[in] n Ensure at least this many free blocks are shared by all threads
+ *
+ * @return The number of blocks on the shared free list, which excludes any
+ *         cached by individual threads
+ */
+std::size_t shared_internal::reserve(std::size_t n) {
+    return central().reserve(n);
 }
 
 /**
@@ -27,7 +314,7 @@ shared_internal::shared_internal(int fd)
  * @return The reference count
  */
 std::size_t shared_internal::count() const {
-    return m_count.load(std::memory_order_relaxed);
+    return m_counts.count();
 }
 
 /**
@@ -36,7 +323,7 @@ std::size_t shared_internal::count() const {
  * @return The weak reference count
  */
 std::size_t shared_internal::weak_count() const {
-    return m_weak_count.load(std::memory_order_relaxed);
+    return m_counts.weak_count();
 }
 
 /**
@@ -48,11 +335,110 @@ int shared_internal::get() const {
     return m_fd;
 }
 
+/**
+ * @brief Get the number of times the cached file status flags have changed
+ *
+ * @details Owners may compare generations to detect flag changes made by
+ *          other threads without a system call
+ *
+ * @return The generation, which is zero until the flags are first read
+ */
+std::uint32_t shared_internal::generation() const {
+    return status_generation(m_status.load(std::memory_order_acquire));
+}
+
+/**
+ * @brief Check the cached blocking state of the file descriptor
+ *
+ * @return 1 if blocking, 0 if non-blocking, or -1 if the flags have not been
+ *         cached (always the case in serialized mode)
+ */
+int shared_internal::is_blocking() const {
+    const std::uint64_t status = m_status.load(std::memory_order_acquire);
+    if (status_generation(status) == 0) return -1;
+
+    return (status_flags(status) & O_NONBLOCK) ? 0 : 1;
+}
+
+/**
+ * @brief Get the concurrency mode
+ *
+ * @return How concurrent system calls are coordinated
+ */
+concurrency shared_internal::mode() const {
+    return m_mode;
+}
+
+/**
+ * @brief Poll the file descriptor for events
+ *
+ * @param[in] events  A bitmask of the events to wait on
+ * @param[in] timeout Wait for at most this many milliseconds before returning
+ *
+ * @return The returned events, or -1 on error
+ */
+int shared_internal::poll(short events, int timeout) {
+    if (m_mode == concurrency::lock_free) {
+        return file_descriptor::poll(m_fd, events, timeout);
+    }
+
+    return file_descriptor::poll(m_fd, events, timeout, &m_mutex);
+}
+
+/**
+ * @brief Set blocking behavior on the file descriptor
+ *
+ * @details In lock-free mode the change is first recorded in the cached flags
+ *          with compare-and-swap, so only F_SETFL is issued, and not at all if
+ *          the flags already match. Should another thread record a change
+ *          between our compare-and-swap and our F_SETFL, the latest cached
+ *          flags are re-applied so the descriptor converges on them
+ *
+ * @param[in] enable True to enable blocking, false otherwise
+ *
+ * @return True on success. On error, errno is set
+ */
+bool shared_internal::set_blocking(bool enable) {
+    if (m_mode == concurrency::serialized) {
+        return file_descriptor::set_blocking(m_fd, enable, &m_mutex);
+    }
+
+    std::uint64_t status = load_status();
+    if (status == 0) return false;
+
+    for (;;) {
+        const int flags = status_flags(status);
+        const int desired = enable ? (flags & ~O_NONBLOCK)
+                                   : (flags |  O_NONBLOCK);
+        if (desired == flags) return true;
+
+        const std::uint64_t next =
+            make_status(status_generation(status) + 1, desired);
+
+        if (m_status.compare_exchange_weak(status, next,
+                                           std::memory_order_acq_rel,
+                                           std::memory_order_acquire)) {
+            status = next;
+            break;
+        }
+    }
+
+    for (;;) {
+        if (posix_fcntl(m_fd, F_SETFL, status_flags(status)) < 0)
+            return false;
+
+        const std::uint64_t latest = m_status.load(std::memory_order_acquire);
+        if (latest == status) return true;
+
+        status = latest;
+    }
+}
+
 /**
  * @brief Increment the reference count
  */
 void shared_internal::add_reference() {
-    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_counts.add_reference();
 }
 
 /**
@@ -62,16 +448,7 @@ void shared_internal::add_reference() {
  * @return True if the increment succeeded
  */
 bool shared_internal::add_reference_if_valid() {
-    std::size_t count
-        = m_count.load(std::memory_order_relaxed);
-
-    for (;;) {
-        if (count == 0) return false;
-        if (m_count.compare_exchange_weak(
-                count, count+1, std::memory_order_relaxed)) {
-            return true;
-        }
-    }
+    return m_counts.add_reference_if_valid();
 }
 
 /**
@@ -80,7 +457,7 @@ bool shared_internal::add_reference_if_valid() {
  * @return True if all references have been dropped
  */
 bool shared_internal::release() {
-    if (m_count.fetch_sub(1, std::memory_order_relaxed) == 1) {
+    if (m_counts.release()) {
         file_descriptor::close(m_fd);
 
         // Decrement the weak reference count since we held
@@ -94,7 +471,7 @@ bool shared_internal::release() {
  * @brief Increment the weak reference count
  */
 void shared_internal::add_weak_reference() {
-    m_weak_count.fetch_add(1, std::memory_order_relaxed);
+    m_counts.add_weak_reference();
 }
 
 /**
@@ -104,16 +481,7 @@ void shared_internal::add_weak_reference() {
  * @return True if the increment succeeded
  */
 bool shared_internal::add_weak_reference_if_valid() {
-    std::size_t count
-        = m_weak_count.load(std::memory_order_relaxed);
-
-    for (;;) {
-        if (count == 0) return false;
-        if (m_weak_count.compare_exchange_weak(
-                count, count+1, std::memory_order_relaxed)) {
-            return true;
-        }
-    }
+    return m_counts.add_weak_reference_if_valid();
 }
 
 /**
@@ -122,8 +490,137 @@ bool shared_internal::add_weak_reference_if_valid() {
  * @return True if all references have been dropped
  */
 bool shared_internal::release_weak_reference() {
-    return m_weak_count.fetch_sub(1, std::memory_order_relaxed)
-            == 1;
+    return m_counts.release_weak_reference();
+}
+
+/**
+ * @brief Get the packed status word, reading the file status flags from the
+ *        kernel if they have not yet been cached
+ *
+ * @return The status word, or zero on error
+ */
+std::uint64_t shared_internal::load_status() {
+    std::uint64_t status = m_status.load(std::memory_order_acquire);
+    if (status != 0) return status;
+
+    const int flags = posix_fcntl(m_fd, F_GETFL, 0);
+    if (flags < 0) return 0;
+
+    const std::uint64_t loaded = make_status(1, flags);
+
+    // Another thread may have beaten us to it
+    if (m_status.compare_exchange_strong(status, loaded,
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_acquire)) {
+        return loaded;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Constructor
+ *
+ * @param[in] fd The file descriptor to manage. *this is owned by the calling
+ *               thread
+ */
+local_internal::local_internal(int fd)
+    : m_blocking(false),
+      m_count(1),
+      m_fd(fd),
+      m_owner(std::this_thread::get_id()),
+      m_shared(nullptr) {
+}
+
+/**
+ * @brief Get the current reference count
+ *
+ * @return The number of local owners
+ */
+std::size_t local_internal::count() const {
+    return m_count;
+}
+
+/**
+ * @brief Get the internally held file descriptor
+ *
+ * @return The file descriptor
+ */
+int local_internal::get() const {
+    return m_fd;
+}
+
+/**
+ * @brief Get the owning thread. May be called from any thread
+ *
+ * @return The ID of the thread which created *this
+ */
+std::thread::id local_internal::owner() const {
+    return m_owner;
+}
+
+/**
+ * @brief Hand management of the file descriptor to a shared_internal which
+ *        may be used from any thread
+ *
+ * @param[in] mode How owners in different threads coordinate system calls.
+ *                 Ignored if already promoted
+ *
+ * @return The shared control block with a strong reference added for the
+ *         caller, or nullptr if not called from the owning thread, in which
+ *         case errno is set to EPERM
+ */
+shared_internal* local_internal::promote(concurrency mode) {
+    if (std::this_thread::get_id() != m_owner) {
+        errno = EPERM;
+        return nullptr;
+    }
+
+    if (m_shared) {
+        m_shared->add_reference();
+    } else {
+        // One reference for us, one for the caller
+        m_shared = new shared_internal(m_fd, mode);
+        m_shared->add_reference();
+    }
+
+    return m_shared;
+}
+
+/**
+ * @brief Get the shared control block
+ *
+ * @return The control block, or nullptr if not promoted
+ */
+shared_internal* local_internal::shared() const {
+    return m_shared;
+}
+
+/**
+ * @brief Increment the reference count
+ */
+void local_internal::add_reference() {
+    m_count++;
+}
+
+/**
+ * @brief Decrement the reference count. When it reaches zero the file
+ *        descriptor is closed or, if promoted, our reference to the shared
+ *        control block is released
+ *
+ * @return True if all references have been dropped
+ */
+bool local_internal::release() {
+    if (--m_count != 0) return false;
+
+    if (m_shared) {
+        if (m_shared->release()) delete m_shared;
+        m_shared = nullptr;
+    } else {
+        file_descriptor::close(m_fd);
+    }
+
+    return true;
 }
 
 }  // namespace fd
@@ -0,0 +1,718 @@
+/**
+ *  \file   io_batch.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include "networking/io_batch.h"
+
+#include <poll.h>
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define NETWORKING_HAVE_IO_URING 1
+#endif
+
+#include "networking/posix_api.h"
+
+namespace jfern {
+namespace {
+#ifdef NETWORKING_HAVE_IO_URING
+/**
+ * Atomically load a value written by the kernel
+ */
+unsigned load_acquire(const unsigned* ptr) {
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * Atomically publish a value to the kernel
+ */
+void store_release(unsigned* ptr, unsigned value) {
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+/**
+ * Get a pointer at a byte offset into a mapped ring
+ */
+template <typename T>
+T* ring_offset(void* base, std::size_t offset) {
+    return reinterpret_cast<T*>(static_cast<std::uint8_t*>(base) + offset);
+}
+
+/**
+ * User data of cancellation requests, which is never a request slot
+ */
+constexpr std::uint64_t cancel_tag = ~std::uint64_t(0);
+#endif
+
+}  // namespace
+
+/**
+ * @brief Constructor
+ *
+ * @param entries      The size of the submission queue, i.e. the number of
+ *                     requests which can be submitted at once. Rounded up to
+ *                     a power of two by the kernel
+ * @param use_io_uring If false, always use the posix_api wrappers
+ */
+io_batch::io_batch(unsigned entries, bool use_io_uring)
+    : m_free(), m_queue(), m_requests(), m_ring() {
+    m_ring.fd = -1;
+
+    if (use_io_uring && !setup_ring(entries == 0 ? 1 : entries)) {
+        teardown_ring();
+    }
+}
+
+/**
+ * @brief Destructor
+ *
+ * @details Requests still in flight are cancelled, and the kernel is waited
+ *          on until it has finished with each, so buffers passed to read()
+ *          and write() may be released as soon as this returns. Handlers of
+ *          cancelled requests are not called
+ */
+io_batch::~io_batch() {
+    cancel_all();
+    teardown_ring();
+}
+
+/**
+ * @brief Queue a close()
+ *
+ * @param fd      The file descriptor to close
+ * @param handler Called back with zero on success. May be empty
+ *
+ * @return True on success
+ */
+bool io_batch::close(int fd, completion_handler_t handler) {
+    request req = {opcode::close, fd, nullptr, 0, 0, std::move(handler), {}};
+    return enqueue(std::move(req));
+}
+
+/**
+ * @brief Get the number of requests which have not completed
+ *
+ * @return The number of queued and in-flight requests
+ */
+std::size_t io_batch::in_flight() const noexcept {
+    return m_requests.size() - m_free.size();
+}
+
+/**
+ * @brief Queue a one-shot poll
+ *
+ * @param fd      The file descriptor to poll
+ * @param events  The events to wait for
+ * @param handler Called back with the returned events once any occur
+ *
+ * @return True on success
+ */
+bool io_batch::poll(int fd, short events, completion_handler_t handler) {
+    if (!handler) return false;
+
+    request req = {opcode::poll, fd, nullptr, 0, events, std::move(handler),
+                   {}};
+    return enqueue(std::move(req));
+}
+
+/**
+ * @brief Poll on behalf of an event sink
+ *
+ * @details The sink is polled for the events which currently have a handler.
+ *          When any occur they are dispatched through handle_events(), and
+ *          the poll is re-armed for as long as the sink remains alive and
+ *          has events of interest
+ *
+ * @param sink The event sink to dispatch. Only a weak reference is held
+ *
+ * @return True on success
+ */
+bool io_batch::poll(const std::shared_ptr<fd_event_sink>& sink) {
+    if (!sink || sink->get() < 0 || sink->events() == 0) return false;
+
+    request req = {opcode::poll, sink->get(), nullptr, 0, sink->events(),
+                   nullptr, sink};
+    return enqueue(std::move(req));
+}
+
+/**
+ * @brief Queue a read()
+ *
+ * @param fd      The file descriptor to read from
+ * @param buf     The buffer to place data into
+ * @param nbytes  The maximum number of bytes to read
+ * @param handler Called back with the number of bytes read
+ *
+ * @return True on success
+ */
+bool io_batch::read(int fd, std::uint8_t* buf, std::size_t nbytes,
+                    completion_handler_t handler) {
+    if (!handler) return false;
+
+    request req = {opcode::read, fd, buf, nbytes, 0, std::move(handler), {}};
+    return enqueue(std::move(req));
+}
+
+/**
+ * @brief Submit all queued requests and dispatch completions
+ *
+ * @details Requests queued by handlers during this call may not be
+ *          submitted until the next call
+ *
+ * @param min_complete Block until at least this many requests complete
+ *
+ * @return The number of completions dispatched, or -1 on error
+ */
+int io_batch::submit(unsigned min_complete) {
+    min_complete = std::min<std::size_t>(min_complete, in_flight());
+
+    return m_ring.fd < 0 ? submit_fallback(min_complete)
+                         : submit_ring(min_complete);
+}
+
+/**
+ * @brief Check which backend is in use
+ *
+ * @return True if requests are submitted through io_uring, or false if the
+ *         posix_api wrappers are used instead
+ */
+bool io_batch::using_io_uring() const noexcept {
+    return m_ring.fd >= 0;
+}
+
+/**
+ * @brief Queue a write()
+ *
+ * @param fd      The file descriptor to write to
+ * @param buf     The data to write
+ * @param nbytes  The number of bytes to write
+ * @param handler Called back with the number of bytes written. May be empty
+ *
+ * @return True on success
+ */
+bool io_batch::write(int fd, const std::uint8_t* buf, std::size_t nbytes,
+                     completion_handler_t handler) {
+    request req = {opcode::write, fd, const_cast<std::uint8_t*>(buf), nbytes,
+                   0, std::move(handler), {}};
+    return enqueue(std::move(req));
+}
+
+/**
+ * @brief Cancel every request submitted to io_uring and wait for all of them
+ *        to complete, without calling their handlers
+ */
+void io_batch::cancel_all() {
+#ifdef NETWORKING_HAVE_IO_URING
+    if (m_ring.fd < 0) return;
+
+    std::vector<bool> outstanding(m_requests.size(), true);
+    for (const std::size_t slot : m_free) outstanding[slot] = false;
+
+    std::size_t n_outstanding = in_flight();
+
+    for (std::size_t slot = 0; slot < outstanding.size(); slot++) {
+        if (!outstanding[slot]) continue;
+
+        // If the queue is full and cannot be flushed, the request is still
+        // waited on below
+        io_uring_sqe* sqe = get_sqe();
+        if (!sqe) continue;
+
+        sqe->opcode    = IORING_OP_ASYNC_CANCEL;
+        sqe->fd        = -1;
+        sqe->addr      = slot;
+        sqe->user_data = cancel_tag;
+
+        store_release(m_ring.sq_tail, *m_ring.sq_tail + 1);
+        m_ring.to_submit++;
+    }
+
+    while (n_outstanding > 0 || m_ring.to_submit > 0) {
+        if (enter(n_outstanding > 0 ? 1 : 0) < 0) break;
+
+        for (;;) {
+            const unsigned head = *m_ring.cq_head;
+            if (head == load_acquire(m_ring.cq_tail)) break;
+
+            const std::uint64_t slot =
+                m_ring.cqes[head & *m_ring.cq_mask].user_data;
+
+            store_release(m_ring.cq_head, head + 1);
+
+            if (slot != cancel_tag && outstanding[slot]) {
+                outstanding[slot] = false;
+                n_outstanding--;
+            }
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Retire a request and invoke its handler
+ *
+ * @param slot   The index of the request
+ * @param result The result of the request, or a negated errno value
+ */
+void io_batch::complete(std::size_t slot, int result) {
+    // Handlers may queue new requests, so release the slot first
+    request req = std::move(m_requests[slot]);
+    m_requests[slot] = request();
+    m_free.push_back(slot);
+
+    if (req.handler) {
+        req.handler(result);
+        return;
+    }
+
+    if (req.op != opcode::poll) return;
+
+    if (auto sink = req.sink.lock()) {
+        if (result > 0) sink->handle_events(static_cast<short>(result));
+        if (result >= 0) poll(sink);
+    }
+}
+
+/**
+ * @brief Assign a request a slot and queue it for submission
+ *
+ * @param req The request to queue
+ *
+ * @return True on success
+ */
+bool io_batch::enqueue(request&& req) {
+    std::size_t slot;
+    if (m_free.empty()) {
+        slot = m_requests.size();
+        m_requests.push_back(std::move(req));
+    } else {
+        slot = m_free.back();
+        m_free.pop_back();
+        m_requests[slot] = std::move(req);
+    }
+
+    if (m_ring.fd < 0) {
+        m_queue.push_back(slot);
+        return true;
+    }
+
+    if (push_sqe(slot)) return true;
+
+    m_requests[slot] = request();
+    m_free.push_back(slot);
+    return false;
+}
+
+/**
+ * @brief Submit everything on the io_uring submission queue, retrying if
+ *        interrupted by a signal
+ *
+ * @param wait Block until at least this many requests complete
+ *
+ * @return The number of entries submitted, or -1 on error
+ */
+int io_batch::enter(unsigned wait) {
+#ifdef NETWORKING_HAVE_IO_URING
+    int submitted;
+    do {
+        submitted = posix_io_uring_enter(m_ring.fd, m_ring.to_submit, wait,
+                                         wait > 0 ? IORING_ENTER_GETEVENTS
+                                                  : 0);
+    } while (submitted < 0 && errno == EINTR);
+
+    if (submitted > 0) m_ring.to_submit -= static_cast<unsigned>(submitted);
+
+    return submitted;
+#else
+    static_cast<void>(wait);
+    return -1;
+#endif
+}
+
+/**
+ * @brief Get the next free entry on the io_uring submission queue, first
+ *        flushing the queue to the kernel if it is full
+ *
+ * @details The entry is zeroed. It is handed to the kernel once the
+ *          submission queue tail is advanced past it
+ *
+ * @return The entry, or nullptr if the queue is full
+ */
+io_uring_sqe* io_batch::get_sqe() {
+#ifdef NETWORKING_HAVE_IO_URING
+    const unsigned tail = *m_ring.sq_tail;
+
+    if (tail - load_acquire(m_ring.sq_head) >= m_ring.sq_entries) {
+        if (enter(0) < 0) return nullptr;
+
+        if (tail - load_acquire(m_ring.sq_head) >= m_ring.sq_entries)
+            return nullptr;
+    }
+
+    const unsigned index = tail & *m_ring.sq_mask;
+    io_uring_sqe* sqe = &m_ring.sqes[index];
+
+    std::memset(sqe, 0, sizeof(*sqe));
+    m_ring.sq_array[index] = index;
+
+    return sqe;
+#else
+    return nullptr;
+#endif
+}
+
+/**
+ * @brief Service a request through the posix_api wrappers
+ *
+ * @param[in]  slot   The index of the request, which must not be a poll
+ * @param[out] result The result of the request, or a negated errno value
+ *
+ * @return False if the request is a read or write which would block, in
+ *         which case it should be retried once its descriptor is ready
+ */
+bool io_batch::perform(std::size_t slot, int* result) {
+    const request& req = m_requests[slot];
+
+    ssize_t n = 0;
+    switch (req.op) {
+    case opcode::close:
+        n = posix_close(req.fd);
+        break;
+    case opcode::poll:
+        break;
+    case opcode::read:
+        n = posix_read(req.fd, req.buf, req.nbytes);
+        break;
+    case opcode::write:
+        n = posix_write(req.fd, req.buf, req.nbytes);
+        break;
+    }
+
+    if (n < 0 && req.op != opcode::close &&
+        (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return false;
+    }
+
+    *result = n < 0 ? -errno : static_cast<int>(n);
+    return true;
+}
+
+/**
+ * @brief Place a request on the io_uring submission queue, first flushing
+ *        the queue to the kernel if it is full
+ *
+ * @param slot The index of the request
+ *
+ * @return True on success
+ */
+bool io_batch::push_sqe(std::size_t slot) {
+#ifdef NETWORKING_HAVE_IO_URING
+    io_uring_sqe* sqe = get_sqe();
+    if (!sqe) return false;
+
+    const request& req = m_requests[slot];
+
+    sqe->fd = req.fd;
+    sqe->user_data = slot;
+
+    switch (req.op) {
+    case opcode::close:
+        sqe->opcode = IORING_OP_CLOSE;
+        break;
+    case opcode::poll:
+        sqe->opcode = IORING_OP_POLL_ADD;
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        sqe->poll32_events = static_cast<unsigned short>(req.events) << 16;
+#else
+        sqe->poll32_events = static_cast<unsigned short>(req.events);
+#endif
+        break;
+    case opcode::read:
+    case opcode::write:
+        sqe->opcode = req.op == opcode::read ? IORING_OP_READ
+                                             : IORING_OP_WRITE;
+        sqe->addr = reinterpret_cast<std::uintptr_t>(req.buf);
+        sqe->len  = static_cast<std::uint32_t>(req.nbytes);
+        sqe->off  = static_cast<std::uint64_t>(-1);
+        break;
+    }
+
+    store_release(m_ring.sq_tail, *m_ring.sq_tail + 1);
+
+    m_ring.to_submit++;
+    return true;
+#else
+    static_cast<void>(slot);
+    return false;
+#endif
+}
+
+/**
+ * @brief Dispatch everything on the io_uring completion queue
+ *
+ * @return The number of completions dispatched
+ */
+int io_batch::reap() {
+    int n = 0;
+#ifdef NETWORKING_HAVE_IO_URING
+    for (;;) {
+        const unsigned head = *m_ring.cq_head;
+        if (head == load_acquire(m_ring.cq_tail)) break;
+
+        const io_uring_cqe& cqe = m_ring.cqes[head & *m_ring.cq_mask];
+
+        const std::size_t slot = cqe.user_data;
+        const int result = cqe.res;
+
+        store_release(m_ring.cq_head, head + 1);
+
+        complete(slot, result);
+        n++;
+    }
+#endif
+    return n;
+}
+
+/**
+ * @brief Create the io_uring instance and map its queues
+ *
+ * @param entries The requested submission queue size
+ *
+ * @return True if io_uring is available and supports every operation we
+ *         need
+ */
+bool io_batch::setup_ring(unsigned entries) {
+#ifdef NETWORKING_HAVE_IO_URING
+    struct io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+
+    m_ring.fd = posix_io_uring_setup(entries, &params);
+    if (m_ring.fd < 0) return false;
+
+    // Older kernels lack IORING_OP_READ, IORING_OP_CLOSE, or the probe itself
+    std::vector<std::uint8_t> probe_buf(
+        sizeof(io_uring_probe) + IORING_OP_LAST * sizeof(io_uring_probe_op));
+    auto* probe = reinterpret_cast<io_uring_probe*>(probe_buf.data());
+
+    if (posix_io_uring_register(m_ring.fd, IORING_REGISTER_PROBE, probe,
+                                IORING_OP_LAST) < 0) {
+        return false;
+    }
+
+    for (const int op : {IORING_OP_ASYNC_CANCEL, IORING_OP_CLOSE,
+                         IORING_OP_POLL_ADD, IORING_OP_READ, IORING_OP_WRITE}) {
+        if (op > probe->last_op ||
+            !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) {
+            return false;
+        }
+    }
+
+    m_ring.sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_ring.cq_size = params.cq_off.cqes
+                        + params.cq_entries * sizeof(io_uring_cqe);
+
+    const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap) {
+        m_ring.sq_size = m_ring.cq_size = std::max(m_ring.sq_size,
+                                                   m_ring.cq_size);
+    }
+
+    void* sq_ptr = ::mmap(nullptr, m_ring.sq_size, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, m_ring.fd,
+                          IORING_OFF_SQ_RING);
+    if (sq_ptr == MAP_FAILED) return false;
+    m_ring.sq_ptr = sq_ptr;
+
+    if (single_mmap) {
+        m_ring.cq_ptr = sq_ptr;
+    } else {
+        void* cq_ptr = ::mmap(nullptr, m_ring.cq_size, PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_POPULATE, m_ring.fd,
+                              IORING_OFF_CQ_RING);
+        if (cq_ptr == MAP_FAILED) return false;
+        m_ring.cq_ptr = cq_ptr;
+    }
+
+    m_ring.sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+
+    void* sqes = ::mmap(nullptr, m_ring.sqes_size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, m_ring.fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) return false;
+    m_ring.sqes = static_cast<io_uring_sqe*>(sqes);
+
+    m_ring.sq_head  = ring_offset<unsigned>(sq_ptr, params.sq_off.head);
+    m_ring.sq_tail  = ring_offset<unsigned>(sq_ptr, params.sq_off.tail);
+    m_ring.sq_mask  = ring_offset<unsigned>(sq_ptr, params.sq_off.ring_mask);
+    m_ring.sq_array = ring_offset<unsigned>(sq_ptr, params.sq_off.array);
+    m_ring.sq_entries = params.sq_entries;
+
+    m_ring.cq_head = ring_offset<unsigned>(m_ring.cq_ptr, params.cq_off.head);
+    m_ring.cq_tail = ring_offset<unsigned>(m_ring.cq_ptr, params.cq_off.tail);
+    m_ring.cq_mask = ring_offset<unsigned>(m_ring.cq_ptr,
+                                           params.cq_off.ring_mask);
+    m_ring.cqes = ring_offset<io_uring_cqe>(m_ring.cq_ptr,
+                                            params.cq_off.cqes);
+    m_ring.to_submit = 0;
+
+    return true;
+#else
+    static_cast<void>(entries);
+    return false;
+#endif
+}
+
+/**
+ * @brief Service queued requests through the posix_api wrappers
+ *
+ * @param min_complete Block until at least this many requests complete
+ *
+ * @return The number of completions dispatched, or -1 on error
+ */
+int io_batch::submit_fallback(unsigned min_complete) {
+    std::vector<std::size_t> queue;
+    queue.swap(m_queue);
+
+    int n = 0;
+
+    // Polls, and reads and writes which would block
+    std::vector<std::size_t> polls;
+
+    for (const std::size_t slot : queue) {
+        int result;
+        if (m_requests[slot].op == opcode::poll || !perform(slot, &result)) {
+            polls.push_back(slot);
+            continue;
+        }
+
+        complete(slot, result);
+        n++;
+    }
+
+    // Service all outstanding polls with a single poll(2), waiting only if
+    // we have yet to see enough completions
+    std::vector<struct pollfd> pfds;
+    while (!polls.empty()) {
+        pfds.resize(polls.size());
+        for (std::size_t i = 0; i < polls.size(); i++) {
+            const request& req = m_requests[polls[i]];
+
+            pfds[i].fd      = req.fd;
+            pfds[i].revents = 0;
+
+            switch (req.op) {
+            case opcode::read:
+                pfds[i].events = POLLIN;
+                break;
+            case opcode::write:
+                pfds[i].events = POLLOUT;
+                break;
+            default:
+                pfds[i].events = req.events;
+            }
+        }
+
+        const bool wait = static_cast<unsigned>(n) < min_complete;
+
+        const int n_ready = posix_poll(pfds.data(), pfds.size(),
+                                       wait ? -1 : 0);
+        if (n_ready < 0) {
+            if (errno == EINTR) continue;
+
+            m_queue.insert(m_queue.begin(), polls.begin(), polls.end());
+            return n > 0 ? n : -1;
+        }
+
+        std::vector<std::size_t> ready, unready;
+        for (std::size_t i = 0; i < polls.size(); i++) {
+            if (pfds[i].revents != 0) {
+                if (m_requests[polls[i]].op == opcode::poll)
+                    m_requests[polls[i]].events = pfds[i].revents;
+                ready.push_back(polls[i]);
+            } else {
+                unready.push_back(polls[i]);
+            }
+        }
+
+        polls.swap(unready);
+
+        for (const std::size_t slot : ready) {
+            int result = m_requests[slot].events;
+            if (m_requests[slot].op != opcode::poll &&
+                !perform(slot, &result)) {
+                polls.push_back(slot);
+                continue;
+            }
+
+            complete(slot, result);
+            n++;
+        }
+
+        if (static_cast<unsigned>(n) >= min_complete) break;
+    }
+
+    // Like io_uring requests, unready ones stay outstanding
+    m_queue.insert(m_queue.begin(), polls.begin(), polls.end());
+
+    return n;
+}
+
+/**
+ * @brief Submit queued requests to the kernel and dispatch completions
+ *
+ * @param min_complete Block until at least this many requests complete
+ *
+ * @return The number of completions dispatched, or -1 on error
+ */
+int io_batch::submit_ring(unsigned min_complete) {
+#ifdef NETWORKING_HAVE_IO_URING
+    int n = reap();
+
+    for (bool first = true; first || static_cast<unsigned>(n) < min_complete;
+         first = false) {
+        unsigned wait = 0;
+        if (static_cast<unsigned>(n) < min_complete) {
+            wait = std::min<std::size_t>(min_complete - n, in_flight());
+        }
+
+        if (m_ring.to_submit == 0 && wait == 0) break;
+
+        if (enter(wait) < 0) return n > 0 ? n : -1;
+
+        n += reap();
+    }
+
+    return n;
+#else
+    static_cast<void>(min_complete);
+    return -1;
+#endif
+}
+
+/**
+ * @brief Unmap the io_uring queues and close the instance
+ */
+void io_batch::teardown_ring() {
+    if (m_ring.sqes) ::munmap(m_ring.sqes, m_ring.sqes_size);
+
+    if (m_ring.cq_ptr && m_ring.cq_ptr != m_ring.sq_ptr)
+        ::munmap(m_ring.cq_ptr, m_ring.cq_size);
+
+    if (m_ring.sq_ptr) ::munmap(m_ring.sq_ptr, m_ring.sq_size);
+
+    if (m_ring.fd >= 0) posix_close(m_ring.fd);
+
+    m_ring = ring();
+    m_ring.fd = -1;
+}
+
+}  // namespace jfern
@@ -0,0 +1,282 @@
+/**
+ *  \file   local_shared_fd.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include "networking/local_shared_fd.h"
+
+#include <utility>
+
+#include "networking/file_descriptor.h"
+
+namespace jfern {
+/**
+ * @brief Default constructor
+ */
+local_shared_fd::local_shared_fd() : m_local_info(nullptr) {
+}
+
+/**
+ * @brief Constructor
+ *
+ * @param fd The file descriptor to manage. The calling thread becomes its
+ *           owner
+ */
+local_shared_fd::local_shared_fd(int fd)
+    : m_local_info(new fd::local_internal(fd)) {
+}
+
+/**
+ * @brief Copy constructor
+ *
+ * @param fd The local_shared_fd whose file descriptor will be co-owned with
+ *           *this
+ */
+local_shared_fd::local_shared_fd(const local_shared_fd& fd)
+    : m_local_info(fd.m_local_info) {
+    if (m_local_info) m_local_info->add_reference();
+}
+
+/**
+ * @brief Move constructor
+ *
+ * @param fd The local_shared_fd whose file descriptor will be handed to *this
+ */
+local_shared_fd::local_shared_fd(local_shared_fd&& fd)
+    : m_local_info(fd.m_local_info) {
+    fd.m_local_info = nullptr;
+}
+
+/**
+ * @brief Copy assignment operator
+ *
+ * @param fd The local_shared_fd whose file descriptor will be co-owned with
+ *           *this
+ *
+ * @return *this
+ */
+local_shared_fd& local_shared_fd::operator=(const local_shared_fd& fd) {
+    if (m_local_info != fd.m_local_info) {
+        drop_reference();
+
+        m_local_info = fd.m_local_info;
+        if (m_local_info) m_local_info->add_reference();
+    }
+
+    return *this;
+}
+
+/**
+ * @brief Move assignment operator
+ *
+ * @param fd The local_shared_fd whose file descriptor will be handed to *this
+ *
+ * @return *this
+ */
+local_shared_fd& local_shared_fd::operator=(local_shared_fd&& fd) {
+    if (this != &fd) {
+        drop_reference();
+
+        m_local_info = fd.m_local_info;
+        fd.m_local_info = nullptr;
+    }
+
+    return *this;
+}
+
+/**
+ * @brief Destructor. Closes the file descriptor if *this is its only owner
+ */
+local_shared_fd::~local_shared_fd() {
+    drop_reference();
+}
+
+/**
+ * @see See fd_interface::operator bool()
+ */
+local_shared_fd::operator bool() const noexcept {
+    return m_local_info;
+}
+
+/**
+ * @see See fd_interface::get()
+ */
+int local_shared_fd::get() const noexcept {
+    return m_local_info ? m_local_info->get() : -1;
+}
+
+/**
+ * @see See fd_interface::is_blocking()
+ */
+bool local_shared_fd::is_blocking() const noexcept {
+    if (!m_local_info) return false;
+
+    // Once shared, report changes made through any owner if we can
+    fd::shared_internal* shared = m_local_info->shared();
+    if (shared) {
+        const int blocking = shared->is_blocking();
+        if (blocking >= 0) return blocking;
+    }
+
+    return m_local_info->m_blocking;
+}
+
+/**
+ * @brief Get the thread which owns the file descriptor
+ *
+ * @return The owning thread's ID, or a default-constructed ID if no file
+ *         descriptor is held
+ */
+std::thread::id local_shared_fd::owner() const noexcept {
+    return m_local_info ? m_local_info->owner() : std::thread::id();
+}
+
+/**
+ * @see See fd_interface::poll()
+ */
+int local_shared_fd::poll(short events) noexcept {
+    return poll(events, 0);
+}
+
+/**
+ * @see See fd_interface::poll()
+ */
+int local_shared_fd::poll(short events,
+                          fd_interface::event_handler_t handler) {
+    const int revents = poll(events);
+    if (revents != -1 && handler) handler(revents, *this);
+
+    return revents;
+}
+
+/**
+ * @see See fd_interface::poll()
+ */
+int local_shared_fd::poll(short events, int timeout) noexcept {
+    if (!m_local_info) return -1;
+
+    // Once shared, coordinate with owners in other threads
+    fd::shared_internal* shared = m_local_info->shared();
+    if (shared) return shared->poll(events, timeout);
+
+    return file_descriptor::poll(m_local_info->get(), events, timeout);
+}
+
+/**
+ * @see See fd_interface::poll()
+ */
+int local_shared_fd::poll(short events, int timeout,
+                          fd_interface::event_handler_t handler) {
+    const int revents = poll(events, timeout);
+    if (revents != -1 && handler) handler(revents, *this);
+
+    return revents;
+}
+
+/**
+ * @brief Check whether the file descriptor has been shared with other threads
+ *
+ * @return True if share() has been called on any local owner
+ */
+bool local_shared_fd::promoted() const noexcept {
+    return m_local_info && m_local_info->shared();
+}
+
+/**
+ * @see See fd_interface::reset()
+ */
+bool local_shared_fd::reset(int fd) noexcept {
+    const bool blocking = is_blocking();
+
+    if (!file_descriptor::set_blocking(fd, blocking)) {
+        return false;
+    }
+
+    drop_reference();
+
+    m_local_info = new fd::local_internal(fd);
+    m_local_info->m_blocking = blocking;
+
+    return true;
+}
+
+/**
+ * @see See fd_interface::set_blocking()
+ */
+bool local_shared_fd::set_blocking(bool enable) noexcept {
+    if (!m_local_info) return false;
+
+    fd::shared_internal* shared = m_local_info->shared();
+
+    const bool success = shared
+        ? shared->set_blocking(enable)
+        : file_descriptor::set_blocking(m_local_info->get(), enable);
+
+    if (success) m_local_info->m_blocking = enable;
+
+    return success;
+}
+
+/**
+ * @brief Share the file descriptor with other threads
+ *
+ * @details On the first call, management of the file descriptor passes to an
+ *          atomically reference counted control block. Subsequent calls
+ *          return further references to it
+ *
+ * @param mode How owners in different threads coordinate system calls.
+ *             Ignored if already shared
+ *
+ * @return A shared_fd which co-owns the file descriptor and may be copied to
+ *         any thread, or an empty shared_fd if no file descriptor is held or
+ *         if not called from the owning thread (in which case errno is set
+ *         to EPERM)
+ */
+shared_fd local_shared_fd::share(fd::concurrency mode) const {
+    if (!m_local_info) return shared_fd();
+
+    const bool blocking = is_blocking();
+
+    shared_fd fd(m_local_info->promote(mode));
+    if (fd) fd.m_fd.m_blocking = blocking;
+
+    return fd;
+}
+
+/**
+ * @brief Swap this object's data members with \a fd
+ *
+ * @param fd The local_shared_fd to swap with
+ */
+void local_shared_fd::swap(local_shared_fd& fd) noexcept {
+    std::swap(m_local_info, fd.m_local_info);
+}
+
+/**
+ * @brief Get the number of local objects sharing ownership of the file
+ *        descriptor
+ *
+ * @return The number of local owners. Owners obtained through share() are
+ *         not included
+ */
+std::size_t local_shared_fd::use_count() const noexcept {
+    return m_local_info ? m_local_info->count() : 0;
+}
+
+/**
+ * @brief Release ownership of the currently held file descriptor
+ */
+void local_shared_fd::drop_reference() {
+    if (m_local_info) {
+        if (m_local_info->release()) {
+            delete m_local_info;
+        }
+
+        m_local_info = nullptr;
+    }
+}
+
+}  // namespace jfern
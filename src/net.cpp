@@ -0,0 +1,205 @@
+/**
+ *  \file   net.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include "networking/net.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define NETWORKING_X86 1
+#endif
+
+#include <cstring>
+
+namespace jfern {
+namespace internal {
+namespace {
+/**
+ * Reverse the bytes of each element one at a time
+ *
+ * @param[in]  in    The elements to convert
+ * @param[out] out   The converted elements
+ * @param[in]  count The number of elements
+ */
+template <typename T>
+void swap_scalar(const std::uint8_t* in, std::uint8_t* out,
+                 std::size_t count) noexcept {
+    for (std::size_t i = 0; i < count; i++) {
+        T value;
+        std::memcpy(&value, in + i * sizeof(T), sizeof(T));
+
+        value = jfern::byte_swap<T>(value);
+        std::memcpy(out + i * sizeof(T), &value, sizeof(T));
+    }
+}
+
+/**
+ * Reverse the bytes of each element one at a time
+ *
+ * @param[in]  in    The elements to convert
+ * @param[out] out   The converted elements
+ * @param[in]  count The number of elements
+ * @param[in]  width The size of each element, in bytes
+ */
+void swap_scalar(const std::uint8_t* in, std::uint8_t* out, std::size_t count,
+                 std::size_t width) noexcept {
+    switch (width) {
+    case 2:
+        swap_scalar<std::uint16_t>(in, out, count);
+        break;
+    case 4:
+        swap_scalar<std::uint32_t>(in, out, count);
+        break;
+    case 8:
+        swap_scalar<std::uint64_t>(in, out, count);
+        break;
+    default:
+        if (in != out) std::memcpy(out, in, count * width);
+        break;
+    }
+}
+
+#ifdef NETWORKING_X86
+/**
+ * Build the pshufb control mask which reverses each element of a 16-byte
+ * lane
+ *
+ * @param[out] mask  The mask
+ * @param[in]  width The size of each element, in bytes
+ */
+void make_shuffle_mask(std::uint8_t mask[16], std::size_t width) noexcept {
+    for (std::size_t i = 0; i < 16; i++) {
+        const std::size_t start = i - i % width;
+        mask[i] = static_cast<std::uint8_t>(start + width - 1 - i % width);
+    }
+}
+
+/**
+ * Reverse the bytes of each element, 16 bytes at a time
+ *
+ * @param[in]  in    The elements to convert
+ * @param[out] out   The converted elements
+ * @param[in]  count The number of elements
+ * @param[in]  width The size of each element, in bytes
+ */
+__attribute__((target("ssse3")))
+void swap_ssse3(const std::uint8_t* in, std::uint8_t* out, std::size_t count,
+                std::size_t width) noexcept {
+    std::uint8_t bytes[16];
+    make_shuffle_mask(bytes, width);
+
+    const __m128i mask =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+
+    const std::size_t nbytes = count * width;
+
+    std::size_t i = 0;
+    for (; i + 16 <= nbytes; i += 16) {
+        const __m128i v =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                         _mm_shuffle_epi8(v, mask));
+    }
+
+    swap_scalar(in + i, out + i, (nbytes - i) / width, width);
+}
+
+/**
+ * Reverse the bytes of each element, 32 bytes at a time
+ *
+ * @param[in]  in    The elements to convert
+ * @param[out] out   The converted elements
+ * @param[in]  count The number of elements
+ * @param[in]  width The size of each element, in bytes
+ */
+__attribute__((target("avx2")))
+void swap_avx2(const std::uint8_t* in, std::uint8_t* out, std::size_t count,
+               std::size_t width) noexcept {
+    std::uint8_t bytes[16];
+    make_shuffle_mask(bytes, width);
+
+    // vpshufb shuffles within each 16-byte lane, so repeat the mask
+    const __m256i mask = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes)));
+
+    const std::size_t nbytes = count * width;
+
+    std::size_t i = 0;
+    for (; i + 64 <= nbytes; i += 64) {
+        const __m256i v0 =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        const __m256i v1 =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i + 32));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                            _mm256_shuffle_epi8(v0, mask));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 32),
+                            _mm256_shuffle_epi8(v1, mask));
+    }
+
+    for (; i + 32 <= nbytes; i += 32) {
+        const __m256i v =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                            _mm256_shuffle_epi8(v, mask));
+    }
+
+    swap_scalar(in + i, out + i, (nbytes - i) / width, width);
+}
+#endif  // NETWORKING_X86
+
+}  // namespace
+
+/**
+ * Get the widest instruction set usable by the bulk byte swap kernels on
+ * this CPU
+ *
+ * @return The instruction set
+ */
+simd_level max_simd_level() noexcept {
+#ifdef NETWORKING_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))  return simd_level::avx2;
+    if (__builtin_cpu_supports("ssse3")) return simd_level::ssse3;
+#endif
+    return simd_level::scalar;
+}
+
+/**
+ * Reverse the bytes of each element of an array
+ *
+ * @param[in]  in    The elements to convert
+ * @param[out] out   The converted elements. May be the same as \a in, but must
+ *                   not otherwise overlap it
+ * @param[in]  count The number of elements
+ * @param[in]  width The size of each element: 1, 2, 4, or 8 bytes
+ * @param[in]  level The instruction set to use. Must be supported by this CPU
+ *                   (see max_simd_level())
+ */
+void bulk_byte_swap(const void* in, void* out, std::size_t count,
+                    std::size_t width, simd_level level) noexcept {
+    const auto src = static_cast<const std::uint8_t*>(in);
+    const auto dst = static_cast<std::uint8_t*>(out);
+
+    switch (level) {
+#ifdef NETWORKING_X86
+    case simd_level::avx2:
+        swap_avx2(src, dst, count, width);
+        break;
+    case simd_level::ssse3:
+        swap_ssse3(src, dst, count, width);
+        break;
+#endif
+    default:
+        swap_scalar(src, dst, count, width);
+        break;
+    }
+}
+
+}  // namespace internal
+}  // namespace jfern
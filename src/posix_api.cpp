@@ -8,9 +8,41 @@
 
 #include "networking/posix_api.h"
 
+#include <sys/syscall.h>
+
+#include <cerrno>
 #include <utility>
 
 namespace jfern {
+/**
+ * @brief Wrapper to the Linux accept4() function
+ *
+ * @param fd      The listening socket
+ * @param addr    Receives the address of the peer. May be null
+ * @param addrlen The size of \a addr, updated to the size of the address
+ * @param flags   Bitwise OR of SOCK_NONBLOCK and SOCK_CLOEXEC, or 0
+ *
+ * @return A file descriptor for the accepted socket. On error, returns -1 and
+ *         sets errno
+ */
+int posix_accept4(int fd, struct sockaddr* addr, socklen_t* addrlen,
+                  int flags) {
+    return ::accept4(fd, addr, addrlen, flags);
+}
+
+/**
+ * @brief Wrapper to the POSIX bind() function
+ *
+ * @param fd      The socket to bind
+ * @param addr    The address to assign to the socket
+ * @param addrlen The size of \a addr
+ *
+ * @return Zero on success. On error, returns -1 and sets errno
+ */
+int posix_bind(int fd, const struct sockaddr* addr, socklen_t addrlen) {
+    return ::bind(fd, addr, addrlen);
+}
+
 /**
  * @brief Wrapper to the POSIX close() function
  *
@@ -22,6 +54,160 @@ int posix_close(int fd) {
     return ::close(fd);
 }
 
+/**
+ * @brief Wrapper to the POSIX connect() function
+ *
+ * @param fd      The socket to connect
+ * @param addr    The address of the peer
+ * @param addrlen The size of \a addr
+ *
+ * @return Zero on success. On error, returns -1 and sets errno
+ */
+int posix_connect(int fd, const struct sockaddr* addr, socklen_t addrlen) {
+    return ::connect(fd, addr, addrlen);
+}
+
+/**
+ * @brief Wrapper to the Linux epoll_create1() function
+ *
+ * @param flags Either 0 or EPOLL_CLOEXEC
+ *
+ * @return A file descriptor referring to the new epoll instance. On error,
+ *         returns -1 and sets errno
+ */
+int posix_epoll_create1(int flags) {
+    return ::epoll_create1(flags);
+}
+
+/**
+ * @brief Wrapper to the Linux epoll_ctl() function
+ *
+ * @param epfd  The epoll instance to operate on
+ * @param op    One of EPOLL_CTL_ADD, EPOLL_CTL_MOD, or EPOLL_CTL_DEL
+ * @param fd    The target file descriptor
+ * @param event The events to monitor \a fd for, along with user data
+ *
+ * @return Zero on success. On error, returns -1 and sets errno
+ */
+int posix_epoll_ctl(int epfd, int op, int fd, struct epoll_event* event) {
+    return ::epoll_ctl(epfd, op, fd, event);
+}
+
+/**
+ * @brief Wrapper to the Linux epoll_wait() function
+ *
+ * @param epfd      The epoll instance to wait on
+ * @param events    Buffer which receives the ready events
+ * @param maxevents The capacity of \a events
+ * @param timeout   The max number of milliseconds to wait for an event
+ *
+ * @return The number of file descriptors ready. On error, returns -1 and
+ *         sets errno
+ */
+int posix_epoll_wait(int epfd, struct epoll_event* events, int maxevents,
+                     int timeout) {
+    return ::epoll_wait(epfd, events, maxevents, timeout);
+}
+
+/**
+ * @brief Wrapper to the Linux eventfd() function
+ *
+ * @param initval The initial value of the counter
+ * @param flags   Bitwise OR of EFD_CLOEXEC, EFD_NONBLOCK and EFD_SEMAPHORE
+ *
+ * @return A file descriptor for the event object. On error, returns -1 and
+ *         sets errno
+ */
+int posix_eventfd(unsigned int initval, int flags) {
+    return ::eventfd(initval, flags);
+}
+
+/**
+ * @brief Wrapper to the POSIX getsockname() function
+ *
+ * @param fd      The socket to query
+ * @param addr    Receives the address the socket is bound to
+ * @param addrlen The size of \a addr, updated to the size of the address
+ *
+ * @return Zero on success. On error, returns -1 and sets errno
+ */
+int posix_getsockname(int fd, struct sockaddr* addr, socklen_t* addrlen) {
+    return ::getsockname(fd, addr, addrlen);
+}
+
+/**
+ * @brief Wrapper to the Linux io_uring_enter() system call
+ *
+ * @param fd           The io_uring instance
+ * @param to_submit    The number of submission queue entries to submit
+ * @param min_complete Wait for at least this many completions
+ * @param flags        Bitmask of IORING_ENTER_* flags
+ *
+ * @return The number of entries submitted. On error, returns -1 and sets
+ *         errno
+ */
+int posix_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                         unsigned flags) {
+#ifdef __NR_io_uring_enter
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit,
+                                      min_complete, flags, nullptr, 0));
+#else
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+/**
+ * @brief Wrapper to the Linux io_uring_register() system call
+ *
+ * @param fd      The io_uring instance
+ * @param opcode  One of the IORING_REGISTER_* operations
+ * @param arg     Operation-specific argument
+ * @param nr_args Operation-specific argument count
+ *
+ * @return An operation-specific value. On error, returns -1 and sets errno
+ */
+int posix_io_uring_register(int fd, unsigned opcode, void* arg,
+                            unsigned nr_args) {
+#ifdef __NR_io_uring_register
+    return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg,
+                                      nr_args));
+#else
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+/**
+ * @brief Wrapper to the Linux io_uring_setup() system call
+ *
+ * @param entries The requested number of submission queue entries
+ * @param params  Setup parameters, which also receive the ring offsets
+ *
+ * @return A file descriptor referring to the new io_uring instance. On error,
+ *         returns -1 and sets errno
+ */
+int posix_io_uring_setup(unsigned entries, struct io_uring_params* params) {
+#ifdef __NR_io_uring_setup
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+#else
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+/**
+ * @brief Wrapper to the POSIX listen() function
+ *
+ * @param fd      The socket to listen on
+ * @param backlog The maximum length of the queue of pending connections
+ *
+ * @return Zero on success. On error, returns -1 and sets errno
+ */
+int posix_listen(int fd, int backlog) {
+    return ::listen(fd, backlog);
+}
+
 /**
  * @brief Wrapper to the POSIX poll() function
  *
@@ -50,6 +236,97 @@ ssize_t posix_read(int fd, std::uint8_t* buf, std::size_t nbytes) {
     return ::read(fd, buf, nbytes);
 }
 
+/**
+ * @brief Wrapper to the POSIX readv() function
+ *
+ * @param fd     The file descriptor to read from
+ * @param iov    The buffers to scatter the data into, filled in order
+ * @param iovcnt The number of buffers in \a iov
+ *
+ * @return The total number of bytes actually read. On error, returns -1 and
+ *         sets errno
+ */
+ssize_t posix_readv(int fd, const struct iovec* iov, int iovcnt) {
+    return ::readv(fd, iov, iovcnt);
+}
+
+/**
+ * @brief Wrapper to the POSIX send() function
+ *
+ * @param fd     The socket to write to
+ * @param buf    The data to send
+ * @param nbytes Number of bytes to attempt to send
+ * @param flags  Bitwise OR of MSG_* flags, e.g. MSG_NOSIGNAL
+ *
+ * @return The number of bytes actually sent. On error, returns -1 and sets
+ *         errno
+ */
+ssize_t posix_send(int fd, const std::uint8_t* buf, std::size_t nbytes,
+                   int flags) {
+    return ::send(fd, buf, nbytes, flags);
+}
+
+/**
+ * @brief Wrapper to the POSIX setsockopt() function
+ *
+ * @param fd    The socket to configure
+ * @param level The protocol level of the option, e.g. SOL_SOCKET
+ * @param name  The option to set
+ * @param value The new value of the option
+ * @param len   The size of \a value
+ *
+ * @return Zero on success. On error, returns -1 and sets errno
+ */
+int posix_setsockopt(int fd, int level, int name, const void* value,
+                     socklen_t len) {
+    return ::setsockopt(fd, level, name, value, len);
+}
+
+/**
+ * @brief Wrapper to the POSIX socket() function
+ *
+ * @param domain   The communication domain, e.g. AF_INET
+ * @param type     The socket type, optionally OR'd with SOCK_NONBLOCK and
+ *                 SOCK_CLOEXEC
+ * @param protocol The protocol, or 0 to pick the default for \a type
+ *
+ * @return A file descriptor for the new socket. On error, returns -1 and sets
+ *         errno
+ */
+int posix_socket(int domain, int type, int protocol) {
+    return ::socket(domain, type, protocol);
+}
+
+/**
+ * @brief Wrapper to the Linux timerfd_create() function
+ *
+ * @param clockid The clock to measure against, e.g. CLOCK_MONOTONIC
+ * @param flags   Bitwise OR of TFD_NONBLOCK and TFD_CLOEXEC, or 0
+ *
+ * @return A file descriptor for the new timer. On error, returns -1 and sets
+ *         errno
+ */
+int posix_timerfd_create(int clockid, int flags) {
+    return ::timerfd_create(clockid, flags);
+}
+
+/**
+ * @brief Wrapper to the Linux timerfd_settime() function
+ *
+ * @param fd        The timer to arm or disarm
+ * @param flags     TFD_TIMER_ABSTIME, or 0 for a relative expiration
+ * @param new_value The expiration and interval. An expiration of zero
+ *                  disarms the timer
+ * @param old_value Receives the previous setting. May be null
+ *
+ * @return Zero on success. On error, returns -1 and sets errno
+ */
+int posix_timerfd_settime(int fd, int flags,
+                          const struct itimerspec* new_value,
+                          struct itimerspec* old_value) {
+    return ::timerfd_settime(fd, flags, new_value, old_value);
+}
+
 /**
  * @brief Wrapper to the POSIX write() function
  * 
@@ -64,4 +341,18 @@ ssize_t posix_write(int fd, const std::uint8_t* buf, std::size_t nbytes) {
     return ::write(fd, buf, nbytes);
 }
 
+/**
+ * @brief Wrapper to the POSIX writev() function
+ *
+ * @param fd     The file descriptor to write to
+ * @param iov    The buffers to gather the data from, written in order
+ * @param iovcnt The number of buffers in \a iov
+ *
+ * @return The total number of bytes actually written. On error, returns -1
+ *         and sets errno
+ */
+ssize_t posix_writev(int fd, const struct iovec* iov, int iovcnt) {
+    return ::writev(fd, iov, iovcnt);
+}
+
 }  // namespace jfern
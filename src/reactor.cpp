@@ -0,0 +1,310 @@
+/**
+ *  \file   reactor.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include "networking/reactor.h"
+
+#include <poll.h>
+
+#include <cerrno>
+#include <utility>
+
+#include "networking/posix_api.h"
+
+namespace jfern {
+namespace {
+static_assert(POLLIN  == EPOLLIN  && POLLPRI   == EPOLLPRI   &&
+              POLLOUT == EPOLLOUT && POLLERR   == EPOLLERR   &&
+              POLLHUP == EPOLLHUP && POLLRDHUP == EPOLLRDHUP,
+              "poll() and epoll() event bits must coincide");
+
+/**
+ * Build the epoll registration for an event sink
+ *
+ * @param[in] sink The sink to register
+ * @param[in] id   The registration number of \a sink
+ *
+ * @return The epoll_event describing \a sink. Its data holds the registration
+ *         number in the upper 32 bits and the file descriptor in the lower
+ */
+struct epoll_event make_event(const fd_event_sink& sink, std::uint32_t id) {
+    struct epoll_event ev = {};
+
+    ev.events   = static_cast<unsigned short>(sink.events());
+    ev.data.u64 = static_cast<std::uint64_t>(id) << 32
+                      | static_cast<std::uint32_t>(sink.get());
+
+    if (sink.edge_triggered()) ev.events |= EPOLLET;
+
+    return ev;
+}
+
+}  // namespace
+
+/**
+ * @brief Constructor
+ *
+ * @param max_events The maximum number of ready file descriptors returned by
+ *                   a single call to epoll_wait(). Any others are picked up
+ *                   on the next call to run_once()
+ */
+reactor::reactor(std::size_t max_events)
+    : m_backlog(),
+      m_deferred(),
+      m_epoll(posix_epoll_create1(EPOLL_CLOEXEC)),
+      m_next_id(0),
+      m_ready(max_events == 0 ? 1 : max_events),
+      m_round(0),
+      m_sinks(),
+      m_timers() {
+}
+
+/**
+ * @brief Boolean type conversion operator
+ *
+ * @return True if the epoll instance was created successfully
+ */
+reactor::operator bool() const noexcept {
+    return static_cast<bool>(m_epoll);
+}
+
+/**
+ * @brief Register an event sink
+ *
+ * @param sink The sink to dispatch events to. Its file descriptor is monitored
+ *             for the events which currently have a handler
+ *
+ * @note If handlers are later added to or removed from \a sink, call update()
+ *       so the epoll registration reflects them
+ *
+ * @return True on success, or false if \a sink is invalid or its file
+ *         descriptor is already registered
+ */
+bool reactor::add(std::shared_ptr<fd_event_sink> sink) {
+    if (!m_epoll || !sink) return false;
+
+    const int fd = sink->get();
+    if (fd < 0 || contains(fd)) return false;
+
+    const std::uint32_t id = m_next_id;
+
+    struct epoll_event ev = make_event(*sink, id);
+
+    if (posix_epoll_ctl(m_epoll.get(), EPOLL_CTL_ADD, fd, &ev) < 0)
+        return false;
+
+    m_next_id++;
+
+    m_sinks.emplace(fd, sink_info(std::move(sink), id));
+    return true;
+}
+
+/**
+ * @brief Check whether a file descriptor is registered
+ *
+ * @param fd The file descriptor to look up
+ *
+ * @return True if a sink is registered for \a fd
+ */
+bool reactor::contains(int fd) const {
+    return m_sinks.find(fd) != m_sinks.end();
+}
+
+/**
+ * @brief Run a task at the end of the current (or, outside of run_once(),
+ *        the next) iteration, after all handlers have been dispatched
+ *
+ * @param task The task to run. Tasks run in the order deferred; any deferred
+ *             while the tasks run are left for the next iteration
+ */
+void reactor::defer(std::function<void()> task) {
+    m_deferred.push_back(std::move(task));
+}
+
+/**
+ * @brief Get the sink registered for a file descriptor, e.g. to add
+ *        handlers to it
+ *
+ * @param fd The file descriptor to look up
+ *
+ * @return The sink, or null if none is registered for \a fd
+ */
+std::shared_ptr<fd_event_sink> reactor::find(int fd) const {
+    auto iter = m_sinks.find(fd);
+    if (iter == m_sinks.end()) return nullptr;
+
+    return iter->second.sink;
+}
+
+/**
+ * @brief Stop monitoring a file descriptor
+ *
+ * @param fd The file descriptor whose sink to unregister
+ *
+ * @note It is safe to call this from within an event handler
+ *
+ * @return True if \a fd was registered
+ */
+bool reactor::remove(int fd) {
+    auto iter = m_sinks.find(fd);
+    if (iter == m_sinks.end()) return false;
+
+    // The descriptor may already have been closed, in which case
+    // the kernel has dropped it from the interest list for us
+    posix_epoll_ctl(m_epoll.get(), EPOLL_CTL_DEL, fd, nullptr);
+
+    m_sinks.erase(iter);
+    return true;
+}
+
+/**
+ * @brief Wait for events and dispatch their handlers
+ *
+ * @param timeout Wait at most this many milliseconds for an event. If
+ *                negative, block indefinitely. Ignored if there are sinks
+ *                with undrained events or deferred tasks, in which case we
+ *                do not wait. Shortened if a timer is due sooner
+ *
+ * @return The number of sinks dispatched, or -1 on error
+ */
+int reactor::run_once(int timeout) {
+    if (!m_epoll) return -1;
+
+    std::vector<int> backlog;
+    backlog.swap(m_backlog);
+
+    const bool busy = !backlog.empty() || !m_deferred.empty();
+
+    const int next_timer = m_timers.next_timeout();
+
+    if (busy) {
+        timeout = 0;
+    } else if (next_timer >= 0 && (timeout < 0 || next_timer < timeout)) {
+        timeout = next_timer;
+    }
+
+    const int n_ready = posix_epoll_wait(m_epoll.get(),
+                                         m_ready.data(),
+                                         static_cast<int>(m_ready.size()),
+                                         timeout);
+    if (n_ready < 0 && errno != EINTR) {
+        m_backlog.swap(backlog);
+        return -1;
+    }
+
+    m_round++;
+
+    int n_dispatched = 0;
+
+    for (int i = 0; i < n_ready; i++) {
+        const struct epoll_event& ev = m_ready[i];
+
+        const auto fd = static_cast<int>(ev.data.u64 & 0xffffffff);
+        const auto id = static_cast<std::uint32_t>(ev.data.u64 >> 32);
+
+        if (dispatch(fd, id, static_cast<short>(ev.events)))
+            n_dispatched++;
+    }
+
+    // Resume sinks which ran out of budget last time, unless they were
+    // just serviced above. A sink registered in place of a removed one
+    // has nothing pending
+    for (const int fd : backlog) {
+        auto iter = m_sinks.find(fd);
+        if (iter == m_sinks.end() || iter->second.round == m_round
+                || iter->second.pending == 0)
+            continue;
+
+        if (dispatch(fd, iter->second.id, iter->second.pending))
+            n_dispatched++;
+    }
+
+    m_timers.advance();
+
+    std::vector<std::function<void()>> deferred;
+    deferred.swap(m_deferred);
+
+    for (const auto& task : deferred) task();
+
+    return n_dispatched;
+}
+
+/**
+ * @brief Get the number of registered sinks
+ *
+ * @return The number of file descriptors being monitored
+ */
+std::size_t reactor::size() const noexcept {
+    return m_sinks.size();
+}
+
+/**
+ * @brief Get the timers driven by this reactor
+ *
+ * @return The timer wheel advanced by run_once()
+ */
+timer_wheel& reactor::timers() noexcept {
+    return m_timers;
+}
+
+/**
+ * @brief Refresh the events monitored for a file descriptor after its
+ *        handlers have changed
+ *
+ * @param fd The file descriptor whose sink was modified
+ *
+ * @return True on success
+ */
+bool reactor::update(int fd) {
+    auto iter = m_sinks.find(fd);
+    if (iter == m_sinks.end()) return false;
+
+    struct epoll_event ev = make_event(*iter->second.sink, iter->second.id);
+
+    return posix_epoll_ctl(m_epoll.get(), EPOLL_CTL_MOD, fd, &ev) == 0;
+}
+
+/**
+ * @brief Dispatch the handlers of a registered sink
+ *
+ * @param fd     The file descriptor whose sink to dispatch
+ * @param id     The registration number the events were reported for
+ * @param events The events which occurred. Any undrained events left over
+ *               from the previous dispatch are included
+ *
+ * @return True if the sink registered for \a fd is still registration
+ *         \a id, i.e. the events were not meant for a removed sink
+ */
+bool reactor::dispatch(int fd, std::uint32_t id, short events) {
+    auto iter = m_sinks.find(fd);
+    if (iter == m_sinks.end() || iter->second.id != id) return false;
+
+    sink_info& info = iter->second;
+
+    events |= info.pending;
+
+    info.pending = 0;
+    info.round   = m_round;
+
+    // Hold a reference in case the handler removes the sink
+    const std::shared_ptr<fd_event_sink> sink = info.sink;
+
+    const short pending = sink->handle_events(events);
+
+    if (pending != 0) {
+        // The handler may have invalidated our iterator
+        iter = m_sinks.find(fd);
+        if (iter != m_sinks.end() && iter->second.sink == sink) {
+            iter->second.pending = pending;
+            m_backlog.push_back(fd);
+        }
+    }
+
+    return true;
+}
+
+}  // namespace jfern
@@ -10,14 +10,11 @@
 
 #include <utility>
 
-#include "networking/file_descriptor.h"
-
 namespace jfern {
 /**
  * @brief Default constructor
  */
-shared_fd::shared_fd()
-    : m_blocking(false), m_shared_info(nullptr) {
+shared_fd::shared_fd() : m_fd() {
 }
 
 /**
@@ -25,8 +22,16 @@ shared_fd::shared_fd()
  *
  * @param fd The file descriptor to manage
  */
-shared_fd::shared_fd(int fd)
-    : m_blocking(false), m_shared_info(new fd::shared_internal(fd)) {
+shared_fd::shared_fd(int fd) : m_fd(fd) {
+}
+
+/**
+ * @brief Constructor
+ *
+ * @param fd   The file descriptor to manage
+ * @param mode How owners in different threads coordinate system calls
+ */
+shared_fd::shared_fd(int fd, fd::concurrency mode) : m_fd(fd, mode) {
 }
 
 /**
@@ -34,8 +39,7 @@ shared_fd::shared_fd(int fd)
  *
  * @param fd The shared_fd whose file descriptor will be co-owned with *this
  */
-shared_fd::shared_fd(const shared_fd& fd) {
-    *this = fd;
+shared_fd::shared_fd(const shared_fd& fd) : m_fd(fd.m_fd) {
 }
 
 /**
@@ -43,8 +47,17 @@ shared_fd::shared_fd(const shared_fd& fd) {
  *
  * @param fd The shared_fd whose file descriptor will be handed to *this
  */
-shared_fd::shared_fd(shared_fd&& fd) {
-    *this = std::move(fd);
+shared_fd::shared_fd(shared_fd&& fd) : m_fd(std::move(fd.m_fd)) {
+}
+
+/**
+ * @brief Constructor which adopts a strong reference to an existing control
+ *        block
+ *
+ * @param shared_info The control block. Its reference count must already
+ *                    account for *this
+ */
+shared_fd::shared_fd(fd::shared_internal* shared_info) : m_fd(shared_info) {
 }
 
 /**
@@ -55,20 +68,7 @@ shared_fd::shared_fd(shared_fd&& fd) {
  * @return *this
  */
 shared_fd& shared_fd::operator=(const shared_fd& fd) {
-    if (this != &fd) {
-        m_blocking = fd.m_blocking;
-
-        // Drop the currently referenced file descriptor
-        drop_reference();
-        m_shared_info = fd.m_shared_info;
-
-        if (m_shared_info) {
-            if (!m_shared_info->add_reference_if_valid()) {
-                m_shared_info = nullptr;
-            }
-        }
-    }
-
+    m_fd = fd.m_fd;
     return *this;
 }
 
@@ -80,16 +80,7 @@ shared_fd& shared_fd::operator=(const shared_fd& fd) {
  * @return *this
  */
 shared_fd& shared_fd::operator=(shared_fd&& fd) {
-    if (this != &fd) {
-        m_blocking = fd.m_blocking;
-
-        // Drop the currently referenced file descriptor
-        drop_reference();
-        m_shared_info = fd.m_shared_info;
-
-        fd.m_shared_info = nullptr;
-    }
-
+    m_fd = std::move(fd.m_fd);
     return *this;
 }
 
@@ -97,38 +88,43 @@ shared_fd& shared_fd::operator=(shared_fd&& fd) {
  * @brief Destructor. Closes the file descriptor if *this is its only owner
  */
 shared_fd::~shared_fd() {
-    drop_reference();
 }
 
 /**
  * @see See fd_interface::operator bool()
  */
 shared_fd::operator bool() const noexcept {
-    return m_shared_info;
+    return static_cast<bool>(m_fd);
+}
+
+/**
+ * @brief Get the concurrency mode of the managed file descriptor
+ *
+ * @return How owners in different threads coordinate system calls
+ */
+fd::concurrency shared_fd::concurrency_mode() const noexcept {
+    return m_fd.concurrency_mode();
 }
 
 /**
  * @see See fd_interface::get()
  */
 int shared_fd::get() const noexcept {
-    return m_shared_info ? m_shared_info->get() : -1;
+    return m_fd.get();
 }
 
 /**
  * @see See fd_interface::is_blocking()
  */
 bool shared_fd::is_blocking() const noexcept {
-    return m_blocking;
+    return m_fd.is_blocking();
 }
 
 /**
  * @see See fd_interface::poll()
  */
 int shared_fd::poll(short events) noexcept {
-    if (!m_shared_info) return -1;
-
-    return file_descriptor::poll(
-            m_shared_info->get(), events, 0, &m_shared_info->m_mutex);
+    return m_fd.poll(events);
 }
 
 /**
@@ -146,10 +142,7 @@ int shared_fd::poll(short events,
  * @see See fd_interface::poll()
  */
 int shared_fd::poll(short events, int timeout) noexcept {
-    if (!m_shared_info) return -1;
-
-    return file_descriptor::poll(
-            m_shared_info->get(), events, timeout, &m_shared_info->m_mutex);
+    return m_fd.poll(events, timeout);
 }
 
 /**
@@ -167,26 +160,14 @@ int shared_fd::poll(short events, int timeout,
  * @see See fd_interface::reset()
  */
 bool shared_fd::reset(int fd) noexcept {
-    if (!file_descriptor::set_blocking(fd, m_blocking)) {
-        return false;
-    }
-
-    drop_reference();
-
-    m_shared_info = new fd::shared_internal(fd);
-    return m_shared_info;
+    return m_fd.reset(fd);
 }
 
 /**
  * @see See fd_interface::set_blocking()
  */
 bool shared_fd::set_blocking(bool enable) noexcept {
-    if (m_shared_info) {
-        return file_descriptor::set_blocking(
-                m_shared_info->get(), enable, &m_shared_info->m_mutex);
-    }
-
-    return false;
+    return m_fd.set_blocking(enable);
 }
 
 /**
@@ -195,16 +176,7 @@ bool shared_fd::set_blocking(bool enable) noexcept {
  * @param fd The shared_fd to swap with
  */
 void shared_fd::swap(shared_fd& fd) noexcept {
-    if (this != &fd) {
-        const bool my_blocking = m_blocking;
-        fd::shared_internal* my_shared_info = m_shared_info;
-
-        m_blocking = fd.m_blocking;
-        m_shared_info = fd.m_shared_info;
-
-        fd.m_shared_info = my_shared_info;
-        fd.m_blocking = my_blocking;
-    }
+    m_fd.swap(fd.m_fd);
 }
 
 /**
@@ -213,22 +185,25 @@ void shared_fd::swap(shared_fd& fd) noexcept {
  * @return The number of owners
  */
 std::size_t shared_fd::use_count() const noexcept {
-    if (!m_shared_info) return 0;
-
-    return m_shared_info->count();
+    return m_fd.use_count();
 }
 
 /**
- * @brief Release ownership of the currently held file descriptor
+ * @brief Create a shared_fd whose control block is drawn from the pool
+ *
+ * @details Control blocks are pooled however a shared_fd is created. Prefer
+ *          this factory at call sites that create descriptors in bulk, e.g.
+ *          once per accepted connection, in the same way std::make_shared is
+ *          preferred over std::shared_ptr's constructor; see
+ *          fd::shared_internal::reserve() to warm the pool beforehand
+ *
+ * @param fd   The file descriptor to manage
+ * @param mode How owners in different threads coordinate system calls
+ *
+ * @return A shared_fd which is the sole owner of \a fd
  */
-void shared_fd::drop_reference() {
-    if (m_shared_info) {
-        if (m_shared_info->release()) {
-            delete m_shared_info;
-        }
-
-        m_shared_info = nullptr;
-    }
+shared_fd make_shared_fd(int fd, fd::concurrency mode) {
+    return shared_fd(fd, mode);
 }
 
 /**
@@ -243,8 +218,8 @@ weak_fd::weak_fd() : m_shared_info(nullptr) {
  * @param fd The shared_fd which manages the file descriptor to obtain a weak
  *           reference to
  */
-weak_fd::weak_fd(const shared_fd& fd)
-    : m_shared_info(fd.m_shared_info) {
+weak_fd::weak_fd(const shared_fd& fd) : m_shared_info(nullptr) {
+    *this = fd;
 }
 
 /**
@@ -252,7 +227,7 @@ weak_fd::weak_fd(const shared_fd& fd)
  *
  * @param fd The weak_fd to create a copy of
  */
-weak_fd::weak_fd(const weak_fd& fd) {
+weak_fd::weak_fd(const weak_fd& fd) : m_shared_info(nullptr) {
     *this = fd;
 }
 
@@ -261,7 +236,7 @@ weak_fd::weak_fd(const weak_fd& fd) {
  *
  * @param fd The weak_fd which will be moved into *this
  */
-weak_fd::weak_fd(weak_fd&& fd) {
+weak_fd::weak_fd(weak_fd&& fd) : m_shared_info(nullptr) {
     *this = std::move(fd);
 }
 
@@ -315,7 +290,15 @@ weak_fd& weak_fd::operator=(weak_fd&& fd) {
  * @return *this
  */
 weak_fd& weak_fd::operator=(const shared_fd& fd) {
-    m_shared_info = fd.m_shared_info;
+    if (m_shared_info != fd.m_fd.m_shared_info) {
+        reset();
+        m_shared_info = fd.m_fd.m_shared_info;
+
+        // A live shared_fd holds a weak reference on our behalf, so
+        // this cannot fail
+        if (m_shared_info) m_shared_info->add_weak_reference();
+    }
+
     return *this;
 }
 
@@ -348,7 +331,7 @@ bool weak_fd::expired() const noexcept {
 shared_fd weak_fd::lock() const noexcept {
     if (m_shared_info) {
         if (m_shared_info->add_reference_if_valid()) {
-            return shared_fd(m_shared_info->get());
+            return shared_fd(m_shared_info);
         }
     }
 
@@ -0,0 +1,555 @@
+/**
+ *  \file   timer_wheel.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include "networking/timer_wheel.h"
+
+#include <poll.h>
+#include <time.h>
+
+#include <algorithm>
+#include <climits>
+#include <limits>
+#include <utility>
+
+#include "networking/posix_api.h"
+
+namespace jfern {
+namespace {
+/**
+ * Returned by next_expiry() if there are no timers
+ */
+constexpr std::uint64_t never = std::numeric_limits<std::uint64_t>::max();
+
+/**
+ * Find the first set bit of a bitmap at or after a position, wrapping around
+ * to the start
+ *
+ * @param[in] bitmap The bitmap
+ * @param[in] start  The position to start from
+ *
+ * @return The distance from \a start to the first set bit, or the bitmap size
+ *         if no bit is set
+ */
+template <std::size_t N>
+std::size_t distance_to_set_bit(const std::array<std::uint64_t, N>& bitmap,
+                                std::size_t start) noexcept {
+    constexpr std::size_t bits = 64 * N;
+
+    std::size_t word = start / 64;
+    std::uint64_t mask = bitmap[word] & (~std::uint64_t(0) << (start % 64));
+
+    for (std::size_t i = 0; i <= N; i++) {
+        if (mask != 0) {
+            const std::size_t pos = word * 64 + __builtin_ctzll(mask);
+            return (pos + bits - start) % bits;
+        }
+
+        word = (word + 1) % N;
+        mask = bitmap[word];
+    }
+
+    return bits;
+}
+
+}  // namespace
+
+/**
+ * @brief Constructor
+ *
+ * @param tick The resolution of the wheel. Delays are rounded up to a whole
+ *             number of ticks
+ */
+timer_wheel::timer_wheel(std::chrono::milliseconds tick)
+    : m_armed(0),
+      m_free(npos),
+      m_heads(),
+      m_nodes(),
+      m_now(0),
+      m_occupied(),
+      m_size(0),
+      m_start(clock::now()),
+      m_tick(tick.count() > 0 ? tick : std::chrono::milliseconds(1)),
+      m_timerfd() {
+    m_heads.fill(npos);
+}
+
+/**
+ * @brief Run the callbacks of all timers which have expired
+ *
+ * @return The number of callbacks run
+ */
+std::size_t timer_wheel::advance() {
+    return advance(clock::now());
+}
+
+/**
+ * @brief Run the callbacks of all timers which expire at or before a given
+ *        time
+ *
+ * @param now The current time
+ *
+ * @note Callbacks may schedule and cancel timers, including those due to run
+ *       in this call
+ *
+ * @return The number of callbacks run
+ */
+std::size_t timer_wheel::advance(clock::time_point now) {
+    const std::uint64_t target = to_ticks(now);
+
+    std::size_t n_expired = 0;
+
+    while (m_now <= target) {
+        // Skip over ticks with nothing to cascade or expire
+        const std::uint64_t tick = next_expiry();
+
+        if (tick > target) {
+            m_now = target + 1;
+            break;
+        }
+
+        m_now = tick;
+
+        const std::size_t index = tick % slots_per_level;
+
+        // Refill the first wheel from the coarser ones each time it wraps
+        if (index == 0) {
+            for (std::size_t level = 1; level < levels; level++) {
+                const std::size_t slot =
+                    (tick >> (bits_per_level * level)) % slots_per_level;
+
+                cascade(level, slot);
+                if (slot != 0) break;
+            }
+        }
+
+        // Move the expired timers to their own list, so that callbacks
+        // may cancel them or schedule new timers in the same slot
+        const std::uint32_t expiring = levels * slots_per_level;
+
+        for (std::uint32_t i = m_heads[index]; i != npos; ) {
+            const std::uint32_t next = m_nodes[i].next;
+            unlink(i);
+            m_nodes[i].slot = expiring;
+            m_nodes[i].prev = npos;
+            m_nodes[i].next = m_heads[expiring];
+            if (m_heads[expiring] != npos)
+                m_nodes[m_heads[expiring]].prev = i;
+            m_heads[expiring] = i;
+            i = next;
+        }
+
+        m_now = tick + 1;
+
+        while (m_heads[expiring] != npos) {
+            const std::uint32_t i = m_heads[expiring];
+
+            unlink(i);
+
+            callback_t callback = std::move(m_nodes[i].callback);
+            free_node(i);
+            m_size--;
+
+            callback();
+            n_expired++;
+        }
+    }
+
+    return n_expired;
+}
+
+/**
+ * @brief Cancel a pending timer
+ *
+ * @param id The timer to cancel
+ *
+ * @return True if the timer was pending, or false if it already expired or
+ *         was cancelled
+ */
+bool timer_wheel::cancel(timer_id id) noexcept {
+    const std::uint32_t index = find(id);
+    if (index == npos) return false;
+
+    unlink(index);
+    free_node(index);
+    m_size--;
+
+    // A timerfd left armed for this timer fires harmlessly
+    return true;
+}
+
+/**
+ * @brief Create an event sink which runs expired timers, for use with any
+ *        event loop built on fd_event_sink
+ *
+ * @details The sink's file descriptor is a timerfd which becomes readable
+ *          when the next timer is due, so timers need not be polled for.
+ *          Only one sink is created; later calls return a new sink for the
+ *          same timerfd
+ *
+ * @return The sink, or null on error, in which case errno is set
+ */
+std::shared_ptr<fd_event_sink> timer_wheel::event_sink() {
+    if (!m_timerfd) {
+        const int fd = posix_timerfd_create(CLOCK_MONOTONIC,
+                                            TFD_NONBLOCK | TFD_CLOEXEC);
+        if (fd < 0) return nullptr;
+
+        m_timerfd = shared_fd(fd);
+        arm_timerfd();
+    }
+
+    auto sink = std::make_shared<fd_event_sink>(
+        std::unique_ptr<fd_interface>(new shared_fd(m_timerfd)));
+
+    sink->add_events(POLLIN, [this](short, fd_interface& fd) {
+        std::uint64_t expirations;
+        posix_read(fd.get(), reinterpret_cast<std::uint8_t*>(&expirations),
+                   sizeof(expirations));
+
+        m_armed = 0;
+        advance();
+        arm_timerfd();
+    });
+
+    return sink;
+}
+
+/**
+ * @brief Get how long an event loop may wait before advance() has work to do
+ *
+ * @return The number of milliseconds until the next timer is due, 0 if one is
+ *         already due, or -1 if there are no timers
+ */
+int timer_wheel::next_timeout() {
+    return next_timeout(clock::now());
+}
+
+/**
+ * @brief Get how long an event loop may wait before advance() has work to do
+ *
+ * @param now The current time
+ *
+ * @note Timers due far in the future are kept in coarse wheels. Until they
+ *       are cascaded into finer ones, the timeout returned is the time until
+ *       the cascade, which may be shorter than the time until the timer is
+ *       due
+ *
+ * @return The number of milliseconds until the next timer is due, 0 if one is
+ *         already due, or -1 if there are no timers
+ */
+int timer_wheel::next_timeout(clock::time_point now) {
+    const std::uint64_t expiry = next_expiry();
+    if (expiry == never) return -1;
+
+    const clock::time_point when = m_start + m_tick * static_cast<std::int64_t>(expiry);
+    if (when <= now) return 0;
+
+    const auto wait =
+        std::chrono::ceil<std::chrono::milliseconds>(when - now).count();
+
+    return static_cast<int>(std::min<decltype(wait)>(wait, INT_MAX));
+}
+
+/**
+ * @brief Check whether a timer is pending
+ *
+ * @param id The timer to check
+ *
+ * @return True if the timer has neither expired nor been cancelled
+ */
+bool timer_wheel::pending(timer_id id) const noexcept {
+    return find(id) != npos;
+}
+
+/**
+ * @brief Move a pending timer to a new expiration, e.g. to push back an idle
+ *        timeout whenever a connection sees activity
+ *
+ * @param id    The timer to reschedule
+ * @param delay The time from now at which the timer expires
+ *
+ * @return True on success, or false if the timer is not pending
+ */
+bool timer_wheel::reschedule(timer_id id, std::chrono::milliseconds delay) {
+    const std::uint32_t index = find(id);
+    if (index == npos) return false;
+
+    unlink(index);
+
+    const auto ticks = (std::max(delay, std::chrono::milliseconds(0)) +
+                        m_tick - std::chrono::milliseconds(1)) / m_tick;
+
+    m_nodes[index].expires =
+        std::max(m_now, to_ticks(clock::now())) + ticks;
+    link(index);
+
+    if (m_timerfd && (m_armed == 0 || m_nodes[index].expires < m_armed))
+        arm_timerfd();
+
+    return true;
+}
+
+/**
+ * @brief Schedule a callback to run once, after a delay
+ *
+ * @param delay    The time from now at which the timer expires. Rounded up
+ *                 to a whole number of ticks
+ * @param callback The callback to run from advance() once the timer expires
+ *
+ * @return The timer, or \ref invalid_timer if \a callback is empty
+ */
+auto timer_wheel::schedule(std::chrono::milliseconds delay,
+                           callback_t callback) -> timer_id {
+    if (!callback) return invalid_timer;
+
+    std::uint32_t index = m_free;
+
+    if (index != npos) {
+        m_free = m_nodes[index].next;
+    } else {
+        index = static_cast<std::uint32_t>(m_nodes.size());
+        m_nodes.push_back(timer_node{0, nullptr, 1, npos, npos, npos});
+    }
+
+    timer_node& node = m_nodes[index];
+
+    const auto ticks = (std::max(delay, std::chrono::milliseconds(0)) +
+                        m_tick - std::chrono::milliseconds(1)) / m_tick;
+
+    node.expires  = std::max(m_now, to_ticks(clock::now())) + ticks;
+    node.callback = std::move(callback);
+
+    link(index);
+    m_size++;
+
+    if (m_timerfd && (m_armed == 0 || node.expires < m_armed))
+        arm_timerfd();
+
+    return (static_cast<timer_id>(node.generation) << 32) | index;
+}
+
+/**
+ * @brief Get the number of pending timers
+ *
+ * @return The number of timers which have neither expired nor been cancelled
+ */
+std::size_t timer_wheel::size() const noexcept {
+    return m_size;
+}
+
+/**
+ * @brief Get the resolution of the wheel
+ *
+ * @return The length of a tick
+ */
+std::chrono::milliseconds timer_wheel::tick() const noexcept {
+    return m_tick;
+}
+
+/**
+ * @brief Set the timerfd to fire when advance() next has work to do, or
+ *        disarm it if there are no timers
+ */
+void timer_wheel::arm_timerfd() {
+    if (!m_timerfd) return;
+
+    const std::uint64_t expiry = next_expiry();
+
+    struct itimerspec spec = {};
+
+    if (expiry != never) {
+        const auto wait = std::max(
+            m_start + m_tick * static_cast<std::int64_t>(expiry) - clock::now(),
+            clock::duration(std::chrono::nanoseconds(1)));
+
+        const auto ns =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count();
+
+        // Note a zero expiration would disarm the timer instead
+        spec.it_value.tv_sec  = ns / 1000000000;
+        spec.it_value.tv_nsec = ns % 1000000000;
+    }
+
+    if (posix_timerfd_settime(m_timerfd.get(), 0, &spec, nullptr) == 0)
+        m_armed = expiry == never ? 0 : expiry;
+}
+
+/**
+ * @brief Redistribute the timers in a slot of a coarse wheel among the finer
+ *        wheels, now that they are due within that slot's span
+ *
+ * @param level The wheel
+ * @param index The slot
+ */
+void timer_wheel::cascade(std::size_t level, std::size_t index) {
+    const std::size_t slot = level * slots_per_level + index;
+
+    std::uint32_t i = m_heads[slot];
+
+    m_heads[slot] = npos;
+    m_occupied[level][index / 64] &= ~(std::uint64_t(1) << (index % 64));
+
+    while (i != npos) {
+        const std::uint32_t next = m_nodes[i].next;
+        link(i);
+        i = next;
+    }
+}
+
+/**
+ * @brief Look up a pending timer
+ *
+ * @param id The timer
+ *
+ * @return The index of its node, or npos if it is not pending
+ */
+std::uint32_t timer_wheel::find(timer_id id) const noexcept {
+    const auto index      = static_cast<std::uint32_t>(id);
+    const auto generation = static_cast<std::uint32_t>(id >> 32);
+
+    if (index >= m_nodes.size()) return npos;
+
+    const timer_node& node = m_nodes[index];
+    if (node.slot == npos || node.generation != generation) return npos;
+
+    return index;
+}
+
+/**
+ * @brief Return an unlinked node to the free list
+ *
+ * @param index The node
+ */
+void timer_wheel::free_node(std::uint32_t index) noexcept {
+    timer_node& node = m_nodes[index];
+
+    node.callback = nullptr;
+    node.slot     = npos;
+
+    // Invalidate outstanding identifiers. Generation 0 is never issued, so
+    // that no identifier equals invalid_timer
+    if (++node.generation == 0) node.generation = 1;
+
+    node.next = m_free;
+    m_free = index;
+}
+
+/**
+ * @brief Add a node to the slot for its expiration
+ *
+ * @param index The node, which must not be in any slot
+ */
+void timer_wheel::link(std::uint32_t index) {
+    timer_node& node = m_nodes[index];
+
+    std::uint64_t when  = std::max(node.expires, m_now);
+    std::uint64_t delta = when - m_now;
+
+    std::size_t level = 0;
+    while (level + 1 < levels &&
+           delta >= (std::uint64_t(1) << (bits_per_level * (level + 1)))) {
+        level++;
+    }
+
+    // Timers beyond the span of the coarsest wheel are parked at its far end,
+    // and cascade back into it until they come within range
+    constexpr std::uint64_t span = std::uint64_t(1) << (bits_per_level*levels);
+    if (delta >= span) when = m_now + span - 1;
+
+    const std::size_t slot_index =
+        (when >> (bits_per_level * level)) % slots_per_level;
+    const std::uint32_t slot =
+        static_cast<std::uint32_t>(level * slots_per_level + slot_index);
+
+    node.slot = slot;
+    node.prev = npos;
+    node.next = m_heads[slot];
+
+    if (node.next != npos) m_nodes[node.next].prev = index;
+    m_heads[slot] = index;
+
+    m_occupied[level][slot_index / 64] |=
+        std::uint64_t(1) << (slot_index % 64);
+}
+
+/**
+ * @brief Get the earliest tick at which advance() has work to do, i.e. a
+ *        timer expires or a coarse wheel must be cascaded
+ *
+ * @return The tick, or \ref never if there are no timers
+ */
+std::uint64_t timer_wheel::next_expiry() const noexcept {
+    if (m_size == 0) return never;
+
+    std::uint64_t expiry = never;
+
+    const std::size_t distance =
+        distance_to_set_bit(m_occupied[0], m_now % slots_per_level);
+
+    if (distance < slots_per_level) expiry = m_now + distance;
+
+    // A coarse wheel is cascaded when the finer wheels below it wrap. Find
+    // the first such time at which one of its occupied slots is reached
+    for (std::size_t level = 1; level < levels; level++) {
+        const unsigned int shift = bits_per_level * level;
+        const std::uint64_t span = std::uint64_t(1) << shift;
+
+        const std::uint64_t wrap = (m_now + span - 1) & ~(span - 1);
+
+        const std::size_t distance = distance_to_set_bit(
+            m_occupied[level], (wrap >> shift) % slots_per_level);
+
+        if (distance < slots_per_level)
+            expiry = std::min(expiry, wrap + distance * span);
+    }
+
+    // Timers whose callbacks are running are not in any wheel
+    return expiry == never ? m_now : expiry;
+}
+
+/**
+ * @brief Convert a time to a tick count
+ *
+ * @param now The time
+ *
+ * @return The number of whole ticks from the start of the wheel to \a now
+ */
+std::uint64_t timer_wheel::to_ticks(clock::time_point now) const noexcept {
+    if (now <= m_start) return 0;
+
+    return static_cast<std::uint64_t>((now - m_start) / m_tick);
+}
+
+/**
+ * @brief Remove a node from its slot
+ *
+ * @param index The node
+ */
+void timer_wheel::unlink(std::uint32_t index) noexcept {
+    timer_node& node = m_nodes[index];
+
+    if (node.prev != npos) {
+        m_nodes[node.prev].next = node.next;
+    } else {
+        m_heads[node.slot] = node.next;
+
+        // The list of expiring timers has no occupancy bit
+        if (node.next == npos && node.slot < levels * slots_per_level) {
+            const std::size_t level = node.slot / slots_per_level;
+            const std::size_t slot  = node.slot % slots_per_level;
+
+            m_occupied[level][slot / 64] &= ~(std::uint64_t(1) << (slot % 64));
+        }
+    }
+
+    if (node.next != npos) m_nodes[node.next].prev = node.prev;
+
+    node.prev = node.next = npos;
+}
+
+}  // namespace jfern
@@ -10,13 +10,11 @@
 
 #include <utility>
 
-#include "networking/file_descriptor.h"
-
 namespace jfern {
 /**
  * Default constructor
  */
-unique_fd::unique_fd() : m_blocking(false), m_fd(-1) {
+unique_fd::unique_fd() : m_fd() {
 }
 
 /**
@@ -24,7 +22,7 @@ unique_fd::unique_fd() : m_blocking(false), m_fd(-1) {
  *
  * @param [in] fd A raw file descriptor
  */
-unique_fd::unique_fd(int fd) : m_blocking(false), m_fd(fd) {
+unique_fd::unique_fd(int fd) : m_fd(fd) {
 }
 
 /**
@@ -32,16 +30,13 @@ unique_fd::unique_fd(int fd) : m_blocking(false), m_fd(fd) {
  *
  * @param[in] fd The file descriptor to take ownership of
  */
-unique_fd::unique_fd(unique_fd&& fd) {
-    *this = std::move(fd);
+unique_fd::unique_fd(unique_fd&& fd) : m_fd(std::move(fd.m_fd)) {
 }
 
 /**
  * Destructor
  */
 unique_fd::~unique_fd() {
-    if (*this) file_descriptor::close(m_fd);
-    m_fd = -1;
 }
 
 /**
@@ -54,11 +49,7 @@ unique_fd::~unique_fd() {
  * @return *this
  */
 unique_fd& unique_fd::operator=(unique_fd&& fd) {
-    if (this != &fd) {
-        m_blocking = fd.m_blocking;
-
-        m_fd = fd.m_fd; fd.m_fd = -1;
-    }
+    if (this != &fd) m_fd = std::move(fd.m_fd);
 
     return *this;
 }
@@ -67,28 +58,28 @@ unique_fd& unique_fd::operator=(unique_fd&& fd) {
  * @see See fd_interface::operator bool()
  */
 unique_fd::operator bool() const noexcept {
-    return 0 <= m_fd;
+    return static_cast<bool>(m_fd);
 }
 
 /**
  * @see See fd_interface::get()
  */
 int unique_fd::get() const noexcept {
-    return m_fd;
+    return m_fd.get();
 }
 
 /**
  * @see See fd_interface::is_blocking()
  */
 bool unique_fd::is_blocking() const noexcept {
-    return m_blocking;
+    return m_fd.is_blocking();
 }
 
 /**
  * @see See fd_interface::poll()
  */
 int unique_fd::poll(short events) noexcept {
-    return file_descriptor::poll(m_fd, events, 0);
+    return m_fd.poll(events);
 }
 
 /**
@@ -106,7 +97,7 @@ int unique_fd::poll(short events,
  * @see See fd_interface::poll()
  */
 int unique_fd::poll(short events, int timeout) noexcept {
-    return file_descriptor::poll(m_fd, events, timeout);
+    return m_fd.poll(events, timeout);
 }
 
 /**
@@ -127,26 +118,21 @@ int unique_fd::poll(short events, int timeout,
  * @return The file descriptor we were managing
  */
 int unique_fd::release() {
-    const int fd = m_fd; m_fd = -1;
-
-    return fd;
+    return m_fd.release();
 }
 
 /**
  * @see See fd_interface::reset()
  */
 bool unique_fd::reset(int fd) noexcept {
-    if (*this) file_descriptor::close(m_fd);
-    m_fd = fd;
-
-    return file_descriptor::set_blocking(m_fd, m_blocking);
+    return m_fd.reset(fd);
 }
 
 /**
  * @see See fd_interface::set_blocking()
  */
 bool unique_fd::set_blocking(bool enable) noexcept {
-    return file_descriptor::set_blocking(m_fd, enable);
+    return m_fd.set_blocking(enable);
 }
 
 /**
@@ -155,14 +141,7 @@ bool unique_fd::set_blocking(bool enable) noexcept {
  * @param[in,out] fd The \ref unique_fd to swap with
  */
 void unique_fd::swap(unique_fd& fd) noexcept {
-    const int temp_fd = m_fd;
-    const bool temp_blocking = m_blocking;
-
-    m_blocking = fd.m_blocking;
-    m_fd = fd.m_fd;
-
-    fd.m_blocking = temp_blocking;
-    fd.m_fd = temp_fd;
+    m_fd.swap(fd.m_fd);
 }
 
 }  // namespace jfern
@@ -0,0 +1,199 @@
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "networking/basic_fd_event_sink.h"
+#include "networking/basic_shared_fd.h"
+#include "networking/basic_unique_fd.h"
+#include "networking/data_buffer.h"
+
+namespace {
+static_assert(!std::is_polymorphic<jfern::basic_unique_fd>::value,
+              "basic_unique_fd must not have a vtable");
+static_assert(!std::is_polymorphic<jfern::basic_shared_fd>::value,
+              "basic_shared_fd must not have a vtable");
+static_assert(!std::is_polymorphic<jfern::input_buffer<8>>::value &&
+              !std::is_polymorphic<jfern::output_buffer<8>>::value,
+              "data buffers must not have a vtable");
+static_assert(sizeof(jfern::basic_unique_fd) == 2 * sizeof(int),
+              "basic_unique_fd must hold only its descriptor and flag");
+
+class BasicFdTest : public testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(::pipe(m_fds), 0);
+    }
+
+    void TearDown() override {
+        // The read end is owned by the file descriptors under test
+        ::close(m_fds[1]);
+    }
+
+    int m_fds[2];
+};
+
+TEST_F(BasicFdTest, unique_fd_closes_once) {
+    {
+        jfern::basic_unique_fd fd(m_fds[0]);
+        ASSERT_TRUE(fd);
+
+        jfern::basic_unique_fd moved(std::move(fd));
+        EXPECT_FALSE(fd);
+        EXPECT_EQ(moved.get(), m_fds[0]);
+    }
+
+    EXPECT_EQ(::fcntl(m_fds[0], F_GETFD), -1);
+}
+
+TEST_F(BasicFdTest, unique_fd_poll_with_handler) {
+    jfern::basic_unique_fd fd(m_fds[0]);
+
+    int n_calls = 0;
+    auto handler = [&](short revents, jfern::basic_unique_fd& ready) {
+        EXPECT_EQ(&ready, &fd);
+        EXPECT_EQ(revents & POLLIN, 0);
+        n_calls++;
+    };
+
+    EXPECT_EQ(fd.poll(POLLIN, handler), 0);
+    EXPECT_EQ(n_calls, 1);
+
+    ASSERT_EQ(::write(m_fds[1], "x", 1), 1);
+
+    EXPECT_EQ(fd.poll(POLLIN, 0, [&](short revents, jfern::basic_unique_fd&) {
+        EXPECT_NE(revents & POLLIN, 0);
+        n_calls++;
+    }), POLLIN);
+    EXPECT_EQ(n_calls, 2);
+
+    // The plain overload is still chosen for an int timeout
+    EXPECT_EQ(fd.poll(POLLIN, 0), POLLIN);
+}
+
+TEST_F(BasicFdTest, shared_fd_shares_ownership) {
+    {
+        jfern::basic_shared_fd fd(m_fds[0]);
+
+        {
+            jfern::basic_shared_fd copy(fd);
+            EXPECT_EQ(copy.get(), m_fds[0]);
+            EXPECT_EQ(fd.use_count(), 2u);
+        }
+
+        EXPECT_EQ(fd.use_count(), 1u);
+
+        ASSERT_EQ(::write(m_fds[1], "x", 1), 1);
+
+        int n_calls = 0;
+        EXPECT_EQ(fd.poll(POLLIN, [&](short revents, jfern::basic_shared_fd&) {
+            EXPECT_NE(revents & POLLIN, 0);
+            n_calls++;
+        }), POLLIN);
+        EXPECT_EQ(n_calls, 1);
+    }
+
+    EXPECT_EQ(::fcntl(m_fds[0], F_GETFD), -1);
+}
+
+TEST_F(BasicFdTest, event_sink_dispatch) {
+    int in_calls = 0, out_calls = 0;
+
+    auto handler = [&](short revents, jfern::basic_unique_fd&) {
+        if (revents & POLLIN)  in_calls++;
+        if (revents & POLLOUT) out_calls++;
+    };
+
+    jfern::basic_fd_event_sink<jfern::basic_unique_fd, decltype(handler)>
+        sink{jfern::basic_unique_fd(m_fds[0])};
+
+    EXPECT_EQ(sink.get(), m_fds[0]);
+    EXPECT_FALSE(sink.add_events(0, handler));
+
+    ASSERT_TRUE(sink.add_events(POLLIN, handler));
+    ASSERT_TRUE(sink.add_events(POLLOUT, handler));
+
+    EXPECT_EQ(sink.events(), POLLIN | POLLOUT);
+
+    sink.handle_events(POLLIN);
+    EXPECT_EQ(in_calls, 1);
+    EXPECT_EQ(out_calls, 0);
+
+    sink.remove_events(POLLIN);
+    EXPECT_EQ(sink.events(), POLLOUT);
+
+    sink.handle_events(POLLIN);
+    EXPECT_EQ(in_calls, 1);
+
+    sink.handle_events(POLLOUT);
+    EXPECT_EQ(out_calls, 1);
+
+    sink.clear_events();
+    EXPECT_EQ(sink.events(), 0);
+}
+
+TEST_F(BasicFdTest, event_sink_handler_changes_own_sink) {
+    using handler_t = std::function<void(short, jfern::basic_unique_fd&)>;
+
+    jfern::basic_fd_event_sink<jfern::basic_unique_fd, handler_t>
+        sink{jfern::basic_unique_fd(m_fds[0])};
+
+    auto token = std::make_shared<int>(42);
+    std::vector<int> order;
+
+    // A handler which fills every other event bit and then replaces itself,
+    // touching its own captures after both
+    ASSERT_TRUE(sink.add_events(0x1, [&, token](short,
+                                                jfern::basic_unique_fd&) {
+        for (int bit = 1; bit < 16; bit++) {
+            sink.add_events(static_cast<short>(1u << bit),
+                            [&order, bit](short, jfern::basic_unique_fd&) {
+                order.push_back(bit);
+            });
+        }
+
+        sink.add_events(0x1, [&order](short, jfern::basic_unique_fd&) {
+            order.push_back(0);
+        });
+
+        order.push_back(*token);
+    }));
+
+    EXPECT_EQ(token.use_count(), 2);
+
+    sink.handle_events(static_cast<short>(0xffff));
+
+    // Handlers added during dispatch wait for the next one, and the replaced
+    // handler is destroyed once it returns
+    EXPECT_EQ(order, std::vector<int>({42}));
+    EXPECT_EQ(token.use_count(), 1);
+    EXPECT_EQ(sink.events(), static_cast<short>(0xffff));
+
+    order.clear();
+    sink.handle_events(0x5);
+    std::sort(order.begin(), order.end());
+    EXPECT_EQ(order, std::vector<int>({0, 2}));
+
+    // A handler which removes every event, itself included
+    ASSERT_TRUE(sink.add_events(0x1, [&, token](short,
+                                                jfern::basic_unique_fd&) {
+        sink.clear_events();
+        order.push_back(*token);
+    }));
+
+    order.clear();
+    sink.handle_events(static_cast<short>(0xffff));
+
+    EXPECT_EQ(order, std::vector<int>({42}));
+    EXPECT_EQ(token.use_count(), 1);
+    EXPECT_EQ(sink.events(), 0);
+}
+
+}  // namespace
@@ -0,0 +1,146 @@
+/**
+ *  \file   chain_buffer-ut.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "networking/buffer_pool.h"
+#include "networking/chain_buffer.h"
+#include "networking/iovec_builder.h"
+
+namespace {
+class ChainBufferTest : public testing::Test {
+protected:
+    ChainBufferTest() : m_pool(8) {}
+
+    jfern::buffer_pool m_pool;
+};
+
+TEST_F(ChainBufferTest, grows_across_blocks) {
+    jfern::chain_buffer buffer(m_pool);
+
+    EXPECT_EQ(buffer.capacity(), 0u);
+
+    // Each element straddles a block boundary at some point
+    for (std::uint32_t i = 0; i < 100; i++) {
+        ASSERT_TRUE(buffer.write(i, true));
+        ASSERT_TRUE(buffer.write(std::uint8_t(i), false));
+    }
+
+    EXPECT_EQ(buffer.size(), 500u);
+    EXPECT_EQ(buffer.tell(), 500u);
+    EXPECT_EQ(buffer.capacity(), 504u);
+    EXPECT_EQ(buffer.segments(), 63u);
+
+    buffer.rewind();
+
+    for (std::uint32_t i = 0; i < 100; i++) {
+        std::uint32_t value;
+        std::uint8_t  byte;
+        ASSERT_TRUE(buffer.read(&value, true));
+        ASSERT_TRUE(buffer.read(&byte, false));
+
+        EXPECT_EQ(value, i);
+        EXPECT_EQ(byte, static_cast<std::uint8_t>(i));
+    }
+
+    std::uint8_t byte;
+    EXPECT_FALSE(buffer.read(&byte, false));
+}
+
+TEST_F(ChainBufferTest, seek) {
+    jfern::chain_buffer buffer(m_pool);
+
+    ASSERT_TRUE(buffer.write(std::uint16_t(0), false));
+    ASSERT_TRUE(buffer.write(
+        reinterpret_cast<const std::uint8_t*>("0123456789"), 10));
+
+    // Back-fill a length prefix
+    ASSERT_TRUE(buffer.seek_absolute(0));
+    ASSERT_TRUE(buffer.write(std::uint16_t(10), false));
+    EXPECT_EQ(buffer.size(), 12u);
+
+    EXPECT_FALSE(buffer.seek_absolute(13));
+    EXPECT_FALSE(buffer.seek(-3));
+    EXPECT_TRUE(buffer.seek(10));
+    EXPECT_FALSE(buffer.seek(1));
+    EXPECT_TRUE(buffer.seek(-12));
+
+    std::uint16_t length;
+    ASSERT_TRUE(buffer.read(&length, false));
+    EXPECT_EQ(length, 10u);
+
+    EXPECT_TRUE(buffer.seek(7));
+    std::uint8_t digits[3];
+    ASSERT_TRUE(buffer.read(digits, 3));
+    EXPECT_EQ(std::memcmp(digits, "789", 3), 0);
+}
+
+TEST_F(ChainBufferTest, blocks_return_to_pool) {
+    {
+        jfern::chain_buffer buffer(m_pool);
+        ASSERT_TRUE(buffer.reserve(20));
+        EXPECT_EQ(buffer.capacity(), 24u);
+        EXPECT_EQ(buffer.size(), 0u);
+
+        jfern::chain_buffer moved(std::move(buffer));
+        EXPECT_EQ(moved.capacity(), 24u);
+        EXPECT_EQ(buffer.capacity(), 0u);
+    }
+
+    EXPECT_EQ(m_pool.available(), 3u);
+
+    // Blocks are reused rather than allocated
+    jfern::chain_buffer buffer(m_pool);
+    ASSERT_TRUE(buffer.write(std::uint64_t(1), false));
+    EXPECT_EQ(m_pool.available(), 2u);
+
+    buffer.clear();
+    EXPECT_EQ(m_pool.available(), 3u);
+    EXPECT_EQ(buffer.size(), 0u);
+}
+
+TEST_F(ChainBufferTest, vectored_write) {
+    jfern::chain_buffer buffer(m_pool);
+
+    const char message[] = "a message spanning several blocks";
+    const std::size_t length = sizeof(message) - 1;
+
+    ASSERT_TRUE(buffer.write(
+        reinterpret_cast<const std::uint8_t*>(message), length));
+
+    jfern::iovec_builder<8> iov;
+    ASSERT_TRUE(buffer.append_to(iov));
+    EXPECT_EQ(iov.size(), buffer.segments());
+    EXPECT_EQ(iov.bytes(), length);
+
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+
+    EXPECT_EQ(iov.write_to(fds[1]), static_cast<ssize_t>(length));
+
+    std::vector<char> received(length);
+    EXPECT_EQ(::read(fds[0], received.data(), length),
+              static_cast<ssize_t>(length));
+    EXPECT_EQ(std::memcmp(received.data(), message, length), 0);
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+
+    // Too many segments for the builder
+    jfern::iovec_builder<2> small;
+    EXPECT_FALSE(buffer.append_to(small));
+    EXPECT_EQ(small.bytes(), 16u);
+}
+
+}  // namespace
@@ -0,0 +1,97 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "networking/data_buffer.h"
+
+namespace {
+TEST(data_buffer, reserve) {
+    jfern::output_buffer<8> buffer;
+
+    EXPECT_TRUE(buffer.reserve(0));
+    EXPECT_TRUE(buffer.reserve(8));
+    EXPECT_FALSE(buffer.reserve(9));
+
+    ASSERT_TRUE(buffer.seek_absolute(6));
+
+    EXPECT_TRUE(buffer.reserve(2));
+    EXPECT_FALSE(buffer.reserve(3));
+
+    ASSERT_TRUE(buffer.seek_absolute(8));
+
+    EXPECT_TRUE(buffer.reserve(0));
+    EXPECT_FALSE(buffer.reserve(1));
+
+    // Checking does not move the buffer pointer
+    EXPECT_EQ(buffer.tell(), 8u);
+}
+
+TEST(data_buffer, require) {
+    jfern::input_buffer<8> buffer;
+
+    EXPECT_TRUE(buffer.require(8));
+    EXPECT_FALSE(buffer.require(9));
+
+    ASSERT_TRUE(buffer.seek_absolute(5));
+
+    EXPECT_TRUE(buffer.require(3));
+    EXPECT_FALSE(buffer.require(4));
+
+    EXPECT_EQ(buffer.tell(), 5u);
+}
+
+TEST(data_buffer, write_unchecked) {
+    jfern::output_buffer<15> buffer;
+
+    ASSERT_TRUE(buffer.reserve(15));
+
+    buffer.write_unchecked<true >(std::uint8_t(0x01));
+    buffer.write_unchecked<true >(std::uint16_t(0x0203));
+    buffer.write_unchecked<false>(std::uint32_t(0x04050607));
+    buffer.write_unchecked<true >(std::uint64_t(0x08090a0b0c0d0e0f));
+
+    EXPECT_EQ(buffer.tell(), 15u);
+
+    // The checked interface produces the same bytes
+    jfern::output_buffer<15> checked;
+
+    ASSERT_TRUE(checked.write(std::uint8_t(0x01), true));
+    ASSERT_TRUE(checked.write(std::uint16_t(0x0203), true));
+    ASSERT_TRUE(checked.write(std::uint32_t(0x04050607), false));
+    ASSERT_TRUE(checked.write(std::uint64_t(0x08090a0b0c0d0e0f), true));
+
+    for (std::size_t i = 0; i < 15; i++) {
+        EXPECT_EQ(buffer.data()[i], checked.data()[i]) << "i = " << i;
+    }
+}
+
+TEST(data_buffer, read_unchecked) {
+    jfern::output_buffer<14> output;
+
+    ASSERT_TRUE(output.write(std::uint16_t(0x0102), true));
+    ASSERT_TRUE(output.write(std::uint32_t(0x03040506), false));
+    ASSERT_TRUE(output.write(std::uint64_t(0x0708090a0b0c0d0e), true));
+
+    jfern::input_buffer<14> input;
+    std::memcpy(input.data(), output.data(), output.size());
+
+    ASSERT_TRUE(input.require(14));
+
+    std::uint16_t valueU16 = 0;
+    std::uint32_t valueU32 = 0;
+    std::uint64_t valueU64 = 0;
+
+    input.read_unchecked<true >(&valueU16);
+    input.read_unchecked<false>(&valueU32);
+    input.read_unchecked<true >(&valueU64);
+
+    EXPECT_EQ(valueU16, 0x0102u);
+    EXPECT_EQ(valueU32, 0x03040506u);
+    EXPECT_EQ(valueU64, 0x0708090a0b0c0d0eu);
+
+    EXPECT_EQ(input.tell(), 14u);
+    EXPECT_FALSE(input.require(1));
+}
+
+}  // namespace
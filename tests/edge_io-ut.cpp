@@ -0,0 +1,116 @@
+/**
+ *  \file   edge_io-ut.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "fd_test_helpers.h"
+#include "networking/edge_io.h"
+#include "networking/unique_fd.h"
+
+namespace {
+using EdgeIoTest = pipe_test<>;
+
+TEST_F(EdgeIoTest, read_until_would_block) {
+    const std::vector<std::uint8_t> data(100, 0x5a);
+    ASSERT_EQ(::write(m_write_end.get(), data.data(), data.size()), 100);
+
+    jfern::edge_io io(m_read_end, 1000);
+
+    std::vector<std::uint8_t> buf(256);
+    EXPECT_EQ(io.read(buf.data(), buf.size()), 100);
+
+    EXPECT_TRUE(io.read_blocked());
+    EXPECT_FALSE(io.eof());
+    EXPECT_EQ(io.pending(), 0);
+    EXPECT_EQ(io.remaining(), 900u);
+}
+
+TEST_F(EdgeIoTest, read_budget) {
+    const std::vector<std::uint8_t> data(100, 0x5a);
+    ASSERT_EQ(::write(m_write_end.get(), data.data(), data.size()), 100);
+
+    jfern::edge_io io(m_read_end, 30);
+
+    std::vector<std::uint8_t> buf(256);
+    EXPECT_EQ(io.read(buf.data(), buf.size()), 30);
+
+    EXPECT_TRUE(io.exhausted());
+    EXPECT_FALSE(io.read_blocked());
+    EXPECT_EQ(io.pending(), POLLIN);
+
+    // Nothing more may be read during this wakeup
+    EXPECT_EQ(io.read(buf.data(), buf.size()), 0);
+    EXPECT_EQ(io.pending(), POLLIN);
+}
+
+TEST_F(EdgeIoTest, read_eof) {
+    const std::uint8_t byte = 1;
+    ASSERT_EQ(::write(m_write_end.get(), &byte, 1), 1);
+
+    m_write_end.reset(-1);
+
+    jfern::edge_io io(m_read_end, 1000);
+
+    std::uint8_t buf[8];
+    EXPECT_EQ(io.read(buf, sizeof(buf)), 1);
+
+    EXPECT_TRUE(io.eof());
+    EXPECT_EQ(io.pending(), 0);
+}
+
+TEST_F(EdgeIoTest, write_budget) {
+    const std::vector<std::uint8_t> data(100, 0x5a);
+
+    jfern::edge_io io(m_write_end, 60);
+
+    EXPECT_EQ(io.write(data.data(), data.size()), 60);
+    EXPECT_EQ(io.pending(), POLLOUT);
+    EXPECT_FALSE(io.write_blocked());
+}
+
+TEST_F(EdgeIoTest, write_until_would_block) {
+    const std::vector<std::uint8_t> data(1 << 20, 0x5a);
+
+    jfern::edge_io io(m_write_end, data.size());
+
+    const ssize_t n = io.write(data.data(), data.size());
+    EXPECT_GT(n, 0);
+    EXPECT_LT(n, static_cast<ssize_t>(data.size()));
+
+    EXPECT_TRUE(io.write_blocked());
+    EXPECT_EQ(io.pending(), 0);
+}
+
+TEST_F(EdgeIoTest, zero_length) {
+    const std::vector<std::uint8_t> data(100, 0x5a);
+    ASSERT_EQ(::write(m_write_end.get(), data.data(), data.size()), 100);
+
+    // A handler whose buffer is full asks for nothing, which must not leave
+    // the descriptor marked undrained and so be dispatched again forever
+    jfern::edge_io in(m_read_end, 1000);
+
+    std::uint8_t buf[1];
+    EXPECT_EQ(in.read(buf, 0), 0);
+    EXPECT_EQ(in.pending(), 0);
+    EXPECT_EQ(in.remaining(), 1000u);
+
+    // ...nor forget output left over from an earlier write
+    jfern::edge_io out(m_write_end, 60);
+
+    EXPECT_EQ(out.write(data.data(), data.size()), 60);
+    EXPECT_EQ(out.write(data.data(), 0), 0);
+    EXPECT_EQ(out.pending(), POLLOUT);
+}
+
+}  // namespace
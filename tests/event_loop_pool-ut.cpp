@@ -0,0 +1,211 @@
+/**
+ *  \file   event_loop_pool-ut.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "fd_test_helpers.h"
+#include "networking/event_loop_pool.h"
+#include "networking/fd_event_sink.h"
+#include "networking/unique_fd.h"
+
+namespace {
+/**
+ * Wait for a condition to become true
+ *
+ * @param[in] condition The condition
+ *
+ * @return True if \a condition became true within a few seconds
+ */
+bool wait_for(const std::function<bool()>& condition) {
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return true;
+}
+
+/**
+ * A handler which drains a pipe and counts its wakeups
+ */
+auto counting_handler(std::atomic<int>* n_calls) {
+    return [n_calls](short, jfern::fd_interface& fd) {
+        char buf[64];
+        while (::read(fd.get(), buf, sizeof(buf)) > 0) {}
+        (*n_calls)++;
+    };
+}
+
+TEST(event_loop_pool, least_loaded) {
+    jfern::event_loop_pool pool(2);
+    ASSERT_TRUE(pool);
+    EXPECT_EQ(pool.size(), 2u);
+
+    std::array<pipe_sink, 4> pipes;
+    std::array<int, 2> assigned = {0, 0};
+
+    for (pipe_sink& pipe : pipes) {
+        ASSERT_TRUE(pipe.sink->add_events(POLLIN,
+                                          [](short, jfern::fd_interface&) {}));
+
+        const int index = pool.add(pipe.sink);
+        ASSERT_GE(index, 0);
+        assigned[index]++;
+    }
+
+    EXPECT_EQ(assigned[0], 2);
+    EXPECT_EQ(assigned[1], 2);
+    EXPECT_EQ(pool.load(0), 2u);
+    EXPECT_EQ(pool.load(1), 2u);
+
+    EXPECT_EQ(pool.add(pipes[0].sink), -1);
+    EXPECT_EQ(pool.add(nullptr), -1);
+
+    EXPECT_TRUE(pool.remove(pipes[0].sink->get()));
+    EXPECT_FALSE(pool.remove(pipes[0].sink->get()));
+    EXPECT_EQ(pool.load(0) + pool.load(1), 3u);
+
+    // The freed slot is reused
+    EXPECT_GE(pool.add(pipes[0].sink), 0);
+    EXPECT_EQ(pool.load(0), 2u);
+    EXPECT_EQ(pool.load(1), 2u);
+}
+
+TEST(event_loop_pool, dispatch) {
+    jfern::event_loop_pool pool(2);
+    ASSERT_TRUE(pool);
+
+    pipe_sink pipe;
+
+    std::atomic<int> n_calls(0);
+    std::atomic<bool> on_loop(false);
+
+    ASSERT_TRUE(pipe.sink->add_events(POLLIN,
+        [&](short revents, jfern::fd_interface& fd) {
+            on_loop = jfern::event_loop_pool::this_loop() != nullptr;
+            counting_handler(&n_calls)(revents, fd);
+        }));
+
+    const int index = pool.add(pipe.sink);
+    ASSERT_GE(index, 0);
+    EXPECT_EQ(jfern::event_loop_pool::this_loop(), nullptr);
+
+    pipe.signal();
+    EXPECT_TRUE(wait_for([&]() { return n_calls == 1; }));
+    EXPECT_TRUE(on_loop);
+
+    ASSERT_TRUE(pool.remove(pipe.sink->get()));
+
+    // Once removal has been processed, events are no longer dispatched
+    std::atomic<bool> removed(false);
+    ASSERT_TRUE(pool.post(index, [&removed]() { removed = true; }));
+    ASSERT_TRUE(wait_for([&]() { return removed.load(); }));
+
+    pipe.signal();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(n_calls, 1);
+}
+
+TEST(event_loop_pool, post) {
+    jfern::event_loop_pool pool(2);
+    ASSERT_TRUE(pool);
+
+    std::mutex mutex;
+    std::vector<int> order;
+    std::thread::id thread;
+
+    for (int i = 0; i < 100; i++) {
+        ASSERT_TRUE(pool.post(1, [&, i]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(i);
+            thread = std::this_thread::get_id();
+        }));
+    }
+
+    EXPECT_FALSE(pool.post(2, []() {}));
+    EXPECT_FALSE(pool.post(0, nullptr));
+
+    ASSERT_TRUE(wait_for([&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return order.size() == 100;
+    }));
+
+    for (int i = 0; i < 100; i++) EXPECT_EQ(order[i], i);
+    EXPECT_NE(thread, std::this_thread::get_id());
+}
+
+TEST(event_loop_pool, work_stealing) {
+    jfern::event_loop_pool pool(2);
+    ASSERT_TRUE(pool);
+
+    std::atomic<bool> released(false), finished(false);
+
+    // From loop 0, spawn a task which releases a slow one spawned after it.
+    // If loop 0 runs the newest (slow) task first, the slow task only
+    // finishes if loop 1 steals the other
+    ASSERT_TRUE(pool.post(0, [&]() {
+        pool.spawn([&]() { released = true; });
+
+        pool.spawn([&]() {
+            finished = wait_for([&]() { return released.load(); });
+        });
+    }));
+
+    ASSERT_TRUE(wait_for([&]() { return finished.load(); }));
+}
+
+TEST(event_loop_pool, readiness_during_continuation) {
+    jfern::event_loop_pool pool(2);
+    ASSERT_TRUE(pool);
+
+    std::array<pipe_sink, 2> pipes;
+    std::atomic<int> n_calls(0);
+    std::atomic<bool> release(false), done(false);
+
+    for (pipe_sink& pipe : pipes) {
+        ASSERT_TRUE(pipe.sink->add_events(POLLIN, counting_handler(&n_calls)));
+        ASSERT_GE(pool.add(pipe.sink), 0);
+    }
+
+    // A long-running continuation occupies one loop...
+    ASSERT_TRUE(pool.spawn([&]() {
+        wait_for([&]() { return release.load(); });
+        done = true;
+    }));
+
+    // ...while events keep being dispatched on the other
+    for (int i = 0; i < 10; i++) {
+        pipes[0].signal();
+        pipes[1].signal();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    EXPECT_TRUE(wait_for([&]() { return n_calls >= 10; }));
+
+    release = true;
+    EXPECT_TRUE(wait_for([&]() { return done.load(); }));
+}
+
+}  // namespace
@@ -68,6 +68,41 @@ TEST(fd_event_sink, invalid_events) {
     ASSERT_TRUE(sink.add_events(1, [](short, jfern::fd_interface& ) {}));
 }
 
+TEST(fd_event_sink, edge_triggered) {
+    auto fd = std::make_unique<fd_interface_mock>();
+
+    jfern::fd_event_sink sink(std::move(fd));
+
+    ASSERT_FALSE(sink.add_edge_events(1, nullptr));
+    ASSERT_FALSE(sink.add_edge_events(0, [](short, jfern::edge_io& ) {}));
+
+    ASSERT_TRUE(sink.add_events(1, [](short, jfern::fd_interface& ) {}));
+    EXPECT_FALSE(sink.edge_triggered());
+
+    // The level-triggered handler would miss wakeups under EPOLLET
+    EXPECT_FALSE(sink.add_edge_events(2, [](short, jfern::edge_io& ) {}));
+    EXPECT_FALSE(sink.edge_triggered());
+    EXPECT_EQ(sink.events(), 1);
+
+    // ...unless it is replaced
+    ASSERT_TRUE(sink.add_edge_events(3, [](short, jfern::edge_io& ) {}));
+    EXPECT_TRUE(sink.edge_triggered());
+    EXPECT_EQ(sink.events(), 3);
+
+    EXPECT_FALSE(sink.add_events(2, [](short, jfern::fd_interface& ) {}));
+    EXPECT_TRUE(sink.edge_triggered());
+    EXPECT_EQ(sink.events(), 3);
+
+    // Replacing the edge handler reverts to level triggering
+    ASSERT_TRUE(sink.add_events(3, [](short, jfern::fd_interface& ) {}));
+    EXPECT_FALSE(sink.edge_triggered());
+    EXPECT_EQ(sink.events(), 3);
+
+    EXPECT_EQ(sink.budget(), jfern::fd_event_sink::default_budget);
+    sink.set_budget(10);
+    EXPECT_EQ(sink.budget(), 10u);
+}
+
 TEST_F(FdEventSinkTest, single_bit_events) {
     auto fd = std::make_unique<fd_interface_mock>();
 
@@ -110,4 +145,175 @@ TEST_F(FdEventSinkTest, single_bit_events) {
     // Replace events
 }
 
+TEST(fd_event_sink, newest_handler_wins) {
+    jfern::fd_event_sink sink(
+        std::make_unique<testing::NiceMock<fd_interface_mock>>());
+
+    std::vector<int> calls;
+
+    ASSERT_TRUE(sink.add_events(0x3, [&](short, jfern::fd_interface&) {
+        calls.push_back(1);
+    }));
+    ASSERT_TRUE(sink.add_events(0x2, [&](short, jfern::fd_interface&) {
+        calls.push_back(2);
+    }));
+
+    EXPECT_EQ(sink.events(), 0x3);
+
+    sink.handle_events(0x1);
+    sink.handle_events(0x2);
+    EXPECT_EQ(calls, (std::vector<int>{1, 2}));
+
+    // The first handler loses its last event and is dropped
+    ASSERT_TRUE(sink.add_events(0x1, [&](short, jfern::fd_interface&) {
+        calls.push_back(3);
+    }));
+
+    calls.clear();
+    sink.handle_events(0x3);
+
+    std::sort(calls.begin(), calls.end());
+    EXPECT_EQ(calls, (std::vector<int>{2, 3}));
+
+    sink.remove_events(0x2);
+    EXPECT_EQ(sink.events(), 0x1);
+
+    calls.clear();
+    sink.handle_events(0x3);
+    EXPECT_EQ(calls, (std::vector<int>{3}));
+}
+
+TEST(fd_event_sink, handler_called_once_per_dispatch) {
+    jfern::fd_event_sink sink(
+        std::make_unique<testing::NiceMock<fd_interface_mock>>());
+
+    int n_calls = 0;
+    short received = 0;
+
+    ASSERT_TRUE(sink.add_events(0x7, [&](short revents, jfern::fd_interface&) {
+        n_calls++;
+        received = revents;
+    }));
+
+    sink.handle_events(0x5);
+
+    EXPECT_EQ(n_calls, 1);
+    EXPECT_EQ(received, 0x5);
+
+    // Events without a handler are ignored
+    sink.handle_events(0x8);
+    EXPECT_EQ(n_calls, 1);
+}
+
+TEST(fd_event_sink, every_event_bit) {
+    jfern::fd_event_sink sink(
+        std::make_unique<testing::NiceMock<fd_interface_mock>>());
+
+    std::array<int, 16> calls = {};
+
+    for (int bit = 0; bit < 16; bit++) {
+        const auto event = static_cast<short>(1u << bit);
+
+        ASSERT_TRUE(sink.add_events(event, [&calls, bit](short,
+                                                         jfern::fd_interface&) {
+            calls[bit]++;
+        }));
+    }
+
+    EXPECT_EQ(sink.events(), static_cast<short>(0xffff));
+
+    sink.handle_events(static_cast<short>(0xffff));
+
+    for (int bit = 0; bit < 16; bit++) EXPECT_EQ(calls[bit], 1);
+
+    // Slots freed by replaced handlers are reused
+    ASSERT_TRUE(sink.add_events(static_cast<short>(0x8001),
+                                [&calls](short, jfern::fd_interface&) {
+        calls[0]++;
+    }));
+
+    sink.handle_events(static_cast<short>(0x8000));
+    EXPECT_EQ(calls[0], 2);
+    EXPECT_EQ(calls[15], 1);
+
+    sink.remove_events(static_cast<short>(0x8001));
+    EXPECT_EQ(sink.events(), 0x7ffe);
+
+    sink.clear_events();
+    EXPECT_EQ(sink.events(), 0);
+}
+
+TEST(fd_event_sink, handler_removed_during_dispatch) {
+    jfern::fd_event_sink sink(
+        std::make_unique<testing::NiceMock<fd_interface_mock>>());
+
+    int n_calls = 0;
+
+    ASSERT_TRUE(sink.add_events(0x1, [&](short, jfern::fd_interface&) {
+        sink.remove_events(0x2);
+        n_calls++;
+    }));
+    ASSERT_TRUE(sink.add_events(0x2, [&](short, jfern::fd_interface&) {
+        n_calls++;
+    }));
+
+    sink.handle_events(0x3);
+
+    EXPECT_EQ(n_calls, 1);
+    EXPECT_EQ(sink.events(), 0x1);
+}
+
+TEST(fd_event_sink, handler_changes_own_sink) {
+    jfern::fd_event_sink sink(
+        std::make_unique<testing::NiceMock<fd_interface_mock>>());
+
+    auto token = std::make_shared<int>(42);
+    std::vector<int> order;
+
+    // A handler which fills every other event bit and then replaces itself,
+    // touching its own captures after both
+    ASSERT_TRUE(sink.add_events(0x1, [&, token](short, jfern::fd_interface&) {
+        for (int bit = 1; bit < 16; bit++) {
+            sink.add_events(static_cast<short>(1u << bit),
+                            [&order, bit](short, jfern::fd_interface&) {
+                order.push_back(bit);
+            });
+        }
+
+        sink.add_events(0x1, [&order](short, jfern::fd_interface&) {
+            order.push_back(0);
+        });
+
+        order.push_back(*token);
+    }));
+
+    EXPECT_EQ(token.use_count(), 2);
+
+    sink.handle_events(static_cast<short>(0xffff));
+
+    // Handlers added during dispatch wait for the next one, and the replaced
+    // handler is destroyed once it returns
+    EXPECT_EQ(order, std::vector<int>({42}));
+    EXPECT_EQ(token.use_count(), 1);
+    EXPECT_EQ(sink.events(), static_cast<short>(0xffff));
+
+    order.clear();
+    sink.handle_events(0x5);
+    std::sort(order.begin(), order.end());
+    EXPECT_EQ(order, std::vector<int>({0, 2}));
+
+    // A handler which removes every event, itself included
+    ASSERT_TRUE(sink.add_events(0x1, [&, token](short, jfern::fd_interface&) {
+        sink.clear_events();
+        order.push_back(*token);
+    }));
+
+    order.clear();
+    sink.handle_events(static_cast<short>(0xffff));
+
+    EXPECT_EQ(order, std::vector<int>({42}));
+    EXPECT_EQ(token.use_count(), 1);
+    EXPECT_EQ(sink.events(), 0);
+}
+
 }  // namespace
@@ -0,0 +1,82 @@
+/**
+ *  \file   fd_test_helpers.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#ifndef NETWORKING_TESTS_FD_TEST_HELPERS_H_
+#define NETWORKING_TESTS_FD_TEST_HELPERS_H_
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "networking/fd_event_sink.h"
+#include "networking/unique_fd.h"
+
+namespace {
+/**
+ * A pipe whose read end is owned by an event sink
+ */
+struct pipe_sink {
+    pipe_sink() : sink(), write_end() {
+        int fds[2];
+        if (::pipe2(fds, O_NONBLOCK) == 0) {
+            sink = std::make_shared<jfern::fd_event_sink>(
+                        std::make_unique<jfern::unique_fd>(fds[0]));
+            write_end.reset(fds[1]);
+        }
+    }
+
+    void signal() {
+        const char byte = 'x';
+        ASSERT_EQ(::write(write_end.get(), &byte, 1), 1);
+    }
+
+    void signal(const std::string& data) {
+        ASSERT_EQ(::write(write_end.get(), data.data(), data.size()),
+                  static_cast<ssize_t>(data.size()));
+    }
+
+    std::shared_ptr<jfern::fd_event_sink> sink;
+    jfern::unique_fd write_end;
+};
+
+/**
+ * Fixture which opens a non-blocking pipe for each test
+ *
+ * @tparam Base The gtest fixture to derive from, e.g. testing::TestWithParam
+ */
+template <typename Base = testing::Test>
+class pipe_test : public Base {
+protected:
+    void SetUp() override {
+        int fds[2];
+        ASSERT_EQ(::pipe2(fds, O_NONBLOCK), 0);
+
+        m_read_end.reset(fds[0]);
+        m_write_end.reset(fds[1]);
+    }
+
+    jfern::unique_fd m_read_end;
+    jfern::unique_fd m_write_end;
+};
+
+/**
+ * Wait for a file descriptor to become readable
+ */
+inline bool wait_readable(int fd, int timeout = 1000) {
+    struct pollfd pfd = {fd, POLLIN, 0};
+    return ::poll(&pfd, 1, timeout) == 1;
+}
+
+}  // anonymous namespace
+
+#endif  // NETWORKING_TESTS_FD_TEST_HELPERS_H_
@@ -0,0 +1,114 @@
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "networking/inplace_function.h"
+
+namespace {
+static_assert(sizeof(jfern::inplace_function<void()>) == 64,
+              "the default inplace_function must fit in a cache line");
+static_assert(!std::is_copy_constructible<
+                  jfern::inplace_function<void()>>::value,
+              "inplace_function must be move-only");
+static_assert(std::is_nothrow_move_constructible<
+                  jfern::inplace_function<void()>>::value,
+              "inplace_function must be nothrow movable");
+
+int add(int a, int b) {
+    return a + b;
+}
+
+TEST(inplace_function, empty) {
+    jfern::inplace_function<int(int, int)> f;
+    EXPECT_FALSE(f);
+
+    jfern::inplace_function<int(int, int)> g = nullptr;
+    EXPECT_FALSE(g);
+
+    int (*null_function)(int, int) = nullptr;
+
+    jfern::inplace_function<int(int, int)> h = null_function;
+    EXPECT_FALSE(h);
+}
+
+TEST(inplace_function, call) {
+    jfern::inplace_function<int(int, int)> f = add;
+    ASSERT_TRUE(f);
+    EXPECT_EQ(f(2, 3), 5);
+
+    int base = 10;
+    f = [&base](int a, int b) { return base + a * b; };
+    EXPECT_EQ(f(2, 3), 16);
+
+    f = nullptr;
+    EXPECT_FALSE(f);
+}
+
+TEST(inplace_function, move_only_target) {
+    auto value = std::make_unique<int>(7);
+
+    jfern::inplace_function<int()> f =
+        [value = std::move(value)]() { return *value; };
+    EXPECT_EQ(f(), 7);
+
+    jfern::inplace_function<int()> g(std::move(f));
+    EXPECT_FALSE(f);
+    ASSERT_TRUE(g);
+    EXPECT_EQ(g(), 7);
+
+    f = std::move(g);
+    EXPECT_FALSE(g);
+    EXPECT_EQ(f(), 7);
+}
+
+TEST(inplace_function, destroys_target) {
+    auto counter = std::make_shared<int>(0);
+
+    {
+        jfern::inplace_function<long()> f =
+            [counter]() { return counter.use_count(); };
+        EXPECT_EQ(counter.use_count(), 2);
+
+        jfern::inplace_function<long()> g = std::move(f);
+        EXPECT_EQ(counter.use_count(), 2);
+
+        g = nullptr;
+        EXPECT_EQ(counter.use_count(), 1);
+
+        f = [counter]() { return counter.use_count(); };
+        EXPECT_EQ(counter.use_count(), 2);
+    }
+
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(inplace_function, capacity) {
+    struct large {
+        char bytes[100];
+    };
+
+    large data{};
+    data.bytes[99] = 42;
+
+    jfern::inplace_function<int(), sizeof(large)> f =
+        [data]() { return data.bytes[99]; };
+
+    EXPECT_EQ(f(), 42);
+    EXPECT_GE(sizeof(f), sizeof(large));
+}
+
+TEST(inplace_function, member_function) {
+    struct counter {
+        int increment(int n) { return value += n; }
+        int value;
+    };
+
+    counter c{1};
+
+    jfern::inplace_function<int(counter&, int)> f = &counter::increment;
+    EXPECT_EQ(f(c, 2), 3);
+    EXPECT_EQ(c.value, 3);
+}
+
+}  // namespace
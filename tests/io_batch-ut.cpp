@@ -0,0 +1,214 @@
+/**
+ *  \file   io_batch-ut.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "fd_test_helpers.h"
+#include "networking/fd_event_sink.h"
+#include "networking/io_batch.h"
+#include "networking/unique_fd.h"
+
+namespace {
+/**
+ * Runs each test against io_uring (when available) and the fallback
+ */
+class IoBatchTest : public pipe_test<testing::TestWithParam<bool>> {
+protected:
+    IoBatchTest() : m_batch(64, GetParam()) {}
+
+    jfern::io_batch m_batch;
+};
+
+TEST_P(IoBatchTest, backend) {
+    if (!GetParam()) {
+        EXPECT_FALSE(m_batch.using_io_uring());
+    }
+}
+
+TEST_P(IoBatchTest, write_then_read) {
+    const std::string message = "hello, world";
+    std::vector<std::uint8_t> buf(64);
+
+    int write_result = 0, read_result = 0;
+
+    ASSERT_TRUE(m_batch.write(
+        m_write_end.get(),
+        reinterpret_cast<const std::uint8_t*>(message.data()), message.size(),
+        [&](int result) { write_result = result; }));
+
+    EXPECT_EQ(m_batch.in_flight(), 1u);
+    EXPECT_EQ(m_batch.submit(1), 1);
+    EXPECT_EQ(write_result, static_cast<int>(message.size()));
+
+    ASSERT_TRUE(m_batch.read(m_read_end.get(), buf.data(), buf.size(),
+        [&](int result) { read_result = result; }));
+
+    EXPECT_EQ(m_batch.submit(1), 1);
+    EXPECT_EQ(m_batch.in_flight(), 0u);
+
+    ASSERT_EQ(read_result, static_cast<int>(message.size()));
+    EXPECT_EQ(std::memcmp(buf.data(), message.data(), message.size()), 0);
+}
+
+TEST_P(IoBatchTest, read_waits_for_data) {
+    std::vector<std::uint8_t> buf(16);
+    int result = 0;
+    bool called = false;
+
+    // The pipe is non-blocking, yet the read waits rather than failing with
+    // -EAGAIN
+    ASSERT_TRUE(m_batch.read(m_read_end.get(), buf.data(), buf.size(),
+        [&](int res) { result = res; called = true; }));
+
+    EXPECT_EQ(m_batch.submit(0), 0);
+    EXPECT_FALSE(called);
+    EXPECT_EQ(m_batch.in_flight(), 1u);
+
+    ASSERT_EQ(::write(m_write_end.get(), "abc", 3), 3);
+
+    EXPECT_EQ(m_batch.submit(1), 1);
+    EXPECT_TRUE(called);
+    ASSERT_EQ(result, 3);
+    EXPECT_EQ(std::memcmp(buf.data(), "abc", 3), 0);
+}
+
+TEST_P(IoBatchTest, destroy_cancels_in_flight) {
+    auto batch = std::make_unique<jfern::io_batch>(64, GetParam());
+    std::vector<std::uint8_t> buf(16, 0);
+    bool called = false;
+
+    ASSERT_TRUE(batch->read(m_read_end.get(), buf.data(), buf.size(),
+        [&](int) { called = true; }));
+    EXPECT_EQ(batch->submit(0), 0);
+
+    batch.reset();
+
+    // Data arriving later is left in the pipe rather than read into the
+    // caller's buffer
+    ASSERT_EQ(::write(m_write_end.get(), "abc", 3), 3);
+
+    char received[16];
+    EXPECT_EQ(::read(m_read_end.get(), received, sizeof(received)), 3);
+
+    EXPECT_FALSE(called);
+    EXPECT_EQ(buf, std::vector<std::uint8_t>(16, 0));
+}
+
+TEST_P(IoBatchTest, errors_are_negated) {
+    std::uint8_t byte;
+    int result = 0;
+
+    ASSERT_TRUE(m_batch.read(-1, &byte, 1,
+        [&](int res) { result = res; }));
+
+    EXPECT_EQ(m_batch.submit(1), 1);
+    EXPECT_EQ(result, -EBADF);
+}
+
+TEST_P(IoBatchTest, poll_stays_outstanding) {
+    int revents = 0;
+
+    ASSERT_TRUE(m_batch.poll(m_read_end.get(), POLLIN,
+        [&](int result) { revents = result; }));
+
+    EXPECT_EQ(m_batch.submit(0), 0);
+    EXPECT_EQ(m_batch.in_flight(), 1u);
+
+    const std::uint8_t byte = 1;
+    ASSERT_EQ(::write(m_write_end.get(), &byte, 1), 1);
+
+    EXPECT_EQ(m_batch.submit(1), 1);
+    EXPECT_EQ(revents & POLLIN, POLLIN);
+    EXPECT_EQ(m_batch.in_flight(), 0u);
+}
+
+TEST_P(IoBatchTest, batched_polls) {
+    constexpr int n_pipes = 16;
+
+    std::vector<jfern::unique_fd> read_ends(n_pipes), write_ends(n_pipes);
+    std::vector<int> revents(n_pipes, 0);
+
+    for (int i = 0; i < n_pipes; i++) {
+        int fds[2];
+        ASSERT_EQ(::pipe2(fds, O_NONBLOCK), 0);
+        read_ends[i].reset(fds[0]);
+        write_ends[i].reset(fds[1]);
+
+        const std::uint8_t byte = 1;
+        ASSERT_EQ(::write(fds[1], &byte, 1), 1);
+
+        ASSERT_TRUE(m_batch.poll(fds[0], POLLIN,
+            [&revents, i](int result) { revents[i] = result; }));
+    }
+
+    EXPECT_EQ(m_batch.submit(n_pipes), n_pipes);
+
+    for (int i = 0; i < n_pipes; i++) {
+        EXPECT_EQ(revents[i] & POLLIN, POLLIN) << "pipe " << i;
+    }
+}
+
+TEST_P(IoBatchTest, close) {
+    int result = -1;
+
+    ASSERT_TRUE(m_batch.close(m_write_end.release(),
+        [&](int res) { result = res; }));
+
+    EXPECT_EQ(m_batch.submit(1), 1);
+    EXPECT_EQ(result, 0);
+
+    // With the write end closed, the read end reports a hangup
+    EXPECT_EQ(m_read_end.poll(POLLIN) & POLLHUP, POLLHUP);
+}
+
+TEST_P(IoBatchTest, route_to_event_sink) {
+    auto sink = std::make_shared<jfern::fd_event_sink>(
+        std::make_unique<jfern::unique_fd>(::dup(m_read_end.get())));
+
+    std::string received;
+    ASSERT_TRUE(sink->add_events(POLLIN,
+        [&](short, jfern::fd_interface& fd) {
+            char buf[16];
+            const ssize_t n = ::read(fd.get(), buf, sizeof(buf));
+            if (n > 0) received.append(buf, n);
+        }));
+
+    ASSERT_TRUE(m_batch.poll(sink));
+
+    ASSERT_EQ(::write(m_write_end.get(), "abc", 3), 3);
+    EXPECT_EQ(m_batch.submit(1), 1);
+    EXPECT_EQ(received, "abc");
+
+    // The poll was re-armed
+    EXPECT_EQ(m_batch.in_flight(), 1u);
+
+    ASSERT_EQ(::write(m_write_end.get(), "def", 3), 3);
+    EXPECT_EQ(m_batch.submit(1), 1);
+    EXPECT_EQ(received, "abcdef");
+
+    // Once the sink is gone, nothing is re-armed
+    sink.reset();
+    ASSERT_EQ(::write(m_write_end.get(), "g", 1), 1);
+    EXPECT_EQ(m_batch.submit(1), 1);
+    EXPECT_EQ(m_batch.in_flight(), 0u);
+}
+
+INSTANTIATE_TEST_SUITE_P(io_batch, IoBatchTest, testing::Bool());
+
+}  // namespace
@@ -0,0 +1,143 @@
+/**
+ *  \file   iovec_builder-ut.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+#include "fd_test_helpers.h"
+#include "networking/data_buffer.h"
+#include "networking/iovec_builder.h"
+#include "networking/unique_fd.h"
+
+namespace {
+using IovecBuilderTest = pipe_test<>;
+
+TEST_F(IovecBuilderTest, write_buffers) {
+    jfern::output_buffer<4>  header;
+    jfern::output_buffer<16> payload;
+    jfern::output_buffer<2>  trailer;
+
+    ASSERT_TRUE(header.write(std::uint32_t(0x01020304), true));
+    ASSERT_TRUE(payload.write(
+        reinterpret_cast<const std::uint8_t*>("hello"), 5));
+    ASSERT_TRUE(trailer.write(std::uint16_t(0xbeef), false));
+
+    // Only the bytes written to each buffer are sent
+    EXPECT_EQ(jfern::write_buffers(m_write_end.get(), header, payload, trailer),
+              11);
+
+    std::uint8_t received[16];
+    ASSERT_EQ(::read(m_read_end.get(), received, sizeof(received)), 11);
+
+    EXPECT_EQ(std::memcmp(received, header.data(), 4), 0);
+    EXPECT_EQ(std::memcmp(received + 4, "hello", 5), 0);
+    EXPECT_EQ(std::memcmp(received + 9, trailer.data(), 2), 0);
+}
+
+TEST_F(IovecBuilderTest, read_buffers) {
+    const char message[] = "headpayload";
+    ASSERT_EQ(::write(m_write_end.get(), message, 11), 11);
+
+    jfern::input_buffer<4> header;
+    jfern::input_buffer<7> payload;
+
+    EXPECT_EQ(jfern::read_buffers(m_read_end.get(), header, payload), 11);
+
+    // Each buffer's offset is advanced past what it received
+    EXPECT_EQ(header.tell(), 4u);
+    EXPECT_EQ(payload.tell(), 7u);
+
+    header.rewind();
+    payload.rewind();
+
+    std::uint8_t bytes[7];
+    ASSERT_TRUE(header.read(bytes, 4));
+    EXPECT_EQ(std::memcmp(bytes, "head", 4), 0);
+
+    ASSERT_TRUE(payload.read(bytes, 7));
+    EXPECT_EQ(std::memcmp(bytes, "payload", 7), 0);
+}
+
+TEST_F(IovecBuilderTest, read_buffers_partial) {
+    jfern::input_buffer<4> header;
+    jfern::input_buffer<7> payload;
+
+    ASSERT_EQ(::write(m_write_end.get(), "headpa", 6), 6);
+    EXPECT_EQ(jfern::read_buffers(m_read_end.get(), header, payload), 6);
+
+    EXPECT_EQ(header.tell(), 4u);
+    EXPECT_EQ(payload.tell(), 2u);
+
+    // The next read resumes where the last left off
+    ASSERT_EQ(::write(m_write_end.get(), "yload", 5), 5);
+    EXPECT_EQ(jfern::read_buffers(m_read_end.get(), header, payload), 5);
+
+    EXPECT_EQ(header.tell(), 4u);
+    EXPECT_EQ(payload.tell(), 7u);
+
+    payload.rewind();
+
+    std::uint8_t bytes[7];
+    ASSERT_TRUE(payload.read(bytes, 7));
+    EXPECT_EQ(std::memcmp(bytes, "payload", 7), 0);
+}
+
+TEST_F(IovecBuilderTest, resumes_partial_transfers) {
+    const char message[] = "abcdefgh";
+    ASSERT_EQ(::write(m_write_end.get(), message, 5), 5);
+
+    jfern::input_buffer<3> first;
+    jfern::input_buffer<5> second;
+
+    jfern::iovec_builder<2> iov;
+    ASSERT_TRUE(iov.add(first));
+    ASSERT_TRUE(iov.add(second));
+    EXPECT_EQ(iov.bytes(), 8u);
+
+    // The first read fills the first buffer and part of the second
+    EXPECT_EQ(iov.read_from(m_read_end.get()), 5);
+    EXPECT_EQ(iov.size(), 1u);
+    EXPECT_EQ(iov.bytes(), 3u);
+
+    ASSERT_EQ(::write(m_write_end.get(), message + 5, 3), 3);
+
+    EXPECT_EQ(iov.read_from(m_read_end.get()), 3);
+    EXPECT_TRUE(iov.empty());
+
+    EXPECT_EQ(std::memcmp(first.data(), "abc", 3), 0);
+    EXPECT_EQ(std::memcmp(second.data(), "defgh", 5), 0);
+}
+
+TEST(iovec_builder, capacity) {
+    const std::uint8_t bytes[4] = {};
+
+    jfern::iovec_builder<2> iov;
+
+    EXPECT_TRUE(iov.add(bytes, 1));
+    EXPECT_TRUE(iov.add(bytes, 0));
+    EXPECT_TRUE(iov.add(bytes, 2));
+    EXPECT_FALSE(iov.add(bytes, 3));
+
+    EXPECT_EQ(iov.size(), 2u);
+    EXPECT_EQ(iov.bytes(), 3u);
+
+    iov.consume(2);
+    EXPECT_EQ(iov.size(), 1u);
+    EXPECT_EQ(iov.data()->iov_len, 1u);
+    EXPECT_EQ(iov.data()->iov_base, bytes + 1);
+
+    iov.clear();
+    EXPECT_TRUE(iov.empty());
+    EXPECT_EQ(iov.bytes(), 0u);
+}
+
+}  // namespace
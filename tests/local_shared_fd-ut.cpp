@@ -0,0 +1,140 @@
+/**
+ *  \file   local_shared_fd-ut.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "networking/local_shared_fd.h"
+
+namespace {
+class LocalSharedFdTest : public testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(::pipe(m_fds), 0);
+    }
+
+    void TearDown() override {
+        // The read end is owned by the objects under test
+        ::close(m_fds[1]);
+    }
+
+    bool is_open(int fd) const {
+        return ::fcntl(fd, F_GETFD) != -1;
+    }
+
+    int m_fds[2];
+};
+
+TEST_F(LocalSharedFdTest, copies_share_ownership) {
+    {
+        jfern::local_shared_fd fd1(m_fds[0]);
+        EXPECT_EQ(fd1.owner(), std::this_thread::get_id());
+
+        {
+            jfern::local_shared_fd fd2(fd1);
+            jfern::local_shared_fd fd3;
+            fd3 = fd2;
+
+            EXPECT_EQ(fd1.use_count(), 3u);
+            EXPECT_EQ(fd3.get(), m_fds[0]);
+        }
+
+        EXPECT_EQ(fd1.use_count(), 1u);
+        EXPECT_FALSE(fd1.promoted());
+        EXPECT_TRUE(is_open(m_fds[0]));
+    }
+
+    EXPECT_FALSE(is_open(m_fds[0]));
+}
+
+TEST_F(LocalSharedFdTest, share_outlives_local_owners) {
+    jfern::shared_fd shared;
+
+    {
+        jfern::local_shared_fd local(m_fds[0]);
+        ASSERT_TRUE(local.set_blocking(false));
+
+        shared = local.share();
+        ASSERT_TRUE(shared);
+        EXPECT_TRUE(local.promoted());
+
+        // One reference for the local owners, one for us
+        EXPECT_EQ(shared.use_count(), 2u);
+        EXPECT_FALSE(shared.is_blocking());
+
+        jfern::shared_fd another = local.share();
+        EXPECT_EQ(shared.use_count(), 3u);
+    }
+
+    EXPECT_EQ(shared.use_count(), 1u);
+    EXPECT_TRUE(is_open(m_fds[0]));
+
+    shared = jfern::shared_fd();
+    EXPECT_FALSE(is_open(m_fds[0]));
+}
+
+TEST_F(LocalSharedFdTest, local_owners_outlive_share) {
+    jfern::local_shared_fd local(m_fds[0]);
+
+    local.share();
+    EXPECT_TRUE(local.promoted());
+    EXPECT_TRUE(is_open(m_fds[0]));
+
+    const char byte = 'x';
+    ASSERT_EQ(::write(m_fds[1], &byte, 1), 1);
+    EXPECT_EQ(local.poll(POLLIN) & POLLIN, POLLIN);
+
+    local = jfern::local_shared_fd();
+    EXPECT_FALSE(is_open(m_fds[0]));
+}
+
+TEST_F(LocalSharedFdTest, share_checks_owner) {
+    jfern::local_shared_fd local(m_fds[0]);
+
+    int error = 0;
+    bool shared = true;
+
+    std::thread other([&]() {
+        errno = 0;
+        shared = static_cast<bool>(local.share());
+        error = errno;
+    });
+
+    other.join();
+
+    EXPECT_FALSE(shared);
+    EXPECT_EQ(error, EPERM);
+    EXPECT_FALSE(local.promoted());
+}
+
+TEST_F(LocalSharedFdTest, shared_across_threads) {
+    jfern::local_shared_fd local(m_fds[0]);
+
+    int revents = 0;
+    std::thread worker([fd = local.share(jfern::fd::concurrency::lock_free),
+                        &revents]() mutable {
+        revents = fd.poll(POLLIN, -1);
+    });
+
+    const char byte = 'x';
+    ASSERT_EQ(::write(m_fds[1], &byte, 1), 1);
+
+    worker.join();
+    EXPECT_EQ(revents & POLLIN, POLLIN);
+
+    // Polls from the owner now go through the shared control block
+    EXPECT_EQ(local.poll(POLLIN) & POLLIN, POLLIN);
+}
+
+}  // namespace
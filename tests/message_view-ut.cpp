@@ -0,0 +1,91 @@
+/**
+ *  \file   message_view-ut.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include <cstdint>
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+#include "networking/data_buffer.h"
+#include "networking/message_view.h"
+
+namespace {
+using header = jfern::message_schema<
+    jfern::field<std::uint8_t>,
+    jfern::field<std::uint16_t>,
+    jfern::field<std::uint32_t>,
+    jfern::raw_field<4>,
+    jfern::field<std::int64_t, jfern::byte_order::little>,
+    jfern::field<std::int16_t>>;
+
+constexpr std::uint8_t encoded[] = {
+    0x7f,                                            // uint8
+    0x12, 0x34,                                      // uint16, big endian
+    0xde, 0xad, 0xbe, 0xef,                          // uint32, big endian
+    'A', 'B', 'C', 'D',                              // raw bytes
+    0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01,  // int64, little endian
+    0xff, 0xfe                                       // int16, big endian
+};
+
+static_assert(header::count == 6);
+static_assert(header::size == sizeof(encoded));
+static_assert(header::offset<0>() == 0);
+static_assert(header::offset<3>() == 7);
+static_assert(header::offset<5>() == 19);
+
+TEST(message_view, empty) {
+    jfern::message_view<header> view;
+    EXPECT_FALSE(view);
+    EXPECT_EQ(view.data(), nullptr);
+    EXPECT_EQ(view.size(), sizeof(encoded));
+}
+
+TEST(message_view, validates_length) {
+    EXPECT_FALSE(jfern::message_view<header>(nullptr, sizeof(encoded)));
+    EXPECT_FALSE(jfern::message_view<header>(encoded, sizeof(encoded) - 1));
+    EXPECT_TRUE (jfern::message_view<header>(encoded, sizeof(encoded)));
+    EXPECT_TRUE (jfern::message_view<header>(encoded, sizeof(encoded) + 1));
+}
+
+TEST(message_view, decodes_fields) {
+    const jfern::message_view<header> view(encoded, sizeof(encoded));
+    ASSERT_TRUE(view);
+    EXPECT_EQ(view.data(), encoded);
+
+    EXPECT_EQ(view.get<0>(), 0x7fu);
+    EXPECT_EQ(view.get<1>(), 0x1234u);
+    EXPECT_EQ(view.get<2>(), 0xdeadbeefu);
+    EXPECT_EQ(view.get<4>(), 0x0102030405060708);
+    EXPECT_EQ(view.get<5>(), -2);
+
+    // Raw fields point into the message
+    EXPECT_EQ(view.get<3>(), encoded + 7);
+    EXPECT_EQ(std::memcmp(view.get<3>(), "ABCD", 4), 0);
+}
+
+TEST(message_view, view_input_buffer) {
+    jfern::input_buffer<2 * sizeof(encoded)> buffer;
+
+    std::memcpy(buffer.data(), encoded, sizeof(encoded));
+    std::memcpy(buffer.data() + sizeof(encoded), encoded, sizeof(encoded));
+
+    for (int i = 0; i < 2; i++) {
+        const auto view = jfern::view_message<header>(buffer);
+        ASSERT_TRUE(view);
+        EXPECT_EQ(view.data(), buffer.data() + i * sizeof(encoded));
+        EXPECT_EQ(view.get<2>(), 0xdeadbeefu);
+    }
+
+    EXPECT_EQ(buffer.tell(), buffer.size());
+
+    // Nothing left
+    EXPECT_FALSE(jfern::view_message<header>(buffer));
+    EXPECT_EQ(buffer.tell(), buffer.size());
+}
+
+}  // namespace
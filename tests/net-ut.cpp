@@ -1,5 +1,8 @@
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <limits.h>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "networking/net.h"
@@ -158,4 +161,155 @@ TEST(net, byte_swap_U64) {
     EXPECT_EQ(jfern::byte_swap(valueU64), valueU64);
 }
 
+TEST(net, to_network_order) {
+    const std::uint32_t value = 0x01020304;
+    const std::uint32_t wire  = jfern::to_network_order(value);
+
+    // Network order is big endian, whatever the host's byte order
+    const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(&wire);
+
+    EXPECT_EQ(bytes[0], 0x01);
+    EXPECT_EQ(bytes[1], 0x02);
+    EXPECT_EQ(bytes[2], 0x03);
+    EXPECT_EQ(bytes[3], 0x04);
+
+    EXPECT_EQ(jfern::to_host_order(wire), value);
+}
+
+static_assert(jfern::byte_swap(std::uint16_t(0x1122)) == 0x2211,
+              "byte_swap must be usable in constant expressions");
+static_assert(jfern::byte_swap(std::uint32_t(0x11223344)) == 0x44332211,
+              "byte_swap must be usable in constant expressions");
+static_assert(jfern::byte_swap(std::uint64_t(0x1122334455667788))
+                == 0x8877665544332211,
+              "byte_swap must be usable in constant expressions");
+static_assert(jfern::to_network_order(jfern::to_host_order(0x12345678u))
+                == 0x12345678u,
+              "byte order conversion must be usable in constant expressions");
+
+TEST(net, byte_swap_float) {
+    const float value = 1.5f;  // 0x3fc00000
+
+    const float swapped = jfern::byte_swap(value);
+
+    std::uint32_t bits;
+    std::memcpy(&bits, &swapped, sizeof(bits));
+
+    EXPECT_EQ(bits, 0x0000c03fu);
+    EXPECT_EQ(jfern::byte_swap(swapped), value);
+}
+
+TEST(net, byte_swap_double) {
+    const double value = -2.25;  // 0xc002000000000000
+
+    const double swapped = jfern::byte_swap(value);
+
+    std::uint64_t bits;
+    std::memcpy(&bits, &swapped, sizeof(bits));
+
+    EXPECT_EQ(bits, 0x02c0u);
+    EXPECT_EQ(jfern::byte_swap(swapped), value);
+}
+
+TEST(net, byte_swap_enum) {
+    enum class message_type : std::uint16_t {
+        heartbeat = 0x0102
+    };
+
+    EXPECT_EQ(static_cast<std::uint16_t>(
+                  jfern::byte_swap(message_type::heartbeat)), 0x0201);
+
+    std::vector<message_type> types(5, message_type::heartbeat);
+    jfern::byte_swap(types.data(), types.size());
+
+    for (message_type type : types) {
+        EXPECT_EQ(static_cast<std::uint16_t>(type), 0x0201);
+    }
+}
+
+TEST(net, is_big_endian) {
+    const std::uint32_t value = 1;
+
+    std::uint8_t first_byte;
+    std::memcpy(&first_byte, &value, sizeof(first_byte));
+
+    EXPECT_EQ(jfern::is_big_endian(), first_byte == 0);
+}
+
+/**
+ * Check the bulk byte swap against the scalar one, at every supported
+ * instruction set, for a range of lengths and alignments, in and out of
+ * place
+ */
+template <typename T>
+void check_bulk_byte_swap() {
+    using jfern::internal::simd_level;
+
+    const simd_level max_level = jfern::internal::max_simd_level();
+
+    std::vector<T> input(200);
+    for (std::size_t i = 0; i < input.size(); i++) {
+        input[i] = static_cast<T>(0x0102030405060708ull * (i + 1));
+    }
+
+    for (int level = 0; level <= static_cast<int>(max_level); level++) {
+        for (std::size_t offset = 0; offset < 3; offset++) {
+            for (std::size_t count = 0; count + offset <= 67; count++) {
+                const T* in = input.data() + offset;
+
+                std::vector<T> out(count + 1, T(0x55));
+                jfern::internal::bulk_byte_swap(
+                    in, out.data(), count, sizeof(T),
+                    static_cast<simd_level>(level));
+
+                std::vector<T> in_place(in, in + count);
+                jfern::internal::bulk_byte_swap(
+                    in_place.data(), in_place.data(), count, sizeof(T),
+                    static_cast<simd_level>(level));
+
+                for (std::size_t i = 0; i < count; i++) {
+                    ASSERT_EQ(out[i], jfern::byte_swap(in[i]));
+                    ASSERT_EQ(in_place[i], out[i]);
+                }
+
+                // Nothing written past the end
+                ASSERT_EQ(out[count], T(0x55));
+            }
+        }
+    }
+}
+
+TEST(net, bulk_byte_swap_U16) {
+    check_bulk_byte_swap<std::uint16_t>();
+}
+
+TEST(net, bulk_byte_swap_U32) {
+    check_bulk_byte_swap<std::uint32_t>();
+}
+
+TEST(net, bulk_byte_swap_U64) {
+    check_bulk_byte_swap<std::uint64_t>();
+}
+
+TEST(net, bulk_byte_order) {
+    std::vector<std::int32_t> host(100);
+    for (std::size_t i = 0; i < host.size(); i++) {
+        host[i] = static_cast<std::int32_t>(i * 0x01010101);
+    }
+
+    std::vector<std::int32_t> network(host.size());
+    jfern::to_network_order(host.data(), network.data(), host.size());
+
+    for (std::size_t i = 0; i < host.size(); i++) {
+        ASSERT_EQ(network[i], jfern::to_network_order(host[i]));
+    }
+
+    jfern::to_host_order(network.data(), network.size());
+    EXPECT_EQ(network, host);
+
+    std::vector<std::uint8_t> bytes = {1, 2, 3};
+    jfern::byte_swap(bytes.data(), bytes.size());
+    EXPECT_EQ(bytes, (std::vector<std::uint8_t>{1, 2, 3}));
+}
+
 }  // namespace
@@ -0,0 +1,277 @@
+/**
+ *  \file   reactor-ut.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "fd_test_helpers.h"
+#include "networking/fd_event_sink.h"
+#include "networking/reactor.h"
+#include "networking/unique_fd.h"
+
+namespace {
+TEST(reactor, add_remove) {
+    jfern::reactor reactor;
+    ASSERT_TRUE(reactor);
+
+    pipe_sink pipe;
+    ASSERT_TRUE(pipe.sink->add_events(POLLIN, [](short, jfern::fd_interface&) {}));
+
+    EXPECT_FALSE(reactor.add(nullptr));
+    EXPECT_TRUE(reactor.add(pipe.sink));
+    EXPECT_FALSE(reactor.add(pipe.sink));
+
+    EXPECT_TRUE(reactor.contains(pipe.sink->get()));
+    EXPECT_EQ(reactor.size(), 1u);
+
+    EXPECT_TRUE(reactor.remove(pipe.sink->get()));
+    EXPECT_FALSE(reactor.remove(pipe.sink->get()));
+
+    EXPECT_FALSE(reactor.contains(pipe.sink->get()));
+    EXPECT_EQ(reactor.size(), 0u);
+}
+
+TEST(reactor, dispatch_ready_only) {
+    constexpr std::size_t n_pipes = 100;
+
+    jfern::reactor reactor(8);
+    std::array<pipe_sink, n_pipes> pipes;
+    std::vector<int> counts(n_pipes, 0);
+
+    for (std::size_t i = 0; i < n_pipes; i++) {
+        ASSERT_TRUE(pipes[i].sink->add_events(POLLIN,
+            [&counts, i](short revents, jfern::fd_interface& fd) {
+                char byte;
+                if (revents & POLLIN) {
+                    if (::read(fd.get(), &byte, 1) == 1) counts[i]++;
+                }
+            }));
+        ASSERT_TRUE(reactor.add(pipes[i].sink));
+    }
+
+    EXPECT_EQ(reactor.run_once(0), 0);
+
+    // Make every third pipe readable; more than fit in a single batch
+    std::size_t n_signaled = 0;
+    for (std::size_t i = 0; i < n_pipes; i += 3, n_signaled++) {
+        pipes[i].signal();
+    }
+
+    int n_dispatched = 0;
+    for (int n; (n = reactor.run_once(0)) > 0; ) {
+        ASSERT_LE(n, 8);
+        n_dispatched += n;
+    }
+
+    EXPECT_EQ(static_cast<std::size_t>(n_dispatched), n_signaled);
+
+    for (std::size_t i = 0; i < n_pipes; i++) {
+        EXPECT_EQ(counts[i], i % 3 == 0 ? 1 : 0) << "pipe " << i;
+    }
+}
+
+TEST(reactor, update_events) {
+    jfern::reactor reactor;
+
+    pipe_sink pipe;
+    int n_calls = 0;
+
+    ASSERT_TRUE(pipe.sink->add_events(POLLPRI,
+        [&](short, jfern::fd_interface&) { n_calls++; }));
+    ASSERT_TRUE(reactor.add(pipe.sink));
+
+    pipe.signal();
+    EXPECT_EQ(reactor.run_once(0), 0);
+
+    ASSERT_TRUE(pipe.sink->add_events(POLLIN,
+        [&](short, jfern::fd_interface&) { n_calls++; }));
+    ASSERT_TRUE(reactor.update(pipe.sink->get()));
+
+    EXPECT_EQ(reactor.run_once(0), 1);
+    EXPECT_EQ(n_calls, 1);
+}
+
+TEST(reactor, remove_from_handler) {
+    jfern::reactor reactor;
+
+    pipe_sink pipe;
+    const int fd = pipe.sink->get();
+
+    ASSERT_TRUE(pipe.sink->add_events(POLLIN,
+        [&](short, jfern::fd_interface&) { reactor.remove(fd); }));
+    ASSERT_TRUE(reactor.add(pipe.sink));
+
+    pipe.sink.reset();
+    pipe.signal();
+
+    EXPECT_EQ(reactor.run_once(0), 1);
+    EXPECT_EQ(reactor.size(), 0u);
+    EXPECT_EQ(reactor.run_once(0), 0);
+}
+
+TEST(reactor, reused_descriptor) {
+    jfern::reactor reactor;
+
+    std::array<pipe_sink, 2> pipes;
+    std::shared_ptr<jfern::fd_event_sink> replacement;
+    int n_replacement_calls = 0;
+
+    // Whichever handler runs first closes the other pipe and registers a new
+    // sink under the same descriptor number, with nothing to read
+    auto replace = [&](pipe_sink& other) {
+        return [&](short, jfern::fd_interface&) {
+            if (replacement) return;
+
+            const int fd = other.sink->get();
+            ASSERT_TRUE(reactor.remove(fd));
+            other.sink.reset();
+
+            int fds[2];
+            ASSERT_EQ(::pipe2(fds, O_NONBLOCK), 0);
+            if (fds[0] != fd) {
+                ASSERT_EQ(::dup2(fds[0], fd), fd);
+                ::close(fds[0]);
+            }
+            other.write_end.reset(fds[1]);
+
+            replacement = std::make_shared<jfern::fd_event_sink>(
+                              std::make_unique<jfern::unique_fd>(fd));
+            ASSERT_TRUE(replacement->add_events(POLLIN,
+                [&](short, jfern::fd_interface&) { n_replacement_calls++; }));
+            ASSERT_TRUE(reactor.add(replacement));
+        };
+    };
+
+    ASSERT_TRUE(pipes[0].sink->add_events(POLLIN, replace(pipes[1])));
+    ASSERT_TRUE(pipes[1].sink->add_events(POLLIN, replace(pipes[0])));
+
+    for (pipe_sink& pipe : pipes) {
+        ASSERT_TRUE(reactor.add(pipe.sink));
+        pipe.signal();
+    }
+
+    // The event reported for the closed pipe is not delivered to its
+    // replacement
+    EXPECT_EQ(reactor.run_once(0), 1);
+    ASSERT_TRUE(replacement);
+    EXPECT_EQ(n_replacement_calls, 0);
+    EXPECT_EQ(reactor.size(), 2u);
+
+    EXPECT_EQ(reactor.run_once(0), 1);
+    EXPECT_EQ(n_replacement_calls, 0);
+}
+
+TEST(reactor, edge_triggered_budget) {
+    jfern::reactor reactor;
+
+    pipe_sink pipe;
+    pipe.sink->set_budget(4);
+
+    std::string received;
+    int n_calls = 0;
+
+    ASSERT_TRUE(pipe.sink->add_edge_events(POLLIN,
+        [&](short, jfern::edge_io& io) {
+            std::uint8_t buf[64];
+            const ssize_t n = io.read(buf, sizeof(buf));
+            ASSERT_GE(n, 0);
+            received.append(reinterpret_cast<char*>(buf), n);
+            n_calls++;
+        }));
+    ASSERT_TRUE(pipe.sink->edge_triggered());
+    ASSERT_TRUE(reactor.add(pipe.sink));
+
+    pipe.signal("0123456789");
+
+    // Each wakeup transfers at most 4 bytes. The remainder is picked up
+    // without a new edge being reported
+    EXPECT_EQ(reactor.run_once(0), 1);
+    EXPECT_EQ(received, "0123");
+
+    EXPECT_EQ(reactor.run_once(-1), 1);
+    EXPECT_EQ(received, "01234567");
+
+    EXPECT_EQ(reactor.run_once(-1), 1);
+    EXPECT_EQ(received, "0123456789");
+
+    // The last read drained the pipe, so nothing is pending
+    EXPECT_EQ(reactor.run_once(0), 0);
+    EXPECT_EQ(n_calls, 3);
+}
+
+TEST(reactor, edge_triggered_fairness) {
+    jfern::reactor reactor;
+
+    pipe_sink hot, cold;
+    hot.sink->set_budget(2);
+
+    std::string hot_data, cold_data;
+
+    auto reader = [](std::string* out) {
+        return [out](short, jfern::edge_io& io) {
+            std::uint8_t buf[64];
+            const ssize_t n = io.read(buf, sizeof(buf));
+            if (n > 0) out->append(reinterpret_cast<char*>(buf), n);
+        };
+    };
+
+    ASSERT_TRUE(hot.sink->add_edge_events(POLLIN, reader(&hot_data)));
+    ASSERT_TRUE(cold.sink->add_edge_events(POLLIN, reader(&cold_data)));
+    ASSERT_TRUE(reactor.add(hot.sink));
+    ASSERT_TRUE(reactor.add(cold.sink));
+
+    hot.signal("abcdefgh");
+    EXPECT_EQ(reactor.run_once(0), 1);
+    EXPECT_EQ(hot_data, "ab");
+
+    // The cold descriptor is serviced alongside the backlogged hot one
+    cold.signal("xyz");
+    EXPECT_EQ(reactor.run_once(0), 2);
+    EXPECT_EQ(hot_data, "abcd");
+    EXPECT_EQ(cold_data, "xyz");
+
+    while (reactor.run_once(0) > 0) {}
+    EXPECT_EQ(hot_data, "abcdefgh");
+}
+
+TEST(reactor, timers) {
+    jfern::reactor reactor;
+    ASSERT_TRUE(reactor);
+
+    std::vector<int> order;
+
+    reactor.timers().schedule(std::chrono::milliseconds(20),
+                              [&order]() { order.push_back(1); });
+    reactor.defer([&order]() { order.push_back(2); });
+
+    // The deferred task runs without waiting for the timer
+    EXPECT_EQ(reactor.run_once(-1), 0);
+    EXPECT_EQ(order, std::vector<int>({2}));
+
+    // Otherwise the wait is bounded by the timer, even if infinite
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(reactor.run_once(-1), 0);
+
+    EXPECT_GE(std::chrono::steady_clock::now() - start,
+              std::chrono::milliseconds(10));
+    EXPECT_EQ(order, std::vector<int>({2, 1}));
+    EXPECT_EQ(reactor.timers().size(), 0u);
+}
+
+}  // namespace
@@ -0,0 +1,94 @@
+/**
+ *  \file   ref_counts-ut.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "networking/ref_counts.h"
+
+namespace {
+/**
+ * Runs each test against both counter layouts
+ */
+template <class T>
+class RefCountsTest : public testing::Test {};
+
+using layouts = testing::Types<
+    std::integral_constant<jfern::fd::counter_layout,
+                           jfern::fd::counter_layout::packed>,
+    std::integral_constant<jfern::fd::counter_layout,
+                           jfern::fd::counter_layout::padded>>;
+
+TYPED_TEST_SUITE(RefCountsTest, layouts);
+
+TYPED_TEST(RefCountsTest, lifetime) {
+    jfern::fd::ref_counts<TypeParam::value> counts;
+
+    EXPECT_EQ(counts.count(), 1u);
+    EXPECT_EQ(counts.weak_count(), 1u);
+
+    counts.add_weak_reference();
+    EXPECT_TRUE(counts.add_reference_if_valid());
+    EXPECT_EQ(counts.count(), 2u);
+
+    EXPECT_FALSE(counts.release());
+    EXPECT_TRUE(counts.release());
+
+    // The weak count is dropped on behalf of the last strong reference
+    EXPECT_FALSE(counts.release_weak_reference());
+
+    EXPECT_FALSE(counts.add_reference_if_valid());
+    EXPECT_EQ(counts.count(), 0u);
+
+    EXPECT_TRUE(counts.release_weak_reference());
+    EXPECT_FALSE(counts.add_weak_reference_if_valid());
+}
+
+TYPED_TEST(RefCountsTest, concurrent_strong_and_weak) {
+    constexpr std::size_t num_threads = 8;
+    constexpr std::size_t iterations = 10000;
+
+    jfern::fd::ref_counts<TypeParam::value> counts;
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < num_threads; i++) {
+        threads.emplace_back([&counts, i]() {
+            for (std::size_t j = 0; j < iterations; j++) {
+                if (i % 2 == 0) {
+                    counts.add_reference();
+                    counts.release();
+                } else {
+                    counts.add_weak_reference();
+                    counts.release_weak_reference();
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads) thread.join();
+
+    EXPECT_EQ(counts.count(), 1u);
+    EXPECT_EQ(counts.weak_count(), 1u);
+}
+
+TEST(ref_counts, padded_layout) {
+    using padded = jfern::fd::ref_counts<jfern::fd::counter_layout::padded>;
+
+    padded counts;
+
+    const auto strong = reinterpret_cast<std::uintptr_t>(&counts);
+    EXPECT_EQ(strong % jfern::fd::cache_line_size, 0u);
+    EXPECT_EQ(sizeof(padded), 2 * jfern::fd::cache_line_size);
+}
+
+}  // namespace
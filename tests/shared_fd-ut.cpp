@@ -1,7 +1,131 @@
 #include "networking/shared_fd.h"
 
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 namespace {
+class SharedFdTest : public testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(::pipe(m_fds), 0);
+    }
+
+    void TearDown() override {
+        // The read end is owned by the shared_fds under test
+        ::close(m_fds[1]);
+    }
+
+    int m_fds[2];
+};
+
+TEST_F(SharedFdTest, weak_lock_shares_ownership) {
+    jfern::weak_fd weak;
+
+    {
+        jfern::shared_fd fd(m_fds[0]);
+        weak = fd;
+
+        EXPECT_FALSE(weak.expired());
+
+        {
+            jfern::shared_fd locked = weak.lock();
+            EXPECT_EQ(locked.get(), m_fds[0]);
+            EXPECT_EQ(fd.use_count(), 2u);
+        }
+
+        EXPECT_EQ(fd.use_count(), 1u);
+        EXPECT_EQ(weak.use_count(), 1u);
+    }
+
+    EXPECT_TRUE(weak.expired());
+    EXPECT_FALSE(weak.lock());
+
+    // The descriptor was closed exactly once
+    EXPECT_EQ(::fcntl(m_fds[0], F_GETFD), -1);
+}
+
+TEST_F(SharedFdTest, make_shared_fd) {
+    jfern::shared_fd fd = jfern::make_shared_fd(
+        m_fds[0], jfern::fd::concurrency::lock_free);
+
+    ASSERT_TRUE(fd);
+    EXPECT_EQ(fd.get(), m_fds[0]);
+    EXPECT_EQ(fd.use_count(), 1u);
+    EXPECT_EQ(fd.concurrency_mode(), jfern::fd::concurrency::lock_free);
+}
+
+TEST_F(SharedFdTest, lock_free_poll_does_not_serialize) {
+    jfern::shared_fd fd1(m_fds[0], jfern::fd::concurrency::lock_free);
+    jfern::shared_fd fd2(fd1);
+
+    EXPECT_EQ(fd2.concurrency_mode(), jfern::fd::concurrency::lock_free);
+
+    int blocked_revents = 0;
+    std::thread waiter([&]() {
+        blocked_revents = fd1.poll(POLLIN, -1);
+    });
+
+    // Give the waiter time to block inside poll()
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    const auto start = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(fd2.poll(POLLIN), 0);
+    EXPECT_TRUE(fd2.set_blocking(false));
+
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_LT(elapsed, std::chrono::milliseconds(500));
+
+    const char byte = 'x';
+    ASSERT_EQ(::write(m_fds[1], &byte, 1), 1);
+
+    waiter.join();
+    EXPECT_EQ(blocked_revents & POLLIN, POLLIN);
+}
+
+TEST_F(SharedFdTest, lock_free_cached_flags) {
+    jfern::shared_fd fd1(m_fds[0], jfern::fd::concurrency::lock_free);
+    jfern::shared_fd fd2(fd1);
+
+    ASSERT_TRUE(fd1.set_blocking(false));
+
+    // Visible through every owner, and applied to the descriptor
+    EXPECT_FALSE(fd1.is_blocking());
+    EXPECT_FALSE(fd2.is_blocking());
+    EXPECT_TRUE(::fcntl(m_fds[0], F_GETFL) & O_NONBLOCK);
+
+    ASSERT_TRUE(fd2.set_blocking(true));
+
+    EXPECT_TRUE(fd1.is_blocking());
+    EXPECT_FALSE(::fcntl(m_fds[0], F_GETFL) & O_NONBLOCK);
+}
+
+TEST_F(SharedFdTest, lock_free_flags_converge) {
+    constexpr std::size_t n_threads = 8;
+
+    jfern::shared_fd fd(m_fds[0], jfern::fd::concurrency::lock_free);
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < n_threads; i++) {
+        threads.emplace_back([fd, i]() mutable {
+            for (int j = 0; j < 1000; j++) {
+                fd.set_blocking((i + j) % 2 == 0);
+            }
+        });
+    }
+
+    for (auto& thread : threads) thread.join();
+
+    const bool nonblocking = ::fcntl(m_fds[0], F_GETFL) & O_NONBLOCK;
+    EXPECT_EQ(fd.is_blocking(), !nonblocking);
+}
 
 }  // namespace
@@ -1,7 +1,9 @@
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "networking/fd_internal.h"
@@ -33,4 +35,69 @@ TEST(shared_internal, reference_counting) {
 
     EXPECT_EQ(internal.count(), expected_sum);
 }
+
+TEST(shared_internal, pooled_blocks_are_recycled) {
+    auto first = new jfern::fd::shared_internal(-1);
+    void* const address = first;
+    delete first;
+
+    // The most recently freed block is handed out next on this thread
+    auto second = new jfern::fd::shared_internal(-1);
+    EXPECT_EQ(static_cast<void*>(second), address);
+    EXPECT_EQ(second->count(), 1u);
+    EXPECT_EQ(second->get(), -1);
+    delete second;
+}
+
+TEST(shared_internal, pooled_blocks_are_distinct) {
+    constexpr std::size_t num_blocks = 1000;
+
+    EXPECT_GE(jfern::fd::shared_internal::reserve(num_blocks), num_blocks);
+
+    std::vector<jfern::fd::shared_internal*> blocks;
+    for (std::size_t i = 0; i < num_blocks; i++) {
+        blocks.push_back(new jfern::fd::shared_internal(static_cast<int>(i)));
+    }
+
+    for (std::size_t i = 0; i < num_blocks; i++) {
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(blocks[i])
+                    % alignof(jfern::fd::shared_internal), 0u);
+        EXPECT_EQ(blocks[i]->get(), static_cast<int>(i));
+        delete blocks[i];
+    }
+}
+
+TEST(shared_internal, pooled_blocks_cross_threads) {
+    constexpr std::size_t num_threads = 4;
+    constexpr std::size_t blocks_per_thread = 5000;
+
+    // Allocate in one set of threads and free in another, as when an acceptor
+    // hands connections off to workers
+    std::array<std::vector<jfern::fd::shared_internal*>, num_threads> blocks;
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < num_threads; i++) {
+        threads.emplace_back([&blocks, i]() {
+            for (std::size_t j = 0; j < blocks_per_thread; j++) {
+                blocks[i].push_back(new jfern::fd::shared_internal(
+                    static_cast<int>(j)));
+            }
+        });
+    }
+
+    for (auto& thread : threads) thread.join();
+    threads.clear();
+
+    for (std::size_t i = 0; i < num_threads; i++) {
+        threads.emplace_back([&blocks, i]() {
+            auto& mine = blocks[(i + 1) % num_threads];
+            for (std::size_t j = 0; j < mine.size(); j++) {
+                EXPECT_EQ(mine[j]->get(), static_cast<int>(j));
+                delete mine[j];
+            }
+        });
+    }
+
+    for (auto& thread : threads) thread.join();
+}
 }  // namespace
@@ -0,0 +1,308 @@
+/**
+ *  \file   stream_channel-ut.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "fd_test_helpers.h"
+#include "net/stream_channel.h"
+#include "net/tcp_server.h"
+#include "networking/reactor.h"
+
+namespace {
+/**
+ * A connected pair of channels over loopback
+ */
+class StreamChannelTest : public ::testing::Test {
+protected:
+    void Connect(std::size_t buffer_size) {
+        ASSERT_EQ(server.Start(), jfern::NetError::kSuccess);
+
+        client = std::make_shared<jfern::StreamChannel>(
+            "127.0.0.1", server.Port(), buffer_size);
+        ASSERT_TRUE(*client);
+
+        for (int i = 0; i < 1000 && !peer; i++) {
+            peer = server.Accept().lock();
+        }
+        ASSERT_TRUE(peer);
+    }
+
+    void SetUp() override {
+        Connect(64);
+    }
+
+    /**
+     * Read everything the peer has received so far with raw reads
+     */
+    std::vector<std::uint8_t> Drain() {
+        std::vector<std::uint8_t> data;
+        std::uint8_t buf[1024];
+
+        while (wait_readable(peer->Fd().get(), 100)) {
+            const ssize_t n = ::read(peer->Fd().get(), buf, sizeof(buf));
+            if (n <= 0) break;
+            data.insert(data.end(), buf, buf + n);
+        }
+
+        return data;
+    }
+
+    jfern::TcpServer server{"127.0.0.1", 0};
+    std::shared_ptr<jfern::StreamChannel> client;
+    std::shared_ptr<jfern::StreamChannel> peer;
+};
+
+TEST_F(StreamChannelTest, NoDelay) {
+    int value = 0;
+    socklen_t len = sizeof(value);
+
+    ASSERT_EQ(::getsockopt(client->Fd().get(), IPPROTO_TCP, TCP_NODELAY,
+                           &value, &len), 0);
+    EXPECT_NE(value, 0);
+
+    ASSERT_EQ(::getsockopt(peer->Fd().get(), IPPROTO_TCP, TCP_NODELAY,
+                           &value, &len), 0);
+    EXPECT_NE(value, 0);
+}
+
+TEST_F(StreamChannelTest, WritesAreBufferedUntilFlush) {
+    for (std::uint32_t i = 0; i < 10; i++) {
+        *client << i;
+    }
+
+    EXPECT_EQ(client->Status(), jfern::NetError::kSuccess);
+    EXPECT_EQ(client->Pending(), 10 * sizeof(std::uint32_t));
+
+    // Nothing has been sent
+    EXPECT_FALSE(wait_readable(peer->Fd().get(), 10));
+
+    EXPECT_EQ(client->Flush(), jfern::NetError::kSuccess);
+    EXPECT_EQ(client->Pending(), 0u);
+
+    EXPECT_EQ(Drain().size(), 10 * sizeof(std::uint32_t));
+}
+
+TEST_F(StreamChannelTest, FlushWhenFull) {
+    // The buffer holds 64 bytes
+    for (std::uint64_t i = 0; i < 7; i++) {
+        *client << i;
+    }
+    EXPECT_EQ(client->Pending(), 56u);
+
+    *client << std::uint64_t(7);
+    EXPECT_EQ(client->Pending(), 0u);
+
+    *client << std::uint64_t(8);
+    EXPECT_EQ(client->Pending(), 8u);
+
+    EXPECT_EQ(Drain().size(), 64u);
+}
+
+TEST_F(StreamChannelTest, LargeWrite) {
+    std::vector<std::uint8_t> data(1000, 0xab);
+
+    ASSERT_EQ(client->Write(data.data(), data.size()),
+              jfern::NetError::kSuccess);
+    EXPECT_EQ(client->Pending(), 0u);
+
+    EXPECT_EQ(Drain(), data);
+}
+
+TEST_F(StreamChannelTest, FlushOnTick) {
+    jfern::reactor reactor;
+    ASSERT_TRUE(reactor);
+
+    client->FlushOnTick(&reactor);
+
+    *client << std::uint32_t(1) << std::uint32_t(2);
+    EXPECT_EQ(client->Pending(), 8u);
+
+    // Does not wait, since a flush is deferred
+    EXPECT_EQ(reactor.run_once(-1), 0);
+    EXPECT_EQ(client->Pending(), 0u);
+
+    EXPECT_EQ(Drain().size(), 8u);
+
+    // Nothing left to do
+    EXPECT_EQ(reactor.run_once(0), 0);
+
+    // A channel destroyed with a flush deferred is skipped
+    *client << std::uint32_t(3);
+    client.reset();
+
+    EXPECT_EQ(reactor.run_once(0), 0);
+}
+
+TEST_F(StreamChannelTest, FlushOnTickRetries) {
+    jfern::reactor reactor;
+    ASSERT_TRUE(reactor);
+
+    client->FlushOnTick(&reactor);
+
+    // Nobody reads from the peer, so the socket eventually backs up
+    const std::uint64_t value = 0;
+
+    jfern::NetError error = jfern::NetError::kSuccess;
+    for (int i = 0; i < 1000000 && error == jfern::NetError::kSuccess; i++) {
+        error = client->Write(value);
+    }
+
+    ASSERT_EQ(error, jfern::NetError::kWouldBlock);
+    ASSERT_GT(client->Pending(), 0u);
+
+    // The channel waits for POLLOUT rather than polling on a timer, so the
+    // reactor sleeps while the peer isn't reading
+    EXPECT_EQ(reactor.run_once(0), 0);
+    EXPECT_GT(client->Pending(), 0u);
+    EXPECT_EQ(reactor.size(), 1u);
+    EXPECT_EQ(reactor.timers().next_timeout(), -1);
+
+    EXPECT_EQ(reactor.run_once(20), 0);
+
+    // Once the peer reads, the rest goes out without any further writes
+    std::uint8_t buf[4096];
+    for (int i = 0; i < 1000 && client->Pending() > 0; i++) {
+        while (::read(peer->Fd().get(), buf, sizeof(buf)) > 0) {}
+        reactor.run_once(5);
+    }
+
+    EXPECT_EQ(client->Pending(), 0u);
+
+    // ...and the channel stops waiting
+    EXPECT_EQ(reactor.size(), 0u);
+}
+
+TEST_F(StreamChannelTest, FlushOnTickSharesSink) {
+    jfern::reactor reactor;
+    ASSERT_TRUE(reactor);
+
+    client->FlushOnTick(&reactor);
+
+    // The application already waits on the socket for input
+    auto sink = std::make_shared<jfern::fd_event_sink>(
+        std::unique_ptr<jfern::fd_interface>(new jfern::shared_fd(
+            client->Fd())));
+    ASSERT_TRUE(sink->add_events(POLLIN, [](short, jfern::fd_interface&) {}));
+    ASSERT_TRUE(reactor.add(sink));
+
+    const std::uint64_t value = 0;
+
+    jfern::NetError error = jfern::NetError::kSuccess;
+    for (int i = 0; i < 1000000 && error == jfern::NetError::kSuccess; i++) {
+        error = client->Write(value);
+    }
+
+    ASSERT_EQ(error, jfern::NetError::kWouldBlock);
+
+    // The channel adds its POLLOUT handler to the existing sink
+    reactor.run_once(0);
+    EXPECT_EQ(reactor.size(), 1u);
+    EXPECT_EQ(sink->events(), POLLIN | POLLOUT);
+
+    std::uint8_t buf[4096];
+    for (int i = 0; i < 1000 && client->Pending() > 0; i++) {
+        while (::read(peer->Fd().get(), buf, sizeof(buf)) > 0) {}
+        reactor.run_once(5);
+    }
+
+    EXPECT_EQ(client->Pending(), 0u);
+    EXPECT_EQ(sink->events(), POLLIN);
+    EXPECT_TRUE(reactor.contains(client->Fd().get()));
+}
+
+TEST_F(StreamChannelTest, BufferedReads) {
+    std::vector<std::uint8_t> data;
+    for (std::uint16_t i = 0; i < 16; i++) {
+        data.push_back(static_cast<std::uint8_t>(i >> 8));
+        data.push_back(static_cast<std::uint8_t>(i));
+    }
+
+    ASSERT_EQ(::write(peer->Fd().get(), data.data(), data.size()),
+              static_cast<ssize_t>(data.size()));
+    ASSERT_TRUE(wait_readable(client->Fd().get()));
+
+    std::uint16_t value = 0;
+
+    *client >> value;
+    EXPECT_EQ(value, 0u);
+
+    // A single read(2) buffered everything
+    EXPECT_EQ(client->Available(), data.size() - sizeof(value));
+
+    for (std::uint16_t i = 1; i < 16; i++) {
+        *client >> value;
+        EXPECT_EQ(value, i);
+    }
+
+    EXPECT_EQ(client->Status(), jfern::NetError::kSuccess);
+    EXPECT_EQ(client->Available(), 0u);
+}
+
+TEST_F(StreamChannelTest, ReadIsAllOrNothing) {
+    const std::uint8_t bytes[] = {0x01, 0x02, 0x03, 0x04};
+
+    ASSERT_EQ(::write(peer->Fd().get(), bytes, 2), 2);
+    ASSERT_TRUE(wait_readable(client->Fd().get()));
+
+    std::uint32_t value = 0;
+    EXPECT_EQ(client->Read(&value), jfern::NetError::kWouldBlock);
+    EXPECT_EQ(value, 0u);
+    EXPECT_EQ(client->Available(), 2u);
+
+    // The stream operators stop at the first failure
+    *client >> value;
+    EXPECT_EQ(client->Status(), jfern::NetError::kWouldBlock);
+
+    ASSERT_EQ(::write(peer->Fd().get(), bytes + 2, 2), 2);
+    ASSERT_TRUE(wait_readable(client->Fd().get()));
+
+    *client >> value;
+    EXPECT_EQ(value, 0u);
+
+    client->ClearStatus();
+    *client >> value;
+    EXPECT_EQ(client->Status(), jfern::NetError::kSuccess);
+    EXPECT_EQ(value, 0x01020304u);
+}
+
+TEST_F(StreamChannelTest, Backpressure) {
+    // Nobody reads from the peer, so the socket eventually backs up
+    const std::uint64_t value = 0;
+
+    jfern::NetError error = jfern::NetError::kSuccess;
+    for (int i = 0; i < 1000000 && error == jfern::NetError::kSuccess; i++) {
+        error = client->Write(value);
+    }
+
+    EXPECT_EQ(error, jfern::NetError::kWouldBlock);
+    EXPECT_LE(client->Pending(), 64u);
+}
+
+TEST_F(StreamChannelTest, PeerClosed) {
+    EXPECT_EQ(peer->Close(), jfern::NetError::kSuccess);
+    EXPECT_FALSE(*peer);
+
+    ASSERT_TRUE(wait_readable(client->Fd().get()));
+
+    std::uint32_t value;
+    EXPECT_EQ(client->Read(&value), jfern::NetError::kClosed);
+    EXPECT_EQ(client->Fill(), jfern::NetError::kClosed);
+}
+
+}  // namespace
@@ -0,0 +1,287 @@
+/**
+ *  \file   tcp_server-ut.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "fd_test_helpers.h"
+#include "net/stream_channel.h"
+#include "net/tcp_server.h"
+#include "networking/reactor.h"
+
+namespace {
+/**
+ * Connect several clients to a local port
+ */
+std::vector<std::unique_ptr<jfern::StreamChannel>> connect_clients(
+        std::uint16_t port, std::size_t count) {
+    std::vector<std::unique_ptr<jfern::StreamChannel>> clients;
+
+    for (std::size_t i = 0; i < count; i++) {
+        clients.emplace_back(new jfern::StreamChannel("127.0.0.1", port));
+    }
+
+    return clients;
+}
+
+TEST(TcpServer, StartStop) {
+    jfern::TcpServer server("127.0.0.1", 0);
+
+    EXPECT_FALSE(server.Listening());
+    EXPECT_EQ(server.Port(), 0u);
+    EXPECT_TRUE(server.Accept().expired());
+
+    ASSERT_EQ(server.Start(), jfern::NetError::kSuccess);
+    EXPECT_TRUE(server.Listening());
+    EXPECT_NE(server.Port(), 0u);
+
+    // Nothing pending
+    EXPECT_TRUE(server.Accept().expired());
+
+    EXPECT_EQ(server.Stop(), jfern::NetError::kSuccess);
+    EXPECT_FALSE(server.Listening());
+}
+
+TEST(TcpServer, AcceptAllDrainsBacklog) {
+    constexpr std::size_t n_clients = 20;
+
+    jfern::TcpServer server("127.0.0.1", 0);
+    ASSERT_EQ(server.Start(), jfern::NetError::kSuccess);
+
+    auto clients = connect_clients(server.Port(), n_clients);
+    for (const auto& client : clients) ASSERT_TRUE(*client);
+
+    std::vector<std::weak_ptr<jfern::StreamChannel>> accepted;
+
+    auto sink = server.EventSink(nullptr);
+    ASSERT_TRUE(sink);
+
+    while (accepted.size() < n_clients) {
+        ASSERT_TRUE(wait_readable(sink->get()));
+        server.AcceptAll([&](std::weak_ptr<jfern::StreamChannel> channel) {
+            accepted.push_back(channel);
+        });
+    }
+
+    EXPECT_EQ(accepted.size(), n_clients);
+    EXPECT_EQ(server.Channels(), n_clients);
+
+    for (const auto& channel : accepted) {
+        ASSERT_FALSE(channel.expired());
+        EXPECT_FALSE(channel.lock()->Fd().is_blocking());
+    }
+
+    // Releasing a connection closes it
+    EXPECT_EQ(server.Release(accepted[0]), jfern::NetError::kSuccess);
+    EXPECT_TRUE(accepted[0].expired());
+    EXPECT_EQ(server.Release(accepted[0]),
+              jfern::NetError::kInvalidArgument);
+    EXPECT_EQ(server.Channels(), n_clients - 1);
+
+    // Reset releases the rest
+    EXPECT_EQ(server.Reset(), jfern::NetError::kSuccess);
+    EXPECT_EQ(server.Channels(), 0u);
+    EXPECT_TRUE(accepted[1].expired());
+}
+
+TEST(TcpServer, MaxAccepts) {
+    jfern::TcpServer::Options options;
+    options.max_accepts = 2;
+
+    jfern::TcpServer server("127.0.0.1", 0, options);
+    ASSERT_EQ(server.Start(), jfern::NetError::kSuccess);
+
+    auto clients = connect_clients(server.Port(), 5);
+
+    std::size_t total = 0;
+    for (int i = 0; i < 1000 && total < clients.size(); i++) {
+        const std::size_t count = server.AcceptAll(nullptr);
+        EXPECT_LE(count, options.max_accepts);
+        total += count;
+    }
+
+    EXPECT_EQ(server.Channels(), clients.size());
+}
+
+TEST(TcpServer, ReadWrite) {
+    jfern::TcpServer server("127.0.0.1", 0);
+    ASSERT_EQ(server.Start(), jfern::NetError::kSuccess);
+
+    jfern::StreamChannel client("127.0.0.1", server.Port());
+    ASSERT_TRUE(client);
+
+    std::weak_ptr<jfern::StreamChannel> accepted;
+    for (int i = 0; i < 1000 && accepted.expired(); i++) {
+        accepted = server.Accept();
+    }
+    ASSERT_FALSE(accepted.expired());
+
+    auto channel = accepted.lock();
+
+    const std::uint32_t value = 0x01020304;
+    ASSERT_EQ(client.Write(value), jfern::NetError::kSuccess);
+    ASSERT_EQ(client.Flush(), jfern::NetError::kSuccess);
+
+    ASSERT_TRUE(wait_readable(channel->Fd().get()));
+
+    std::uint32_t received = 0;
+    ASSERT_EQ(channel->Read(&received), jfern::NetError::kSuccess);
+    EXPECT_EQ(received, value);
+
+    // Nothing more to read
+    std::uint8_t byte;
+    std::size_t nbytes = 1;
+    EXPECT_EQ(channel->Read(&byte, &nbytes), jfern::NetError::kWouldBlock);
+    EXPECT_EQ(nbytes, 0u);
+
+    EXPECT_EQ(client.Close(), jfern::NetError::kSuccess);
+    EXPECT_FALSE(client);
+
+    ASSERT_TRUE(wait_readable(channel->Fd().get()));
+
+    nbytes = 1;
+    EXPECT_EQ(channel->Read(&byte, &nbytes), jfern::NetError::kClosed);
+}
+
+TEST(TcpServer, DeferAccept) {
+    jfern::TcpServer::Options options;
+    options.defer_accept_secs = 5;
+
+    jfern::TcpServer server("127.0.0.1", 0, options);
+    ASSERT_EQ(server.Start(), jfern::NetError::kSuccess);
+
+    auto sink = server.EventSink(nullptr);
+    ASSERT_TRUE(sink);
+
+    int value = 0;
+    socklen_t len = sizeof(value);
+    ASSERT_EQ(::getsockopt(sink->get(), IPPROTO_TCP, TCP_DEFER_ACCEPT,
+                           &value, &len), 0);
+    EXPECT_GT(value, 0);
+
+    jfern::StreamChannel client("127.0.0.1", server.Port());
+    ASSERT_TRUE(client);
+
+    // Not reported until the client sends something
+    EXPECT_FALSE(wait_readable(sink->get(), 100));
+    EXPECT_TRUE(server.Accept().expired());
+
+    ASSERT_EQ(client.Write(std::uint8_t(1)), jfern::NetError::kSuccess);
+    ASSERT_EQ(client.Flush(), jfern::NetError::kSuccess);
+
+    ASSERT_TRUE(wait_readable(sink->get()));
+    EXPECT_FALSE(server.Accept().expired());
+}
+
+TEST(TcpServer, ReusePortSharding) {
+    constexpr std::size_t n_clients = 32;
+
+    jfern::TcpServer::Options options;
+    options.reuse_port = true;
+
+    jfern::TcpServer first("127.0.0.1", 0, options);
+    ASSERT_EQ(first.Start(), jfern::NetError::kSuccess);
+
+    jfern::TcpServer second("127.0.0.1", first.Port(), options);
+    ASSERT_EQ(second.Start(), jfern::NetError::kSuccess);
+
+    // Without SO_REUSEPORT the port is taken
+    jfern::TcpServer third("127.0.0.1", first.Port());
+    EXPECT_EQ(third.Start(), jfern::NetError::kSystemError);
+
+    auto clients = connect_clients(first.Port(), n_clients);
+
+    std::size_t total = 0;
+    for (int i = 0; i < 1000 && total < n_clients; i++) {
+        total += first.AcceptAll(nullptr) + second.AcceptAll(nullptr);
+    }
+
+    EXPECT_EQ(total, n_clients);
+    EXPECT_EQ(first.Channels() + second.Channels(), n_clients);
+}
+
+TEST(TcpServer, OutOfDescriptors) {
+    jfern::TcpServer server("127.0.0.1", 0);
+    ASSERT_EQ(server.Start(), jfern::NetError::kSuccess);
+
+    auto sink = server.EventSink(nullptr);
+    ASSERT_TRUE(sink);
+
+    jfern::StreamChannel client("127.0.0.1", server.Port());
+    ASSERT_TRUE(client);
+    ASSERT_TRUE(wait_readable(sink->get()));
+
+    // Allow no new descriptors beyond those already open
+    const int lowest_free = ::dup(sink->get());
+    ASSERT_GE(lowest_free, 0);
+    ::close(lowest_free);
+
+    struct rlimit original;
+    ASSERT_EQ(::getrlimit(RLIMIT_NOFILE, &original), 0);
+
+    struct rlimit limited = original;
+    limited.rlim_cur = static_cast<rlim_t>(lowest_free);
+    ASSERT_EQ(::setrlimit(RLIMIT_NOFILE, &limited), 0);
+
+    const std::size_t accepted = server.AcceptAll(nullptr);
+
+    ASSERT_EQ(::setrlimit(RLIMIT_NOFILE, &original), 0);
+
+    // The connection was dropped rather than left pending, so the listener
+    // is no longer readable
+    EXPECT_EQ(accepted, 0u);
+    EXPECT_EQ(server.Channels(), 0u);
+    EXPECT_FALSE(wait_readable(sink->get(), 0));
+
+    ASSERT_TRUE(wait_readable(client.Fd().get()));
+    EXPECT_EQ(client.Fill(), jfern::NetError::kClosed);
+
+    // Once descriptors are available, connections are accepted again
+    jfern::StreamChannel next("127.0.0.1", server.Port());
+    ASSERT_TRUE(wait_readable(sink->get()));
+    EXPECT_EQ(server.AcceptAll(nullptr), 1u);
+}
+
+TEST(TcpServer, Reactor) {
+    constexpr std::size_t n_clients = 10;
+
+    jfern::TcpServer server("127.0.0.1", 0);
+    ASSERT_EQ(server.Start(), jfern::NetError::kSuccess);
+
+    std::size_t accepted = 0;
+    auto sink = server.EventSink(
+        [&accepted](std::weak_ptr<jfern::StreamChannel> channel) {
+            EXPECT_FALSE(channel.expired());
+            accepted++;
+        });
+    ASSERT_TRUE(sink);
+
+    jfern::reactor reactor;
+    ASSERT_TRUE(reactor.add(sink));
+
+    auto clients = connect_clients(server.Port(), n_clients);
+
+    for (int i = 0; i < 100 && accepted < n_clients; i++) {
+        ASSERT_GE(reactor.run_once(100), 0);
+    }
+
+    EXPECT_EQ(accepted, n_clients);
+    EXPECT_EQ(server.Channels(), n_clients);
+}
+
+}  // namespace
@@ -0,0 +1,192 @@
+/**
+ *  \file   timer_wheel-ut.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/networking
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "networking/reactor.h"
+#include "networking/timer_wheel.h"
+
+namespace {
+using std::chrono::milliseconds;
+
+/**
+ * Get a time relative to the start of a wheel, which is taken to be the time
+ * at which the wheel was created
+ */
+class timer_wheel_test : public ::testing::Test {
+protected:
+    timer_wheel_test() : start(jfern::timer_wheel::clock::now()), wheel() {}
+
+    jfern::timer_wheel::clock::time_point at(milliseconds offset) const {
+        return start + offset;
+    }
+
+    jfern::timer_wheel::clock::time_point start;
+    jfern::timer_wheel wheel;
+};
+
+TEST_F(timer_wheel_test, expire_in_order) {
+    std::vector<int> order;
+
+    wheel.schedule(milliseconds(30), [&order]() { order.push_back(3); });
+    wheel.schedule(milliseconds(10), [&order]() { order.push_back(1); });
+    wheel.schedule(milliseconds(20), [&order]() { order.push_back(2); });
+
+    EXPECT_EQ(wheel.size(), 3u);
+    EXPECT_EQ(wheel.advance(at(milliseconds(5))), 0u);
+
+    EXPECT_EQ(wheel.advance(at(milliseconds(25))), 2u);
+    EXPECT_EQ(order, std::vector<int>({1, 2}));
+
+    EXPECT_EQ(wheel.advance(at(milliseconds(100))), 1u);
+    EXPECT_EQ(order, std::vector<int>({1, 2, 3}));
+    EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST_F(timer_wheel_test, cancel) {
+    int n_calls = 0;
+
+    const auto id = wheel.schedule(milliseconds(10), [&n_calls]() {
+        n_calls++;
+    });
+
+    ASSERT_NE(id, jfern::timer_wheel::invalid_timer);
+    EXPECT_TRUE(wheel.pending(id));
+
+    EXPECT_TRUE(wheel.cancel(id));
+    EXPECT_FALSE(wheel.pending(id));
+    EXPECT_FALSE(wheel.cancel(id));
+
+    EXPECT_EQ(wheel.advance(at(milliseconds(50))), 0u);
+    EXPECT_EQ(n_calls, 0);
+
+    // The node is recycled, but the stale identifier is not
+    const auto id2 = wheel.schedule(milliseconds(10), [&n_calls]() {
+        n_calls++;
+    });
+
+    EXPECT_NE(id2, id);
+    EXPECT_FALSE(wheel.cancel(id));
+    EXPECT_TRUE(wheel.pending(id2));
+
+    EXPECT_FALSE(wheel.cancel(jfern::timer_wheel::invalid_timer));
+    EXPECT_EQ(wheel.schedule(milliseconds(1), nullptr),
+              jfern::timer_wheel::invalid_timer);
+}
+
+TEST_F(timer_wheel_test, reschedule) {
+    int n_calls = 0;
+
+    const auto id = wheel.schedule(milliseconds(10), [&n_calls]() {
+        n_calls++;
+    });
+
+    EXPECT_TRUE(wheel.reschedule(id, milliseconds(500)));
+    EXPECT_EQ(wheel.advance(at(milliseconds(400))), 0u);
+    EXPECT_TRUE(wheel.pending(id));
+
+    EXPECT_EQ(wheel.advance(at(milliseconds(600))), 1u);
+    EXPECT_EQ(n_calls, 1);
+
+    EXPECT_FALSE(wheel.pending(id));
+    EXPECT_FALSE(wheel.reschedule(id, milliseconds(10)));
+}
+
+TEST_F(timer_wheel_test, cascade) {
+    // Delays spanning each wheel
+    const std::vector<milliseconds> delays = {
+        milliseconds(200), milliseconds(300), milliseconds(70000),
+        milliseconds(20000000), milliseconds(5000000000)
+    };
+
+    std::vector<milliseconds> fired;
+
+    for (const milliseconds delay : delays) {
+        wheel.schedule(delay, [&fired, delay]() { fired.push_back(delay); });
+    }
+
+    for (const milliseconds delay : delays) {
+        EXPECT_EQ(wheel.advance(at(delay - milliseconds(2))), 0u);
+        EXPECT_EQ(wheel.advance(at(delay + milliseconds(5))), 1u);
+        EXPECT_EQ(fired.back(), delay);
+    }
+
+    EXPECT_EQ(fired, delays);
+}
+
+TEST_F(timer_wheel_test, schedule_from_callback) {
+    int n_calls = 0;
+
+    std::function<void()> repeat;
+
+    repeat = [&]() {
+        if (++n_calls < 5)
+            wheel.schedule(milliseconds(10), [&repeat]() { repeat(); });
+    };
+
+    wheel.schedule(milliseconds(10), [&repeat]() { repeat(); });
+
+    EXPECT_EQ(wheel.advance(at(milliseconds(1000))), 5u);
+    EXPECT_EQ(n_calls, 5);
+    EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST_F(timer_wheel_test, cancel_from_callback) {
+    int n_calls = 0;
+
+    jfern::timer_wheel::timer_id second = jfern::timer_wheel::invalid_timer;
+
+    wheel.schedule(milliseconds(10), [&]() {
+        n_calls++;
+        EXPECT_TRUE(wheel.cancel(second));
+    });
+
+    second = wheel.schedule(milliseconds(10), [&n_calls]() { n_calls++; });
+
+    EXPECT_EQ(wheel.advance(at(milliseconds(20))), 1u);
+    EXPECT_EQ(n_calls, 1);
+}
+
+TEST_F(timer_wheel_test, next_timeout) {
+    EXPECT_EQ(wheel.next_timeout(at(milliseconds(0))), -1);
+
+    wheel.schedule(milliseconds(100), []() {});
+
+    const int timeout = wheel.next_timeout(at(milliseconds(0)));
+    EXPECT_GE(timeout, 99);
+    EXPECT_LE(timeout, 101);
+
+    EXPECT_EQ(wheel.next_timeout(at(milliseconds(200))), 0);
+
+    wheel.advance(at(milliseconds(200)));
+    EXPECT_EQ(wheel.next_timeout(at(milliseconds(200))), -1);
+}
+
+TEST(timer_wheel, event_sink) {
+    jfern::reactor reactor;
+    jfern::timer_wheel wheel;
+
+    auto sink = wheel.event_sink();
+    ASSERT_TRUE(sink);
+    ASSERT_TRUE(reactor.add(sink));
+
+    int n_calls = 0;
+    wheel.schedule(milliseconds(5), [&n_calls]() { n_calls++; });
+
+    // The timerfd wakes the reactor, which does not know about the wheel
+    EXPECT_EQ(reactor.run_once(1000), 1);
+    EXPECT_EQ(n_calls, 1);
+    EXPECT_EQ(wheel.size(), 0u);
+}
+
+}  // namespace
@@ -0,0 +1,295 @@
+/**
+ *  \file   DatagramPool.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/io_tools
+ */
+
+#include <utility>
+
+#include "abort.h"
+#include "DatagramPool.h"
+
+namespace net
+{
+	/**
+	 * Default constructor. Creates an empty handle
+	 */
+	Datagram::Datagram() : _pool(nullptr), _slot(0)
+	{
+	}
+
+	/**
+	 * Constructor. Adopts a slot whose reference count already
+	 * accounts for *this
+	 *
+	 * @param[in] pool The pool owning the slot
+	 * @param[in] slot The index of the slot
+	 */
+	Datagram::Datagram(DatagramPool* pool, size_t slot)
+		: _pool(pool), _slot(slot)
+	{
+	}
+
+	/**
+	 * Copy constructor
+	 *
+	 * @param[in] datagram The handle whose slot to share
+	 */
+	Datagram::Datagram(const Datagram& datagram)
+		: _pool(datagram._pool), _slot(datagram._slot)
+	{
+		if (_pool)
+		{
+			_pool->_slots[_slot].refs.fetch_add(1,
+				std::memory_order_relaxed);
+		}
+	}
+
+	/**
+	 * Move constructor
+	 *
+	 * @param[in] datagram The handle whose slot to take over. It
+	 *                     is left empty
+	 */
+	Datagram::Datagram(Datagram&& datagram)
+		: _pool(datagram._pool), _slot(datagram._slot)
+	{
+		datagram._pool = nullptr;
+	}
+
+	/**
+	 * Copy assignment operator
+	 *
+	 * @param[in] datagram The handle whose slot to share
+	 *
+	 * @return *this
+	 */
+	Datagram& Datagram::operator=(const Datagram& datagram)
+	{
+		if (this != &datagram)
+		{
+			Datagram copy(datagram);
+			*this = std::move(copy);
+		}
+
+		return *this;
+	}
+
+	/**
+	 * Move assignment operator
+	 *
+	 * @param[in] datagram The handle whose slot to take over. It
+	 *                     is left empty
+	 *
+	 * @return *this
+	 */
+	Datagram& Datagram::operator=(Datagram&& datagram)
+	{
+		if (this != &datagram)
+		{
+			reset();
+
+			_pool = datagram._pool;
+			_slot = datagram._slot;
+
+			datagram._pool = nullptr;
+		}
+
+		return *this;
+	}
+
+	/**
+	 * Destructor. Returns the slot to its pool if this is the last
+	 * handle referring to it
+	 */
+	Datagram::~Datagram()
+	{
+		reset();
+	}
+
+	/**
+	 * C++ boolean type conversion
+	 *
+	 * @return True if this handle refers to a datagram
+	 */
+	Datagram::operator bool() const
+	{
+		return _pool != nullptr;
+	}
+
+	/**
+	 * Get a view of the datagram
+	 *
+	 * @return The datagram contents, or an empty buffer if this
+	 *         handle is empty
+	 */
+	ConstDataBuffer Datagram::buffer() const
+	{
+		return ConstDataBuffer(get(), size());
+	}
+
+	/**
+	 * Get the datagram contents
+	 *
+	 * @return The contents, or null if this handle is empty
+	 */
+	const char* Datagram::get() const
+	{
+		return _pool ? _pool->_slots[_slot].data : nullptr;
+	}
+
+	/**
+	 * Drop this handle's reference, leaving it empty
+	 */
+	void Datagram::reset()
+	{
+		if (_pool)
+		{
+			_pool->_release(_slot);
+			_pool = nullptr;
+		}
+	}
+
+	/**
+	 * Get the size of the datagram
+	 *
+	 * @return The size, in bytes, or zero if this handle is empty
+	 */
+	size_t Datagram::size() const
+	{
+		return _pool ? _pool->_slots[_slot].size : 0;
+	}
+
+	/**
+	 * Get the node which sent the datagram. This handle must not be
+	 * empty
+	 *
+	 * @return The source address
+	 */
+	const struct sockaddr_in& Datagram::source() const
+	{
+		return _pool->_slots[_slot].source;
+	}
+
+	/**
+	 * Get the number of handles referring to this datagram
+	 *
+	 * @return The reference count, or zero if this handle is empty
+	 */
+	size_t Datagram::use_count() const
+	{
+		if (!_pool) return 0;
+
+		return _pool->_slots[_slot].refs.load(
+			std::memory_order_relaxed);
+	}
+
+	/**
+	 * Constructor
+	 *
+	 * @param[in] count    The number of slots, i.e. the number of
+	 *                     datagrams which may be held at once
+	 * @param[in] max_size The size of each slot. Longer datagrams
+	 *                     are truncated
+	 */
+	DatagramPool::DatagramPool(size_t count, size_t max_size)
+		: _free(),
+		  _max_size(max_size),
+		  _mutex(),
+		  _slots(count),
+		  _storage(new char[count * max_size])
+	{
+		_free.reserve(count);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			_slots[i].data = _storage + i * max_size;
+			_slots[i].refs.store(0, std::memory_order_relaxed);
+			_slots[i].size = 0;
+
+			// Hand out low slots first
+			_free.push_back(count - i - 1);
+		}
+	}
+
+	/**
+	 * Destructor
+	 */
+	DatagramPool::~DatagramPool()
+	{
+		delete[] _storage;
+	}
+
+	/**
+	 * Get the number of unused slots
+	 *
+	 * @return The number of datagrams which can be received before
+	 *         the pool is exhausted
+	 */
+	size_t DatagramPool::available() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _free.size();
+	}
+
+	/**
+	 * Get the total number of slots
+	 *
+	 * @return The number of slots
+	 */
+	size_t DatagramPool::capacity() const
+	{
+		return _slots.size();
+	}
+
+	/**
+	 * Get the size of each slot
+	 *
+	 * @return The size, in bytes
+	 */
+	size_t DatagramPool::max_size() const
+	{
+		return _max_size;
+	}
+
+	/**
+	 * Take an unused slot
+	 *
+	 * @return A handle to the slot, or an empty handle if the pool
+	 *         is exhausted
+	 */
+	Datagram DatagramPool::_acquire()
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		AbortIf(_free.empty(), Datagram(), "pool exhausted");
+
+		const size_t slot = _free.back();
+		_free.pop_back();
+
+		_slots[slot].refs.store(1, std::memory_order_relaxed);
+		_slots[slot].size = 0;
+
+		return Datagram(this, slot);
+	}
+
+	/**
+	 * Drop a reference to a slot, returning it to the free list if
+	 * this was the last one
+	 *
+	 * @param[in] slot The index of the slot
+	 */
+	void DatagramPool::_release(size_t slot)
+	{
+		if (_slots[slot].refs.fetch_sub(1, std::memory_order_acq_rel)
+			== 1)
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			// Never reallocates, since the capacity is fixed
+			_free.push_back(slot);
+		}
+	}
+}
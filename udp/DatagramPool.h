@@ -0,0 +1,166 @@
+/**
+ *  \file   DatagramPool.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/io_tools
+ */
+
+#ifndef __DATAGRAM_POOL_H__
+#define __DATAGRAM_POOL_H__
+
+#include <netinet/in.h>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "ConstDataBuffer.h"
+
+namespace net
+{
+	class DatagramPool;
+
+	/**
+	 * A reference-counted handle to a datagram received into a slot
+	 * of a \ref DatagramPool. Copies share the slot, which returns
+	 * to the pool once the last handle referring to it is dropped,
+	 * so a datagram may be kept for as long as needed regardless
+	 * of later receives
+	 */
+	class Datagram
+	{
+		friend class DatagramPool;
+		friend class UdpConnection;
+
+	public:
+
+		Datagram();
+
+		Datagram(const Datagram& datagram);
+
+		Datagram(Datagram&& datagram);
+
+		Datagram& operator=(const Datagram& datagram);
+
+		Datagram& operator=(Datagram&& datagram);
+
+		~Datagram();
+
+		explicit operator bool() const;
+
+		ConstDataBuffer buffer() const;
+
+		const char* get() const;
+
+		void reset();
+
+		size_t size() const;
+
+		const struct sockaddr_in& source() const;
+
+		size_t use_count() const;
+
+	private:
+
+		Datagram(DatagramPool* pool, size_t slot);
+
+		/**
+		 * The pool owning our slot, or null if empty
+		 */
+		DatagramPool* _pool;
+
+		/**
+		 * The index of our slot
+		 */
+		size_t _slot;
+	};
+
+	/**
+	 * A fixed set of datagram-sized slots, all allocated up front,
+	 * from which \ref UdpConnection receives without allocating
+	 *
+	 * @note Handles may be copied and dropped from any thread. The
+	 *       pool must outlive all handles to its slots
+	 */
+	class DatagramPool
+	{
+		friend class Datagram;
+		friend class UdpConnection;
+
+	public:
+
+		DatagramPool(size_t count, size_t max_size = 65507);
+
+		DatagramPool(const DatagramPool& pool) = delete;
+
+		DatagramPool& operator=(const DatagramPool& pool) = delete;
+
+		~DatagramPool();
+
+		size_t available() const;
+
+		size_t capacity() const;
+
+		size_t max_size() const;
+
+	private:
+
+		/**
+		 * A datagram-sized region of the pool
+		 */
+		struct Slot
+		{
+			/**
+			 * The datagram contents
+			 */
+			char* data;
+
+			/**
+			 * The number of handles referring to this slot
+			 */
+			std::atomic<size_t> refs;
+
+			/**
+			 * The size of the datagram, in bytes
+			 */
+			size_t size;
+
+			/**
+			 * The node which sent the datagram
+			 */
+			struct sockaddr_in source;
+		};
+
+		Datagram _acquire();
+
+		void _release(size_t slot);
+
+		/**
+		 * Indices of unused slots
+		 */
+		std::vector<size_t> _free;
+
+		/**
+		 * The size of each slot, in bytes
+		 */
+		size_t _max_size;
+
+		/**
+		 * Protects \ref _free
+		 */
+		mutable std::mutex _mutex;
+
+		/**
+		 * The slots
+		 */
+		std::vector<Slot> _slots;
+
+		/**
+		 * Storage for all slots
+		 */
+		char* _storage;
+	};
+}
+
+#endif
@@ -0,0 +1,76 @@
+#include "UdpConnection.h"
+#include "abort.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+bool run()
+{
+	net::UdpConnection rx, tx;
+	AbortIfNot(rx.bind(12347, "localhost"), false);
+	AbortIfNot(tx.connect(12347, "localhost"), false);
+
+	net::DatagramPool pool(4);
+
+	const char* messages[] = {"one", "two", "three", "four"};
+
+	// Hold every datagram at once
+	std::vector<net::Datagram> held;
+
+	for (const char* msg : messages)
+	{
+		const net::ConstDataBuffer buf(msg, std::strlen(msg));
+		AbortIf(tx.send(buf) < 0, false);
+
+		net::Datagram datagram;
+		AbortIfNot(rx.recv(pool, datagram, 1000), false);
+		AbortIfNot(datagram, false, "nothing received");
+
+		held.push_back(datagram);
+		AbortIfNot(datagram.use_count() == 2, false);
+	}
+
+	AbortIfNot(pool.available() == 0, false);
+
+	for (size_t i = 0; i < held.size(); i++)
+	{
+		AbortIfNot(held[i].size() == std::strlen(messages[i]), false);
+		AbortIf(std::memcmp(held[i].get(), messages[i],
+			held[i].size()), false);
+
+		std::printf("held     '%.*s' (%zu bytes)\n",
+			static_cast<int>(held[i].size()), held[i].get(),
+			held[i].size());
+	}
+
+	// With every slot in use, receiving fails
+	const net::ConstDataBuffer buf("five", 4);
+	AbortIf(tx.send(buf) < 0, false);
+
+	net::Datagram datagram;
+	AbortIf(rx.recv(pool, datagram, 1000), false);
+
+	// Dropping a handle frees its slot
+	held.erase(held.begin());
+	AbortIfNot(pool.available() == 1, false);
+
+	AbortIfNot(rx.recv(pool, datagram, 1000), false);
+	AbortIfNot(datagram.size() == 4, false);
+
+	std::printf("received '%.*s' (%zu bytes)\n",
+		static_cast<int>(datagram.size()), datagram.get(),
+		datagram.size());
+
+	held.clear();
+	datagram.reset();
+	AbortIfNot(pool.available() == pool.capacity(), false);
+
+	std::printf("passed\n");
+	return true;
+}
+
+int main()
+{
+	return run() ? 0 : 1;
+}
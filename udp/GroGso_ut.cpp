@@ -0,0 +1,61 @@
+#include "UdpConnection.h"
+#include "abort.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+bool run()
+{
+	net::UdpConnection rx, tx;
+	AbortIfNot(rx.bind(12348, "localhost"), false);
+	AbortIfNot(tx.connect(12348, "localhost"), false);
+
+	if (!rx.enable_gro())
+		std::printf("GRO unsupported; receiving unsegmented\n");
+
+	const size_t n_segments   = 10;
+	const size_t segment_size = 100;
+
+	// Stamp each segment with its index
+	std::vector<char> payload(n_segments * segment_size);
+	for (size_t i = 0; i < n_segments; i++)
+		std::memset(&payload[i * segment_size], 'a' + i, segment_size);
+
+	const net::ConstDataBuffer buf(payload.data(), payload.size());
+
+	AbortIfNot(tx.send_segmented(buf, segment_size)
+		== static_cast<int>(payload.size()), false);
+
+	net::DatagramPool pool(4, 65536);
+	net::Datagram datagram;
+	std::vector<net::ConstDataBuffer> segments;
+
+	size_t received = 0, recv_calls = 0;
+	while (received < n_segments)
+	{
+		const int count = rx.recv(pool, datagram, segments, 1000);
+		AbortIf(count <= 0, false, "timed out");
+
+		for (const net::ConstDataBuffer& segment : segments)
+		{
+			AbortIfNot(segment.size() == segment_size, false);
+			AbortIfNot(segment[0] == static_cast<char>('a' + received),
+				false);
+			received++;
+		}
+
+		recv_calls++;
+	}
+
+	std::printf("sent %zu datagrams in 1 call, received them in %zu\n",
+		n_segments, recv_calls);
+	std::printf("passed\n");
+
+	return true;
+}
+
+int main()
+{
+	return run() ? 0 : 1;
+}
@@ -0,0 +1,425 @@
+/**
+ *  \file   Resolver.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/io_tools
+ */
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fstream>
+#include <netdb.h>
+#include <sstream>
+#include <strings.h>
+#include <sys/socket.h>
+#include <utility>
+
+#include "abort.h"
+#include "Resolver.h"
+
+namespace net
+{
+	namespace
+	{
+		/**
+		 * How long to wait before retrying a refresh that failed while
+		 * a previous answer is still being served
+		 */
+		const std::chrono::milliseconds retry_interval =
+			std::chrono::seconds(5);
+
+		/**
+		 * Parse a numeric IPv4 or IPv6 address, which needs no lookup
+		 *
+		 * @param[in]  name  The name to parse
+		 * @param[out] addrs The address, if \a name is numeric
+		 *
+		 * @return True if \a name is a numeric address
+		 */
+		bool parse_numeric(const std::string& name, HostAddresses& addrs)
+		{
+			struct in_addr  addr4;
+			struct in6_addr addr6;
+
+			addrs.ipv4.clear();
+			addrs.ipv6.clear();
+
+			if (::inet_pton(AF_INET, name.c_str(), &addr4) == 1)
+			{
+				addrs.ipv4.push_back(addr4);
+				return true;
+			}
+
+			if (::inet_pton(AF_INET6, name.c_str(), &addr6) == 1)
+			{
+				addrs.ipv6.push_back(addr6);
+				return true;
+			}
+
+			return false;
+		}
+	}
+
+	/**
+	 * Check whether there are any addresses
+	 *
+	 * @return True if there are neither IPv4 nor IPv6 addresses
+	 */
+	bool HostAddresses::empty() const
+	{
+		return ipv4.empty() && ipv6.empty();
+	}
+
+	/**
+	 * Constructor. Starts the background thread
+	 *
+	 * @param[in] ttl        How long answers remain fresh
+	 * @param[in] hosts_file If not empty, resolve names from this file,
+	 *                       in /etc/hosts format, instead of by way of
+	 *                       getaddrinfo()
+	 */
+	Resolver::Resolver(std::chrono::milliseconds ttl,
+		const std::string& hosts_file)
+		: _cache(),
+		  _queued(),
+		  _hosts_file(hosts_file),
+		  _mutex(),
+		  _queries(0),
+		  _queue(),
+		  _resolved(),
+		  _running(true),
+		  _ttl(ttl),
+		  _thread(&Resolver::_run, this)
+	{
+	}
+
+	/**
+	 * Destructor. Waits for any lookup in progress to finish
+	 */
+	Resolver::~Resolver()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_running = false;
+		}
+
+		_queued.notify_one();
+		_thread.join();
+	}
+
+	/**
+	 * Get the process-wide resolver, which uses getaddrinfo()
+	 *
+	 * @return The resolver
+	 */
+	Resolver& Resolver::instance()
+	{
+		static Resolver resolver;
+		return resolver;
+	}
+
+	/**
+	 * Look up a name without blocking. If there is no answer yet, one
+	 * is requested in the background
+	 *
+	 * @param[in]  name  A host name or numeric address
+	 * @param[out] addrs The addresses \a name resolves to
+	 *
+	 * @return True if addresses were found; false if the name could
+	 *         not be resolved or its lookup is still in progress
+	 */
+	bool Resolver::lookup(const std::string& name, HostAddresses& addrs)
+	{
+		if (parse_numeric(name, addrs))
+			return true;
+
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		bool answered;
+		return _find(name, addrs, answered);
+	}
+
+	/**
+	 * Start resolving a name in the background if it is not already
+	 * cached, e.g. before connecting to it
+	 *
+	 * @param[in] name A host name
+	 */
+	void Resolver::prefetch(const std::string& name)
+	{
+		HostAddresses addrs;
+		lookup(name, addrs);
+	}
+
+	/**
+	 * Get the number of lookups performed so far, whether they
+	 * succeeded or not
+	 *
+	 * @return The number of lookups
+	 */
+	size_t Resolver::queries() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _queries;
+	}
+
+	/**
+	 * Get the number of names in the cache, including names whose
+	 * lookup is in progress
+	 *
+	 * @return The number of names
+	 */
+	size_t Resolver::size() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _cache.size();
+	}
+
+	/**
+	 * Look up a name, waiting for an answer if there is none yet. A
+	 * cached answer is returned immediately, even if stale
+	 *
+	 * @param[in]  name    A host name or numeric address
+	 * @param[out] addrs   The addresses \a name resolves to
+	 * @param[in]  timeout The most time (in milliseconds) to wait for
+	 *                     an answer. Specifying -1 may wait forever,
+	 *                     and 0 behaves like \ref lookup()
+	 *
+	 * @return True if addresses were found. If the lookup is still in
+	 *         progress when \a timeout expires, returns false and sets
+	 *         errno to EAGAIN
+	 */
+	bool Resolver::resolve(const std::string& name, HostAddresses& addrs,
+		int timeout)
+	{
+		if (parse_numeric(name, addrs))
+			return true;
+
+		const Clock::time_point deadline =
+			Clock::now() + std::chrono::milliseconds(timeout);
+
+		std::unique_lock<std::mutex> lock(_mutex);
+
+		while (true)
+		{
+			bool answered;
+			const bool found = _find(name, addrs, answered);
+
+			if (answered)
+				return found;
+
+			if (timeout == 0 || (timeout > 0 && Clock::now() >= deadline))
+			{
+				errno = EAGAIN;
+				return false;
+			}
+
+			if (timeout < 0)
+				_resolved.wait(lock);
+			else
+				_resolved.wait_until(lock, deadline);
+		}
+	}
+
+	/**
+	 * Fetch an answer from the cache, queueing a lookup if there is no
+	 * answer or the answer is stale. The caller must hold \ref _mutex
+	 *
+	 * @param[in]  name     The host name
+	 * @param[out] addrs    The cached addresses, if any
+	 * @param[out] answered True if there was an answer, even if stale
+	 *                      or negative
+	 *
+	 * @return True if addresses were found
+	 */
+	bool Resolver::_find(const std::string& name, HostAddresses& addrs,
+		bool& answered)
+	{
+		Entry& entry = _cache[name];
+
+		answered = entry.valid;
+
+		if (entry.valid)
+			addrs = entry.addrs;
+		else
+		{
+			addrs.ipv4.clear();
+			addrs.ipv6.clear();
+		}
+
+		const bool stale = !entry.valid || Clock::now() >= entry.expires;
+
+		if (stale && !entry.pending)
+		{
+			entry.pending = true;
+			_queue.push_back(name);
+			_queued.notify_one();
+		}
+
+		return !addrs.empty();
+	}
+
+	/**
+	 * Drop answers nobody has asked for in a while, so that the cache
+	 * does not grow with every name ever looked up. An answer is kept
+	 * for one time to live after it goes stale, since a lookup in that
+	 * time is still served the stale answer. The caller must hold
+	 * \ref _mutex
+	 *
+	 * @param[in] now The current time
+	 */
+	void Resolver::_evict(Clock::time_point now)
+	{
+		for (auto iter = _cache.begin(); iter != _cache.end(); )
+		{
+			const Entry& entry = iter->second;
+
+			if (!entry.pending && now >= entry.expires + _ttl)
+				iter = _cache.erase(iter);
+			else
+				++iter;
+		}
+	}
+
+	/**
+	 * Resolve a name. May block for a long time
+	 *
+	 * @param[in]  name  The host name
+	 * @param[out] addrs The addresses \a name resolves to
+	 *
+	 * @return True if any addresses were found
+	 */
+	bool Resolver::_query(const std::string& name,
+		HostAddresses& addrs) const
+	{
+		if (!_hosts_file.empty())
+			return _read_hosts(name, addrs);
+
+		struct addrinfo hints = {};
+		hints.ai_family   = AF_UNSPEC;
+		hints.ai_socktype = SOCK_DGRAM;
+
+		struct addrinfo* result = nullptr;
+		if (::getaddrinfo(name.c_str(), nullptr, &hints, &result) != 0)
+			return false;
+
+		for (struct addrinfo* ai = result; ai; ai = ai->ai_next)
+		{
+			if (ai->ai_family == AF_INET)
+			{
+				addrs.ipv4.push_back(reinterpret_cast<struct sockaddr_in*>(
+					ai->ai_addr)->sin_addr);
+			}
+			else if (ai->ai_family == AF_INET6)
+			{
+				addrs.ipv6.push_back(reinterpret_cast<struct sockaddr_in6*>(
+					ai->ai_addr)->sin6_addr);
+			}
+		}
+
+		::freeaddrinfo(result);
+
+		return !addrs.empty();
+	}
+
+	/**
+	 * Resolve a name from our hosts file. The file is re-read on each
+	 * lookup, so that changes are picked up once an answer expires
+	 *
+	 * @param[in]  name  The host name
+	 * @param[out] addrs The addresses \a name resolves to
+	 *
+	 * @return True if any addresses were found
+	 */
+	bool Resolver::_read_hosts(const std::string& name,
+		HostAddresses& addrs) const
+	{
+		std::ifstream file(_hosts_file);
+		AbortIfNot(file, false, "unable to open %s", _hosts_file.c_str());
+
+		std::string line;
+		while (std::getline(file, line))
+		{
+			const size_t comment = line.find('#');
+			if (comment != std::string::npos)
+				line.erase(comment);
+
+			std::istringstream fields(line);
+
+			std::string address, alias;
+			if (!(fields >> address))
+				continue;
+
+			while (fields >> alias)
+			{
+				if (::strcasecmp(alias.c_str(), name.c_str()) != 0)
+					continue;
+
+				HostAddresses numeric;
+				if (parse_numeric(address, numeric))
+				{
+					addrs.ipv4.insert(addrs.ipv4.end(),
+						numeric.ipv4.begin(), numeric.ipv4.end());
+					addrs.ipv6.insert(addrs.ipv6.end(),
+						numeric.ipv6.begin(), numeric.ipv6.end());
+				}
+
+				break;
+			}
+		}
+
+		return !addrs.empty();
+	}
+
+	/**
+	 * The background thread. Resolves queued names one at a time
+	 */
+	void Resolver::_run()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+
+		while (true)
+		{
+			_queued.wait(lock, [this]() {
+				return !_running || !_queue.empty();
+			});
+
+			if (!_running)
+				break;
+
+			const std::string name = std::move(_queue.front());
+			_queue.pop_front();
+
+			HostAddresses addrs;
+
+			lock.unlock();
+			_query(name, addrs);
+			lock.lock();
+
+			const Clock::time_point now = Clock::now();
+
+			Entry& entry = _cache[name];
+
+			// If a refresh fails, keep serving the previous answer rather
+			// than caching the failure, and try again sooner
+			if (addrs.empty() && entry.valid && !entry.addrs.empty())
+				entry.expires = now + std::min(_ttl, retry_interval);
+			else
+			{
+				entry.addrs   = std::move(addrs);
+				entry.expires = now + _ttl;
+			}
+
+			entry.valid   = true;
+			entry.pending = false;
+
+			_queries++;
+
+			_evict(now);
+
+			_resolved.notify_all();
+		}
+	}
+}
@@ -0,0 +1,186 @@
+/**
+ *  \file   Resolver.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/io_tools
+ */
+
+#ifndef __RESOLVER_H__
+#define __RESOLVER_H__
+
+#include <netinet/in.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace net
+{
+	/**
+	 * The addresses a host name resolves to
+	 */
+	struct HostAddresses
+	{
+		bool empty() const;
+
+		/**
+		 * IPv4 addresses, in the order returned by the resolver
+		 */
+		std::vector<struct in_addr> ipv4;
+
+		/**
+		 * IPv6 addresses, in the order returned by the resolver
+		 */
+		std::vector<struct in6_addr> ipv6;
+	};
+
+	/**
+	 * Resolves host names on a background thread and caches the
+	 * results, so that connection setup never stalls on DNS once a
+	 * name has been seen
+	 *
+	 * Each name is resolved at most once at a time no matter how
+	 * many callers ask for it. Answers are cached for a fixed time
+	 * to live, after which the stale answer is still handed out while
+	 * a refresh runs in the background. Failed lookups are cached
+	 * as well, so a storm of reconnects to an unknown host does not
+	 * become a storm of queries
+	 *
+	 * A refresh which fails leaves the previous answer in place, so a
+	 * transient DNS failure does not break a name that resolved. An
+	 * answer not asked for within a time to live of going stale is
+	 * dropped
+	 *
+	 * Names are resolved with getaddrinfo(), or, for testing, from a
+	 * hosts file alone
+	 */
+	class Resolver
+	{
+
+	public:
+
+		using Clock = std::chrono::steady_clock;
+
+		explicit Resolver(std::chrono::milliseconds ttl
+			= std::chrono::seconds(60),
+			const std::string& hosts_file = "");
+
+		Resolver(const Resolver& resolver) = delete;
+
+		Resolver& operator=(const Resolver& resolver) = delete;
+
+		~Resolver();
+
+		static Resolver& instance();
+
+		bool lookup(const std::string& name, HostAddresses& addrs);
+
+		void prefetch(const std::string& name);
+
+		size_t queries() const;
+
+		bool resolve(const std::string& name, HostAddresses& addrs,
+			int timeout = -1);
+
+		size_t size() const;
+
+	private:
+
+		/**
+		 * A cached answer
+		 */
+		struct Entry
+		{
+			/**
+			 * The answer; empty if the lookup failed
+			 */
+			HostAddresses addrs;
+
+			/**
+			 * When the answer goes stale
+			 */
+			Clock::time_point expires;
+
+			/**
+			 * True once an answer has been received
+			 */
+			bool valid;
+
+			/**
+			 * True while the name is queued or being resolved
+			 */
+			bool pending;
+		};
+
+		void _evict(Clock::time_point now);
+
+		bool _find(const std::string& name, HostAddresses& addrs,
+			bool& found);
+
+		bool _query(const std::string& name, HostAddresses& addrs) const;
+
+		bool _read_hosts(const std::string& name,
+			HostAddresses& addrs) const;
+
+		void _run();
+
+		/**
+		 * The cache, by name
+		 */
+		std::map<std::string, Entry> _cache;
+
+		/**
+		 * Signaled when the queue grows or on shutdown
+		 */
+		std::condition_variable _queued;
+
+		/**
+		 * If set, the hosts file to resolve names from in place of
+		 * getaddrinfo()
+		 */
+		const std::string _hosts_file;
+
+		/**
+		 * Guards all state shared with the background thread
+		 */
+		mutable std::mutex _mutex;
+
+		/**
+		 * The number of lookups performed so far
+		 */
+		size_t _queries;
+
+		/**
+		 * Names waiting to be resolved, in order of request
+		 */
+		std::deque<std::string> _queue;
+
+		/**
+		 * Signaled each time an answer arrives
+		 */
+		std::condition_variable _resolved;
+
+		/**
+		 * True while the background thread should keep running
+		 */
+		bool _running;
+
+		/**
+		 * How long answers remain fresh
+		 */
+		const std::chrono::milliseconds _ttl;
+
+		/**
+		 * The background thread. Declared last so that all other
+		 * state exists by the time it starts
+		 */
+		std::thread _thread;
+	};
+}
+
+#endif
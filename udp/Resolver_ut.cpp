@@ -0,0 +1,196 @@
+#include "Resolver.h"
+#include "UdpConnection.h"
+#include "abort.h"
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+	/**
+	 * Replace the contents of a hosts file
+	 */
+	bool write_hosts(const std::string& path, const std::string& contents)
+	{
+		std::ofstream file(path, std::ios::trunc);
+		file << contents;
+		return static_cast<bool>(file);
+	}
+
+	/**
+	 * Format the first IPv4 address of a lookup result
+	 */
+	std::string ipv4(const net::HostAddresses& addrs)
+	{
+		char text[INET_ADDRSTRLEN] = "";
+		if (!addrs.ipv4.empty())
+			::inet_ntop(AF_INET, &addrs.ipv4[0], text, sizeof(text));
+		return text;
+	}
+
+	/**
+	 * Wait for the resolver to complete a given number of lookups
+	 */
+	bool wait_for_queries(const net::Resolver& resolver, size_t count)
+	{
+		for (int i = 0; i < 1000 && resolver.queries() < count; i++)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		return resolver.queries() >= count;
+	}
+}
+
+bool run(const std::string& hosts)
+{
+	AbortIfNot(write_hosts(hosts,
+		"# test entries\n"
+		"10.1.2.3   alpha alpha.example  # trailing comment\n"
+		"10.1.2.4   beta\n"
+		"fe80::1    beta\n"
+		"127.0.0.1  loop.test\n"), false);
+
+	net::Resolver resolver(std::chrono::milliseconds(50), hosts);
+	net::HostAddresses addrs;
+
+	// Numeric addresses need no lookup
+	AbortIfNot(resolver.lookup("127.0.0.1", addrs), false);
+	AbortIfNot(ipv4(addrs) == "127.0.0.1", false);
+	AbortIfNot(resolver.lookup("::1", addrs), false);
+	AbortIfNot(addrs.ipv6.size() == 1, false);
+	AbortIfNot(resolver.queries() == 0, false);
+
+	// A name not yet seen is resolved in the background
+	AbortIf(resolver.lookup("alpha", addrs), false);
+	AbortIfNot(resolver.resolve("alpha", addrs, 1000), false);
+	AbortIfNot(ipv4(addrs) == "10.1.2.3", false);
+	AbortIfNot(resolver.queries() == 1, false);
+
+	// ...and then answered from the cache
+	AbortIfNot(resolver.lookup("alpha", addrs), false);
+	AbortIfNot(resolver.queries() == 1, false);
+
+	AbortIfNot(resolver.resolve("ALPHA.example", addrs, 1000), false);
+	AbortIfNot(ipv4(addrs) == "10.1.2.3", false);
+
+	AbortIfNot(resolver.resolve("beta", addrs, 1000), false);
+	AbortIfNot(addrs.ipv4.size() == 1 && addrs.ipv6.size() == 1, false);
+
+	// Failures are cached too
+	size_t queries = resolver.queries();
+	AbortIf(resolver.resolve("gamma", addrs, 1000), false);
+	AbortIf(resolver.resolve("gamma", addrs, 1000), false);
+	AbortIfNot(resolver.queries() == queries + 1, false);
+
+	// Concurrent requests for one name share a single lookup
+	queries = resolver.queries();
+	{
+		std::vector<std::thread> threads;
+		std::vector<char> results(8, 0);
+
+		for (size_t i = 0; i < results.size(); i++)
+		{
+			threads.emplace_back([&resolver, &results, i]() {
+				net::HostAddresses found;
+				results[i] = resolver.resolve("loop.test", found, 1000);
+			});
+		}
+
+		for (auto& thread : threads)
+			thread.join();
+
+		for (char result : results)
+			AbortIfNot(result, false);
+	}
+	AbortIfNot(resolver.queries() == queries + 1, false);
+
+	// Once stale, the old answer is served while it is refreshed
+	AbortIfNot(write_hosts(hosts, "10.9.9.9 alpha\n"), false);
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+	queries = resolver.queries();
+	AbortIfNot(resolver.lookup("alpha", addrs), false);
+	AbortIfNot(ipv4(addrs) == "10.1.2.3", false);
+
+	AbortIfNot(wait_for_queries(resolver, queries + 1), false);
+	AbortIfNot(resolver.lookup("alpha", addrs), false);
+	AbortIfNot(ipv4(addrs) == "10.9.9.9", false);
+
+	// A refresh which fails keeps the previous answer
+	AbortIfNot(write_hosts(hosts, "10.1.2.4 beta\n"), false);
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+	queries = resolver.queries();
+	AbortIfNot(resolver.lookup("alpha", addrs), false);
+
+	AbortIfNot(wait_for_queries(resolver, queries + 1), false);
+	AbortIfNot(resolver.lookup("alpha", addrs), false);
+	AbortIfNot(ipv4(addrs) == "10.9.9.9", false);
+
+	// Answers left unused for a time to live after going stale are
+	// dropped once the next lookup completes
+	std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+	AbortIf(resolver.resolve("delta", addrs, 1000), false);
+	AbortIfNot(resolver.size() == 1, false);
+
+	std::printf("resolver: %zu lookups\n", resolver.queries());
+
+	return true;
+}
+
+bool run_connection(const std::string& hosts)
+{
+	AbortIfNot(write_hosts(hosts, "127.0.0.1 loop.test\n"), false);
+
+	net::Resolver resolver(std::chrono::seconds(60), hosts);
+
+	// Never wait on the resolver
+	net::UdpConnection rx, tx;
+	rx.set_resolver(resolver, 0);
+	tx.set_resolver(resolver, 0);
+
+	// Not yet cached; the lookup starts in the background
+	errno = 0;
+	AbortIf(rx.bind(12350, "loop.test"), false);
+	AbortIfNot(errno == EAGAIN, false);
+
+	net::HostAddresses addrs;
+	AbortIfNot(resolver.resolve("loop.test", addrs, 1000), false);
+
+	AbortIfNot(rx.bind(12350, "loop.test"), false);
+	AbortIfNot(tx.connect(12350, "loop.test"), false);
+
+	const net::ConstDataBuffer buf("hello", 5);
+	AbortIf(tx.send(buf) < 0, false);
+
+	net::DataBuffer received;
+	AbortIfNot(rx.recv(received, 1000), false);
+	AbortIfNot(received.size() == 5, false);
+
+	std::printf("connection: received %zu bytes via loop.test\n",
+		received.size());
+
+	return true;
+}
+
+int main()
+{
+	char path[] = "/tmp/resolver_ut_XXXXXX";
+
+	const int fd = ::mkstemp(path);
+	AbortIf(fd < 0, 1);
+	::close(fd);
+
+	const bool ok = run(path) && run_connection(path);
+
+	::unlink(path);
+
+	return ok ? 0 : 1;
+}
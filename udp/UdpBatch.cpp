@@ -0,0 +1,188 @@
+/**
+ *  \file   UdpBatch.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/io_tools
+ */
+
+#include <cstring>
+
+#include "abort.h"
+#include "net.h"
+#include "UdpBatch.h"
+
+namespace net
+{
+	/**
+	 * Constructor
+	 *
+	 * @param[in] capacity The maximum number of datagrams sent or
+	 *                     received at once
+	 * @param[in] max_size The size of each receive buffer. Longer
+	 *                     datagrams are truncated
+	 */
+	UdpBatch::UdpBatch(size_t capacity, size_t max_size)
+		: _addrs(capacity),
+		  _iovs(capacity),
+		  _max_size(max_size),
+		  _msgs(capacity),
+		  _ring(new char[capacity * max_size]),
+		  _size(0)
+	{
+		_prepare_recv();
+	}
+
+	/**
+	 * Destructor
+	 */
+	UdpBatch::~UdpBatch()
+	{
+		delete[] _ring;
+	}
+
+	/**
+	 * Queue a datagram to be sent on a connected socket. The data
+	 * is not copied, and so must remain valid until it is sent.
+	 * Call \ref clear() before queueing into a batch which was
+	 * used to receive
+	 *
+	 * @param[in] buf The datagram
+	 *
+	 * @return True on success, or false if the batch is full
+	 */
+	bool UdpBatch::add(const ConstDataBuffer& buf)
+	{
+		AbortIfNot(buf, false);
+		AbortIfNot(_size < _msgs.size(), false, "batch is full");
+
+		struct iovec& iov = _iovs[_size];
+		iov.iov_base = const_cast<char*>(buf.get());
+		iov.iov_len  = buf.size();
+
+		struct msghdr& hdr = _msgs[_size].msg_hdr;
+		hdr.msg_name    = nullptr;
+		hdr.msg_namelen = 0;
+
+		_size++;
+		return true;
+	}
+
+	/**
+	 * Queue a datagram to be sent to a particular node, which need
+	 * not be the one the socket is connected to. The data is not
+	 * copied, and so must remain valid until it is sent
+	 *
+	 * @param[in] buf  The datagram
+	 * @param[in] addr The destination
+	 *
+	 * @return True on success, or false if the batch is full
+	 */
+	bool UdpBatch::add(const ConstDataBuffer& buf,
+		const struct sockaddr_in& addr)
+	{
+		AbortIfNot(add(buf), false);
+
+		const size_t index = _size - 1;
+		_addrs[index] = addr;
+
+		struct msghdr& hdr = _msgs[index].msg_hdr;
+		hdr.msg_name    = &_addrs[index];
+		hdr.msg_namelen = sizeof(addr);
+
+		return true;
+	}
+
+	/**
+	 * Get the maximum number of datagrams in a batch
+	 *
+	 * @return The number of slots
+	 */
+	size_t UdpBatch::capacity() const
+	{
+		return _msgs.size();
+	}
+
+	/**
+	 * Remove all datagrams, readying the batch to receive into its
+	 * ring of buffers or to have datagrams queued for sending
+	 */
+	void UdpBatch::clear()
+	{
+		_size = 0;
+		_prepare_recv();
+	}
+
+	/**
+	 * Get a received datagram. The buffer it refers to is reused
+	 * by the next receive
+	 *
+	 * @param[in] index The index of the datagram, less than \ref
+	 *                  size()
+	 *
+	 * @return The datagram, or an empty buffer if \a index is out
+	 *         of range
+	 */
+	DataBuffer UdpBatch::get(size_t index) const
+	{
+		AbortIfNot(index < _size, DataBuffer());
+
+		return DataBuffer(static_cast<char*>(_iovs[index].iov_base),
+			_msgs[index].msg_len);
+	}
+
+	/**
+	 * Get the size of each receive buffer
+	 *
+	 * @return The size, in bytes
+	 */
+	size_t UdpBatch::max_size() const
+	{
+		return _max_size;
+	}
+
+	/**
+	 * Get the number of datagrams received or queued
+	 *
+	 * @return The number of slots in use
+	 */
+	size_t UdpBatch::size() const
+	{
+		return _size;
+	}
+
+	/**
+	 * Get the node which sent a received datagram
+	 *
+	 * @param[in] index The index of the datagram, less than \ref
+	 *                  size()
+	 *
+	 * @return The source address
+	 */
+	const struct sockaddr_in& UdpBatch::source(size_t index) const
+	{
+		return _addrs[index];
+	}
+
+	/**
+	 * Point every slot at its receive buffer and source address
+	 */
+	void UdpBatch::_prepare_recv()
+	{
+		for (size_t i = 0; i < _msgs.size(); i++)
+		{
+			_iovs[i].iov_base = _ring + i * _max_size;
+			_iovs[i].iov_len  = _max_size;
+
+			struct msghdr& hdr = _msgs[i].msg_hdr;
+			std::memset(&hdr, 0, sizeof(hdr));
+
+			hdr.msg_name    = &_addrs[i];
+			hdr.msg_namelen = sizeof(_addrs[i]);
+			hdr.msg_iov     = &_iovs[i];
+			hdr.msg_iovlen  = 1;
+
+			_msgs[i].msg_len = 0;
+		}
+	}
+}
@@ -0,0 +1,106 @@
+/**
+ *  \file   UdpBatch.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/io_tools
+ */
+
+#ifndef __UDP_BATCH_H__
+#define __UDP_BATCH_H__
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <cstddef>
+#include <vector>
+
+#include "ConstDataBuffer.h"
+#include "DataBuffer.h"
+
+namespace net
+{
+	/**
+	 * A set of datagrams sent or received together with a single
+	 * sendmmsg() or recvmmsg(). All memory is allocated up front:
+	 * received datagrams are placed in a preallocated ring of
+	 * buffers, one per slot, while datagrams queued for sending
+	 * are referenced where they lie and never copied. Since the
+	 * message headers point into the ring, a batch cannot be
+	 * copied
+	 */
+	class UdpBatch
+	{
+		friend class UdpConnection;
+
+	public:
+
+		UdpBatch(size_t capacity, size_t max_size = max_datagram);
+
+		UdpBatch(const UdpBatch& batch) = delete;
+
+		UdpBatch& operator=(const UdpBatch& batch) = delete;
+
+		~UdpBatch();
+
+		bool add(const ConstDataBuffer& buf);
+
+		bool add(const ConstDataBuffer& buf,
+			const struct sockaddr_in& addr);
+
+		size_t capacity() const;
+
+		void clear();
+
+		DataBuffer get(size_t index) const;
+
+		size_t max_size() const;
+
+		size_t size() const;
+
+		const struct sockaddr_in& source(size_t index) const;
+
+		/**
+		 * The largest possible UDP payload over IPv4
+		 */
+		static const size_t max_datagram = 65507;
+
+	private:
+
+		void _prepare_recv();
+
+		/**
+		 * Socket addresses, one per slot: the sources of
+		 * received datagrams, or the destinations of those
+		 * being sent
+		 */
+		std::vector<struct sockaddr_in> _addrs;
+
+		/**
+		 * Scatter/gather entries, one per slot
+		 */
+		std::vector<struct iovec> _iovs;
+
+		/**
+		 * The maximum size of a received datagram
+		 */
+		size_t _max_size;
+
+		/**
+		 * Message headers passed to the kernel, one per slot
+		 */
+		std::vector<struct mmsghdr> _msgs;
+
+		/**
+		 * Receive storage for all slots, each \ref _max_size
+		 * bytes long
+		 */
+		char* _ring;
+
+		/**
+		 * The number of slots in use
+		 */
+		size_t _size;
+	};
+}
+
+#endif
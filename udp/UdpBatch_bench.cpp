@@ -0,0 +1,190 @@
+#include "UdpConnection.h"
+#include "abort.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+	/**
+	 * The number of datagrams exchanged by each test
+	 */
+	const size_t n_datagrams = 200000;
+
+	/**
+	 * The number of datagrams sent or received per system call
+	 * by the batched path
+	 */
+	const size_t batch_size = 64;
+
+	/**
+	 * The size of each datagram, typical of market data updates
+	 */
+	const size_t datagram_size = 128;
+
+	/**
+	 * Get the number of seconds elapsed since a start time
+	 */
+	double elapsed(std::chrono::steady_clock::time_point start)
+	{
+		const std::chrono::duration<double> diff =
+			std::chrono::steady_clock::now() - start;
+		return diff.count();
+	}
+
+	/**
+	 * Send and receive one datagram per system call
+	 *
+	 * @return The number of datagrams received per second, or -1
+	 *         on error
+	 */
+	double run_single(net::UdpConnection& rx, net::UdpConnection& tx)
+	{
+		std::vector<char> payload(datagram_size, 'x');
+
+		const net::ConstDataBuffer send_buf(payload.data(),
+			payload.size());
+		net::DataBuffer recv_buf;
+
+		const auto start = std::chrono::steady_clock::now();
+
+		size_t received = 0;
+		while (received < n_datagrams)
+		{
+			// Keep well below the socket buffer size so that
+			// nothing is dropped
+			for (size_t i = 0; i < batch_size; i++)
+				AbortIf(tx.send(send_buf) < 0, -1);
+
+			for (size_t i = 0; i < batch_size; i++)
+			{
+				AbortIfNot(rx.recv(recv_buf, 1000), -1);
+				AbortIf(recv_buf.size() == 0, -1, "timed out");
+				received++;
+			}
+		}
+
+		return received / elapsed(start);
+	}
+
+	/**
+	 * Send and receive \ref batch_size datagrams per system call
+	 *
+	 * @return The number of datagrams received per second, or -1
+	 *         on error
+	 */
+	double run_batched(net::UdpConnection& rx, net::UdpConnection& tx)
+	{
+		std::vector<char> payload(datagram_size, 'x');
+
+		const net::ConstDataBuffer send_buf(payload.data(),
+			payload.size());
+
+		net::UdpBatch send_batch(batch_size);
+		net::UdpBatch recv_batch(batch_size, datagram_size);
+
+		const auto start = std::chrono::steady_clock::now();
+
+		size_t received = 0;
+		while (received < n_datagrams)
+		{
+			send_batch.clear();
+			for (size_t i = 0; i < batch_size; i++)
+				AbortIfNot(send_batch.add(send_buf), -1);
+
+			while (send_batch.size() > 0)
+				AbortIf(tx.send(send_batch) < 0, -1);
+
+			size_t pending = batch_size;
+			while (pending > 0)
+			{
+				const int count = rx.recv(recv_batch, 1000);
+				AbortIf(count <= 0, -1, "timed out");
+
+				pending  -= count;
+				received += count;
+			}
+		}
+
+		return received / elapsed(start);
+	}
+
+	/**
+	 * Send \ref batch_size datagrams per system call by way of UDP
+	 * segmentation offload, receiving them with generic receive
+	 * offload
+	 *
+	 * @return The number of datagrams received per second, or -1
+	 *         on error
+	 */
+	double run_offload(net::UdpConnection& rx, net::UdpConnection& tx)
+	{
+		AbortIfNot(rx.enable_gro(), -1);
+
+		std::vector<char> payload(batch_size * datagram_size, 'x');
+
+		const net::ConstDataBuffer send_buf(payload.data(),
+			payload.size());
+
+		net::DatagramPool pool(4, 65536);
+		net::Datagram datagram;
+		std::vector<net::ConstDataBuffer> segments;
+
+		const auto start = std::chrono::steady_clock::now();
+
+		size_t received = 0;
+		while (received < n_datagrams)
+		{
+			AbortIf(tx.send_segmented(send_buf, datagram_size) < 0, -1);
+
+			size_t pending = batch_size;
+			while (pending > 0)
+			{
+				const int count = rx.recv(pool, datagram, segments, 1000);
+				AbortIf(count <= 0, -1, "timed out");
+
+				pending  -= count;
+				received += count;
+			}
+		}
+
+		AbortIfNot(rx.enable_gro(false), -1);
+
+		return received / elapsed(start);
+	}
+}
+
+bool run()
+{
+	net::UdpConnection rx, tx;
+	AbortIfNot(rx.bind(12346, "localhost"), false);
+	AbortIfNot(tx.connect(12346, "localhost"), false);
+
+	const double single  = run_single (rx, tx);
+	const double batched = run_batched(rx, tx);
+	const double offload = run_offload(rx, tx);
+
+	AbortIf(single < 0 || batched < 0, false);
+
+	std::printf("%zu datagrams of %zu bytes over loopback\n",
+		n_datagrams, datagram_size);
+	std::printf("per-datagram:         %12.0f datagrams/sec\n", single);
+	std::printf("batched (%3zu/call):   %12.0f datagrams/sec\n",
+		batch_size, batched);
+
+	if (offload < 0)
+		std::printf("GSO/GRO:              unsupported\n");
+	else
+	{
+		std::printf("GSO/GRO (%3zu/call):   %12.0f datagrams/sec\n",
+			batch_size, offload);
+	}
+
+	return true;
+}
+
+int main()
+{
+	return run() ? 0 : 1;
+}
@@ -7,14 +7,31 @@
  */
 
 #include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <climits>
 #include <cstring>
-#include <netdb.h>
+#include <netinet/udp.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
+#include <utility>
 
 #include "abort.h"
 #include "UdpConnection.h"
 
+// Not all C libraries define the UDP offload socket options yet
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
 namespace net
 {
 	/**
@@ -25,7 +42,16 @@ namespace net
 		  _is_connected(false),
 		  _is_init(_fd),
 		  _raw(nullptr),
-		  _size(0)
+		  _size(0),
+		  _remote_addr(),
+		  _resolver(&Resolver::instance()),
+		  _resolve_timeout(-1),
+		  _on_idle_timeout(),
+		  _idle_timeout(-1),
+		  _idle_timer(jfern::timer_wheel::invalid_timer),
+		  _next_retransmit(0),
+		  _retransmits(),
+		  _timers(nullptr)
 	{
 	}
 
@@ -34,9 +60,30 @@ namespace net
 	 */
 	UdpConnection::~UdpConnection()
 	{
+		_cancel_timers();
 		if (_raw) delete[] _raw;
 	}
 
+	/**
+	 * Stop retransmitting a datagram, e.g. because the remote node
+	 * has acknowledged it
+	 *
+	 * @param[in] id The identifier returned by \ref retransmit()
+	 *
+	 * @return True if the datagram was still being retransmitted
+	 */
+	bool UdpConnection::acknowledge(int id)
+	{
+		auto iter = _retransmits.find(id);
+		if (iter == _retransmits.end())
+			return false;
+
+		_timers->cancel(iter->second.timer);
+		_retransmits.erase(iter);
+
+		return true;
+	}
+
 	/**
 	 * Assign the port on which to listen for messages
 	 *
@@ -86,6 +133,50 @@ namespace net
 		return true;
 	}
 
+	/**
+	 * Enable or disable generic receive offload. When enabled, the
+	 * kernel may coalesce consecutive same-sized datagrams from one
+	 * sender into a single super-datagram, which must be received
+	 * with \ref recv(DatagramPool&, Datagram&,
+	 * std::vector<ConstDataBuffer>&, int) to be split up again
+	 *
+	 * @param[in] enable True to enable
+	 *
+	 * @return True on success, or false if unsupported
+	 */
+	bool UdpConnection::enable_gro(bool enable)
+	{
+		AbortIfNot(_is_init, false);
+
+		const int value = enable ? 1 : 0;
+
+		AbortIf(::setsockopt(_fd.get(), SOL_UDP, UDP_GRO, &value,
+			sizeof(value)) < 0, false);
+
+		return true;
+	}
+
+	/**
+	 * Allow other sockets to bind to the same port, in which case the
+	 * kernel distributes incoming datagrams among them. Must be called
+	 * before \ref bind()
+	 *
+	 * @param[in] enable True to enable SO_REUSEPORT
+	 *
+	 * @return True on success
+	 */
+	bool UdpConnection::reuse_port(bool enable)
+	{
+		AbortIfNot(_is_init, false);
+
+		const int value = enable ? 1 : 0;
+
+		AbortIf(::setsockopt(_fd.get(), SOL_SOCKET, SO_REUSEPORT, &value,
+			sizeof(value)) < 0, false);
+
+		return true;
+	}
+
 	/**
 	 * Receive data from a remote node
 	 *
@@ -120,6 +211,8 @@ namespace net
 		AbortIf(nbytes < 0, false);
 		buf = _data;
 
+		_touch();
+
 		if (conn)
 		{
 			std::memcpy(&_remote_addr, &s_addr,
@@ -133,6 +226,237 @@ namespace net
 		return true;
 	}
 
+	/**
+	 * Receive a batch of datagrams with a single recvmmsg(). Unlike
+	 * \ref recv(DataBuffer&, int, bool), this does not query the
+	 * datagram size or allocate; datagrams are placed directly in
+	 * the batch's preallocated buffers
+	 *
+	 * @param[out] batch   Receives up to batch.capacity() datagrams
+	 *                     along with their source addresses. Any
+	 *                     previous contents are discarded
+	 * @param[in]  timeout The timeout (in milliseconds) after which
+	 *                     this call will return, even if no data is
+	 *                     available for reading. Specifying -1 may
+	 *                     block indefinitely. If zero, no poll()
+	 *                     is made
+	 *
+	 * @return The number of datagrams received, or -1 on error
+	 */
+	int UdpConnection::recv(UdpBatch& batch, int timeout)
+	{
+		AbortIfNot(_is_init, -1);
+
+		batch.clear();
+
+		if (timeout != 0 && !_fd.can_read(timeout))
+			return 0;
+
+		const int count = ::recvmmsg(_fd.get(), batch._msgs.data(),
+			batch.capacity(), MSG_DONTWAIT, nullptr);
+
+		if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+			return 0;
+
+		AbortIf(count < 0, -1);
+
+		batch._size = count;
+		if (count > 0) _touch();
+
+		return count;
+	}
+
+	/**
+	 * Receive a datagram into a slot of a preallocated pool. Unlike
+	 * \ref recv(DataBuffer&, int, bool), nothing is allocated and
+	 * the datagram size is not queried, and the datagram remains
+	 * valid for as long as a handle to it is held
+	 *
+	 * @param[in]  pool     The pool to receive into
+	 * @param[out] datagram The datagram received, or an empty handle
+	 *                      if the timeout expired. Any datagram it
+	 *                      previously referred to is released
+	 * @param[in]  timeout  The timeout (in milliseconds) after which
+	 *                      this call will return, even if no data is
+	 *                      available for reading. Specifying -1 may
+	 *                      block indefinitely
+	 *
+	 * @return True on success, or false on error or if all slots of
+	 *         \a pool are in use
+	 */
+	bool UdpConnection::recv(DatagramPool& pool, Datagram& datagram,
+		int timeout)
+	{
+		AbortIfNot(_is_init, false);
+
+		datagram.reset();
+
+		if (!_fd.can_read(timeout))
+			return true;
+
+		Datagram received = pool._acquire();
+		AbortIfNot(received, false);
+
+		DatagramPool::Slot& slot = pool._slots[received._slot];
+
+		socklen_t addrlen = sizeof(slot.source);
+
+		const ssize_t nbytes = ::recvfrom(_fd.get(), slot.data,
+			pool.max_size(), MSG_DONTWAIT, to_sockaddr(&slot.source),
+			&addrlen);
+
+		if (nbytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+			return true;
+
+		AbortIf(nbytes < 0, false);
+
+		slot.size = nbytes;
+		datagram  = std::move(received);
+
+		_touch();
+		return true;
+	}
+
+	/**
+	 * Receive a datagram, which may have been coalesced by generic
+	 * receive offload (see \ref enable_gro()), into a slot of a
+	 * preallocated pool and split it back into the datagrams that
+	 * were sent
+	 *
+	 * @param[in]  pool     The pool to receive into. Its slots should
+	 *                      be large enough for a super-datagram,
+	 *                      i.e. 64 KiB
+	 * @param[out] datagram The data received, or an empty handle if
+	 *                      the timeout expired
+	 * @param[out] segments Views of the individual datagrams, which
+	 *                      remain valid while \a datagram is held
+	 * @param[in]  timeout  The timeout (in milliseconds) after which
+	 *                      this call will return, even if no data is
+	 *                      available for reading. Specifying -1 may
+	 *                      block indefinitely
+	 *
+	 * @return The number of datagrams received, or -1 on error or if
+	 *         all slots of \a pool are in use
+	 */
+	int UdpConnection::recv(DatagramPool& pool, Datagram& datagram,
+		std::vector<ConstDataBuffer>& segments, int timeout)
+	{
+		AbortIfNot(_is_init, -1);
+
+		datagram.reset();
+		segments.clear();
+
+		if (!_fd.can_read(timeout))
+			return 0;
+
+		Datagram received = pool._acquire();
+		AbortIfNot(received, -1);
+
+		DatagramPool::Slot& slot = pool._slots[received._slot];
+
+		struct iovec iov;
+		iov.iov_base = slot.data;
+		iov.iov_len  = pool.max_size();
+
+		// Aligned for the struct cmsghdr placed at its start
+		union
+		{
+			char buf[CMSG_SPACE(sizeof(int))];
+			struct cmsghdr align;
+		} control;
+
+		struct msghdr hdr;
+		std::memset(&hdr, 0, sizeof(hdr));
+
+		hdr.msg_name       = &slot.source;
+		hdr.msg_namelen    = sizeof(slot.source);
+		hdr.msg_iov        = &iov;
+		hdr.msg_iovlen     = 1;
+		hdr.msg_control    = control.buf;
+		hdr.msg_controllen = sizeof(control.buf);
+
+		const ssize_t nbytes = ::recvmsg(_fd.get(), &hdr, MSG_DONTWAIT);
+
+		if (nbytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+			return 0;
+
+		AbortIf(nbytes < 0, -1);
+
+		slot.size = nbytes;
+
+		// Without a segment size, this is an ordinary datagram
+		size_t segment_size = nbytes;
+
+		for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr); cmsg;
+			 cmsg = CMSG_NXTHDR(&hdr, cmsg))
+		{
+			if (cmsg->cmsg_level == SOL_UDP &&
+				cmsg->cmsg_type  == UDP_GRO)
+			{
+				int gso_size;
+				std::memcpy(&gso_size, CMSG_DATA(cmsg), sizeof(gso_size));
+
+				if (gso_size > 0) segment_size = gso_size;
+			}
+		}
+
+		for (size_t offset = 0; offset < slot.size; offset += segment_size)
+		{
+			const size_t remaining = slot.size - offset;
+
+			segments.push_back(ConstDataBuffer(slot.data + offset,
+				remaining < segment_size ? remaining : segment_size));
+		}
+
+		// Zero-length datagrams are still datagrams
+		if (slot.size == 0)
+			segments.push_back(ConstDataBuffer(slot.data, 0));
+
+		datagram = std::move(received);
+		_touch();
+
+		return segments.size();
+	}
+
+	/**
+	 * Send a datagram and keep resending it, with exponential backoff,
+	 * until it is acknowledged (see \ref acknowledge()) or a number
+	 * of attempts have been made. Requires \ref set_timers()
+	 *
+	 * @param[in] buf        The datagram to send, which is copied
+	 * @param[in] interval   The time (in milliseconds) to wait for an
+	 *                       acknowledgement before the first resend.
+	 *                       Doubles after each resend
+	 * @param[in] attempts   The most times to resend the datagram
+	 * @param[in] on_give_up Invoked if the datagram still has not been
+	 *                       acknowledged after the last resend
+	 *
+	 * @return An identifier to pass to \ref acknowledge(), or -1 on
+	 *         error
+	 */
+	int UdpConnection::retransmit(const ConstDataBuffer& buf, int interval,
+		int attempts, std::function<void()> on_give_up)
+	{
+		AbortIfNot(_timers, -1, "set_timers() has not been called.");
+		AbortIfNot(interval > 0 && attempts >= 0, -1);
+
+		AbortIf(send(buf, 0) < 0, -1);
+
+		const int id = _next_retransmit++;
+
+		Retransmit& entry = _retransmits[id];
+
+		entry.data.assign(buf.get(), buf.get() + buf.size());
+		entry.interval   = interval;
+		entry.remaining  = attempts;
+		entry.on_give_up = std::move(on_give_up);
+		entry.timer      = _timers->schedule(
+			std::chrono::milliseconds(interval),
+			[this, id]() { _on_retransmit(id); });
+
+		return id;
+	}
+
 	/**
 	 * Send data to a remote node
 	 *
@@ -175,9 +499,240 @@ namespace net
 		int nbytes  = ::write(_fd.get(), buf.get(), buf.size());
 		AbortIf(nbytes < 0, -1);
 
+		_touch();
 		return nbytes;
 	}
 
+	/**
+	 * Send a batch of datagrams with a single sendmmsg()
+	 *
+	 * @param[in] batch   The datagrams to send. Those queued without
+	 *                    a destination require a connected socket.
+	 *                    On return, only the datagrams which were
+	 *                    not sent remain, so that sending the same
+	 *                    batch again resumes where this call left
+	 *                    off
+	 * @param[in] timeout The maximum number of milliseconds to wait
+	 *                    for space to become available for writing;
+	 *                    specifying -1 may block indefinitely
+	 *
+	 * @return The number of datagrams sent, or -1 on error
+	 */
+	int UdpConnection::send(UdpBatch& batch, int timeout) const
+	{
+		AbortIfNot(_is_init, -1);
+
+		if (batch.size() == 0)
+			return 0;
+
+		for (size_t i = 0; i < batch.size(); i++)
+		{
+			AbortIfNot(_is_connected || batch._msgs[i].msg_hdr.msg_name,
+				-1, "send() without a destination is only allowed on "
+				"connected sockets.");
+		}
+
+		if (!_fd.can_write(timeout))
+			return 0;
+
+		const int count = ::sendmmsg(_fd.get(), batch._msgs.data(),
+			batch.size(), 0);
+		AbortIf(count < 0, -1);
+
+		// Shift the unsent datagrams to the front
+		const size_t remaining = batch.size() - count;
+
+		for (size_t i = 0; i < remaining; i++)
+		{
+			batch._addrs[i] = batch._addrs[i + count];
+			batch._iovs [i] = batch._iovs [i + count];
+
+			struct msghdr& hdr = batch._msgs[i].msg_hdr;
+			hdr = batch._msgs[i + count].msg_hdr;
+
+			if (hdr.msg_name) hdr.msg_name = &batch._addrs[i];
+			hdr.msg_iov = &batch._iovs[i];
+		}
+
+		batch._size = remaining;
+		if (count > 0) _touch();
+
+		return count;
+	}
+
+	/**
+	 * Send a buffer as a series of equally sized datagrams with a
+	 * single system call, using UDP segmentation offload. Where the
+	 * kernel or device does not support it, the datagrams are sent
+	 * one at a time instead
+	 *
+	 * @param[in] buf          The data to send. Its size should be
+	 *                         a multiple of \a segment_size; if not,
+	 *                         the last datagram is shorter
+	 * @param[in] segment_size The size of each datagram
+	 * @param[in] timeout      The maximum number of milliseconds to
+	 *                         wait for space to become available for
+	 *                         writing; specifying -1 may block
+	 *                         indefinitely
+	 *
+	 * @return The number of bytes written, or -1 on error
+	 */
+	int UdpConnection::send_segmented(const ConstDataBuffer& buf,
+		uint16 segment_size, int timeout) const
+	{
+		AbortIfNot(_is_init, -1);
+		AbortIfNot(buf, -1);
+		AbortIfNot(segment_size > 0, -1);
+		AbortIfNot(_is_connected, -1,
+				"send() is only allowed on connected sockets.");
+		AbortIf((buf.size() + segment_size - 1) / segment_size
+			> max_segments, -1, "too many segments");
+
+		if (!_fd.can_write(timeout))
+			return 0;
+
+		struct iovec iov;
+		iov.iov_base = const_cast<char*>(buf.get());
+		iov.iov_len  = buf.size();
+
+		// Aligned for the struct cmsghdr placed at its start
+		union
+		{
+			char buf[CMSG_SPACE(sizeof(uint16))];
+			struct cmsghdr align;
+		} control;
+		std::memset(control.buf, 0, sizeof(control.buf));
+
+		struct msghdr hdr;
+		std::memset(&hdr, 0, sizeof(hdr));
+
+		hdr.msg_iov        = &iov;
+		hdr.msg_iovlen     = 1;
+		hdr.msg_control    = control.buf;
+		hdr.msg_controllen = sizeof(control.buf);
+
+		struct cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr);
+		cmsg->cmsg_level = SOL_UDP;
+		cmsg->cmsg_type  = UDP_SEGMENT;
+		cmsg->cmsg_len   = CMSG_LEN(sizeof(uint16));
+		std::memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(uint16));
+
+		const ssize_t nbytes = ::sendmsg(_fd.get(), &hdr, 0);
+		if (nbytes >= 0)
+		{
+			_touch();
+			return nbytes;
+		}
+
+		// EIO: the device can't checksum offload; EINVAL/ENOPROTOOPT:
+		// the kernel predates UDP_SEGMENT
+		AbortIfNot(errno == EIO || errno == EINVAL || errno == ENOPROTOOPT,
+			-1);
+
+		int total = 0;
+		for (size_t offset = 0; offset < buf.size(); offset += segment_size)
+		{
+			const size_t remaining = buf.size() - offset;
+			const size_t size = remaining < segment_size ?
+				remaining : segment_size;
+
+			const ssize_t sent = ::write(_fd.get(), buf.get() + offset, size);
+			AbortIf(sent < 0, -1);
+
+			total += sent;
+		}
+
+		_touch();
+		return total;
+	}
+
+	/**
+	 * Invoke a callback if no datagrams are sent or received for some
+	 * time. Each send or receive restarts the countdown. Requires
+	 * \ref set_timers()
+	 *
+	 * @param[in] timeout The idle time (in milliseconds) allowed, or -1
+	 *                    to disable the idle timeout
+	 * @param[in] on_idle Invoked once the connection has been idle for
+	 *                    \a timeout. It may e.g. close the connection
+	 *                    or call this function again to keep waiting
+	 *
+	 * @return True on success
+	 */
+	bool UdpConnection::set_idle_timeout(int timeout,
+		std::function<void()> on_idle)
+	{
+		AbortIfNot(_timers, false, "set_timers() has not been called.");
+
+		_timers->cancel(_idle_timer);
+		_idle_timer = jfern::timer_wheel::invalid_timer;
+
+		_idle_timeout    = timeout < 0 ? -1 : timeout;
+		_on_idle_timeout = std::move(on_idle);
+
+		if (_idle_timeout >= 0)
+		{
+			_idle_timer = _timers->schedule(
+				std::chrono::milliseconds(_idle_timeout),
+				[this]() { _on_idle(); });
+		}
+
+		return true;
+	}
+
+	/**
+	 * Set the resolver used to look up host names passed to \ref
+	 * bind() and \ref connect(). By default the process-wide \ref
+	 * Resolver::instance() is used, waiting as long as it takes
+	 *
+	 * With a timeout of zero, setup never blocks on DNS: if a name
+	 * is not yet cached, bind() or connect() fails with errno set to
+	 * EAGAIN while the lookup proceeds in the background, and may be
+	 * retried later, e.g. on the next pass of an event loop
+	 *
+	 * @param[in] resolver The resolver, which must outlive *this
+	 * @param[in] timeout  The most time (in milliseconds) to wait
+	 *                     for a name to be resolved, or -1 to wait
+	 *                     as long as needed
+	 */
+	void UdpConnection::set_resolver(Resolver& resolver, int timeout)
+	{
+		_resolver = &resolver;
+		_resolve_timeout = timeout;
+	}
+
+	/**
+	 * Set the timer wheel which schedules idle timeouts and
+	 * retransmissions, typically that of the event loop servicing
+	 * this connection, e.g. jfern::reactor::timers(). Any pending
+	 * timers are cancelled
+	 *
+	 * @param[in] timers The timer wheel, which must outlive *this
+	 *                   and belong to the thread using *this
+	 */
+	void UdpConnection::set_timers(jfern::timer_wheel& timers)
+	{
+		_cancel_timers();
+		_timers = &timers;
+	}
+
+	/**
+	 * Cancel the idle timeout and all retransmissions
+	 */
+	void UdpConnection::_cancel_timers()
+	{
+		if (!_timers) return;
+
+		_timers->cancel(_idle_timer);
+		_idle_timer = jfern::timer_wheel::invalid_timer;
+		_idle_timeout = -1;
+
+		for (auto& entry : _retransmits)
+			_timers->cancel(entry.second.timer);
+
+		_retransmits.clear();
+	}
+
 	/**
 	 * Handle an input message from a remote node. This preps
 	 * the data buffer for reading
@@ -227,13 +782,78 @@ namespace net
 		}
 		else
 		{
-			struct hostent *he = ::gethostbyname(name.c_str());
-			AbortIfNot(he, false);
+			// Usually answered from the cache; see set_resolver()
+			HostAddresses addrs;
+			if (!_resolver->resolve(name, addrs, _resolve_timeout))
+				return false;
 
-			std::memcpy(&addr.sin_addr, he->h_addr_list[0],
-				he->h_length);
+			AbortIf(addrs.ipv4.empty(), false,
+				"%s has no IPv4 address", name.c_str());
+
+			addr.sin_addr = addrs.ipv4[0];
 		}
 
 		return true;
 	}
+
+	/**
+	 * Handle expiry of the idle timeout
+	 */
+	void UdpConnection::_on_idle()
+	{
+		_idle_timer = jfern::timer_wheel::invalid_timer;
+		_idle_timeout = -1;
+
+		// The callback may set a new timeout, so move it out first
+		std::function<void()> on_idle = std::move(_on_idle_timeout);
+		if (on_idle) on_idle();
+	}
+
+	/**
+	 * Handle expiry of a retransmission timer, resending the datagram
+	 * or giving up on it
+	 *
+	 * @param[in] id The retransmission
+	 */
+	void UdpConnection::_on_retransmit(int id)
+	{
+		auto iter = _retransmits.find(id);
+		if (iter == _retransmits.end())
+			return;
+
+		Retransmit& entry = iter->second;
+
+		if (entry.remaining == 0)
+		{
+			std::function<void()> on_give_up = std::move(entry.on_give_up);
+			_retransmits.erase(iter);
+
+			if (on_give_up) on_give_up();
+			return;
+		}
+
+		entry.remaining--;
+
+		// A failed resend counts as an attempt, as would a lost one
+		send(ConstDataBuffer(entry.data.data(), entry.data.size()), 0);
+
+		if (entry.interval <= INT_MAX / 2)
+			entry.interval *= 2;
+
+		entry.timer = _timers->schedule(
+			std::chrono::milliseconds(entry.interval),
+			[this, id]() { _on_retransmit(id); });
+	}
+
+	/**
+	 * Restart the idle timeout after a datagram is sent or received
+	 */
+	void UdpConnection::_touch() const
+	{
+		if (_idle_timeout >= 0)
+		{
+			_timers->reschedule(_idle_timer,
+				std::chrono::milliseconds(_idle_timeout));
+		}
+	}
 }
@@ -10,12 +10,20 @@
 #define __UDP_CONNECTION_H__
 
 #include <cstdint>
+#include <functional>
+#include <map>
 #include <string>
+#include <vector>
+
+#include "networking/timer_wheel.h"
 
 #include "net.h"
 #include "DataBuffer.h"
 #include "ConstDataBuffer.h"
+#include "DatagramPool.h"
 #include "Fd.h"
+#include "Resolver.h"
+#include "UdpBatch.h"
 
 namespace net
 {
@@ -31,6 +39,7 @@ namespace net
 	 */
 	class UdpConnection
 	{
+		friend class UdpReceiverGroup;
 
 	public:
 
@@ -40,18 +49,93 @@ namespace net
 
 		bool bind(uint16 port, const std::string& name="");
 
+		bool acknowledge(int id);
+
 		bool connect(uint16 port, const std::string& host);
 
+		bool enable_gro(bool enable = true);
+
+		bool reuse_port(bool enable = true);
+
 		bool recv(DataBuffer& buf, int timeout = -1, bool conn = false);
 
+		int recv(UdpBatch& batch, int timeout = -1);
+
+		bool recv(DatagramPool& pool, Datagram& datagram,
+			int timeout = -1);
+
+		int recv(DatagramPool& pool, Datagram& datagram,
+			std::vector<ConstDataBuffer>& segments, int timeout = -1);
+
+		int retransmit(const ConstDataBuffer& buf, int interval,
+			int attempts, std::function<void()> on_give_up = nullptr);
+
 		int send(const DataBuffer& buf, int timeout = -1) const;
 
 		int send(const ConstDataBuffer& buf, int timeout = -1) const;
 
+		int send(UdpBatch& batch, int timeout = -1) const;
+
+		int send_segmented(const ConstDataBuffer& buf, uint16 segment_size,
+			int timeout = -1) const;
+
+		bool set_idle_timeout(int timeout, std::function<void()> on_idle);
+
+		void set_resolver(Resolver& resolver, int timeout = -1);
+
+		void set_timers(jfern::timer_wheel& timers);
+
+		/**
+		 * The most segments the kernel will split a single send
+		 * into
+		 */
+		static const size_t max_segments = 64;
+
 	private:
 
+		/**
+		 * A datagram awaiting acknowledgement
+		 */
+		struct Retransmit
+		{
+			/**
+			 * A copy of the datagram
+			 */
+			std::vector<char> data;
+
+			/**
+			 * The time (in milliseconds) to wait before
+			 * the next retransmission
+			 */
+			int interval;
+
+			/**
+			 * The number of retransmissions left
+			 */
+			int remaining;
+
+			/**
+			 * Fires when the datagram is next due to be
+			 * retransmitted
+			 */
+			jfern::timer_wheel::timer_id timer;
+
+			/**
+			 * Invoked once all attempts are exhausted
+			 */
+			std::function<void()> on_give_up;
+		};
+
+		void _cancel_timers();
+
 		bool _handle_input();
 
+		void _on_idle();
+
+		void _on_retransmit(int id);
+
+		void _touch() const;
+
 		bool _init_sockaddr(uint16 port, const std::string& name,
 			struct sockaddr_in& addr) const;
 
@@ -93,6 +177,52 @@ namespace net
 		 */
 		struct sockaddr_in
 			_remote_addr;
+
+		/**
+		 * Resolves host names passed to \ref bind()
+		 * and \ref connect()
+		 */
+		Resolver* _resolver;
+
+		/**
+		 * The most time (in milliseconds) to wait
+		 * for a host name to be resolved
+		 */
+		int _resolve_timeout;
+
+		/**
+		 * Invoked if no datagrams are sent or
+		 * received for \ref _idle_timeout
+		 */
+		std::function<void()> _on_idle_timeout;
+
+		/**
+		 * The idle timeout (in milliseconds), or -1
+		 * if disabled
+		 */
+		int _idle_timeout;
+
+		/**
+		 * Fires when the connection has been idle
+		 * for \ref _idle_timeout
+		 */
+		jfern::timer_wheel::timer_id _idle_timer;
+
+		/**
+		 * The identifier of the next retransmission
+		 */
+		int _next_retransmit;
+
+		/**
+		 * Datagrams awaiting acknowledgement, keyed
+		 * by identifier
+		 */
+		std::map<int, Retransmit> _retransmits;
+
+		/**
+		 * Schedules idle timeouts and retransmissions
+		 */
+		jfern::timer_wheel* _timers;
 	};
 }
 
@@ -0,0 +1,221 @@
+/**
+ *  \file   UdpReceiverGroup.cpp
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/io_tools
+ */
+
+#include <linux/filter.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#include "abort.h"
+#include "UdpReceiverGroup.h"
+
+namespace net
+{
+	/**
+	 * Time (in milliseconds) a worker waits for input before checking
+	 * whether it should stop
+	 */
+	static const int poll_interval = 100;
+
+	/**
+	 * Constructor
+	 *
+	 * @param[in] n_workers  The number of sockets and worker threads
+	 * @param[in] batch_size The most datagrams each worker receives
+	 *                       per system call
+	 */
+	UdpReceiverGroup::UdpReceiverGroup(size_t n_workers,
+		size_t batch_size)
+		: _batch_size(batch_size),
+		  _conns(),
+		  _received(new Counter[n_workers]),
+		  _running(false),
+		  _threads()
+	{
+		for (size_t i = 0; i < n_workers; i++)
+		{
+			_conns.emplace_back(new UdpConnection());
+			_received[i].value.store(0);
+		}
+	}
+
+	/**
+	 * Destructor. Stops the workers
+	 */
+	UdpReceiverGroup::~UdpReceiverGroup()
+	{
+		stop();
+	}
+
+	/**
+	 * Attach a BPF program which delivers each datagram to the socket
+	 * of the worker pinned to the CPU processing it, i.e. worker (cpu
+	 * % size()). Must be called after \ref bind()
+	 *
+	 * @return True on success
+	 */
+	bool UdpReceiverGroup::attach_cpu_steering()
+	{
+		AbortIf(_conns.empty(), false);
+
+		struct sock_filter code[] = {
+			// A = the current CPU
+			{ BPF_LD  | BPF_W   | BPF_ABS, 0, 0,
+				static_cast<std::uint32_t>(SKF_AD_OFF + SKF_AD_CPU) },
+			// A = A % number of sockets
+			{ BPF_ALU | BPF_MOD | BPF_K,   0, 0,
+				static_cast<std::uint32_t>(_conns.size()) },
+			// Deliver to socket A
+			{ BPF_RET | BPF_A,             0, 0, 0 }
+		};
+
+		struct sock_fprog prog;
+		prog.len    = sizeof(code) / sizeof(code[0]);
+		prog.filter = code;
+
+		// The program applies to the whole group, so attaching it to
+		// one socket suffices
+		AbortIf(::setsockopt(_conns[0]->_fd.get(), SOL_SOCKET,
+			SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog)) < 0, false);
+
+		return true;
+	}
+
+	/**
+	 * Bind every socket in the group to the same port
+	 *
+	 * @param[in] port The port number
+	 * @param[in] name A network interface name or IP address. This is
+	 *                 optional; the default behavior is to bind() to
+	 *                 all available interfaces
+	 *
+	 * @return True on success
+	 */
+	bool UdpReceiverGroup::bind(uint16 port, const std::string& name)
+	{
+		for (auto& conn : _conns)
+		{
+			AbortIfNot(conn->reuse_port(), false);
+			AbortIfNot(conn->bind(port, name), false);
+		}
+
+		return true;
+	}
+
+	/**
+	 * Get the number of datagrams a worker has received
+	 *
+	 * @param[in] worker The index of the worker
+	 *
+	 * @return The number of datagrams
+	 */
+	std::uint64_t UdpReceiverGroup::received(size_t worker) const
+	{
+		AbortIfNot(worker < _conns.size(), 0);
+		return _received[worker].value.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Get the number of workers
+	 *
+	 * @return The number of sockets and worker threads
+	 */
+	size_t UdpReceiverGroup::size() const
+	{
+		return _conns.size();
+	}
+
+	/**
+	 * Start receiving, with one thread per socket
+	 *
+	 * @param[in] handler     Invoked with each batch received
+	 * @param[in] pin_threads If true, pin worker i to CPU i (modulo
+	 *                        the number of CPUs), as assumed by \ref
+	 *                        attach_cpu_steering()
+	 *
+	 * @return True on success, or false if already running
+	 */
+	bool UdpReceiverGroup::start(Handler handler, bool pin_threads)
+	{
+		AbortIf(_running, false, "already running");
+
+		_running = true;
+
+		for (size_t i = 0; i < _conns.size(); i++)
+		{
+			_threads.emplace_back(&UdpReceiverGroup::_run, this, i,
+				handler, pin_threads);
+		}
+
+		return true;
+	}
+
+	/**
+	 * Stop all workers, waiting for them to exit
+	 */
+	void UdpReceiverGroup::stop()
+	{
+		_running = false;
+
+		for (auto& thread : _threads)
+			thread.join();
+
+		_threads.clear();
+	}
+
+	/**
+	 * A worker's receive loop
+	 *
+	 * @param[in] worker     The index of the worker
+	 * @param[in] handler    Invoked with each batch received
+	 * @param[in] pin_thread If true, pin this thread to a CPU
+	 */
+	void UdpReceiverGroup::_run(size_t worker, Handler handler,
+		bool pin_thread)
+	{
+		if (pin_thread)
+		{
+			const unsigned int n_cpus = std::thread::hardware_concurrency();
+
+			cpu_set_t cpus;
+			CPU_ZERO(&cpus);
+			CPU_SET(worker % (n_cpus ? n_cpus : 1), &cpus);
+
+			// Not fatal; we'll just lose some locality. The socket stays in
+			// the SO_REUSEPORT group, so keep receiving on it regardless
+			const int error = ::pthread_setaffinity_np(::pthread_self(),
+				sizeof(cpus), &cpus);
+
+			if (error != 0)
+			{
+				std::fprintf(stderr, "UdpReceiverGroup: failed to pin "
+					"worker %zu: %s\n", worker, std::strerror(error));
+			}
+		}
+
+		UdpBatch batch(_batch_size);
+		UdpConnection& conn = *_conns[worker];
+
+		while (_running.load(std::memory_order_relaxed))
+		{
+			const int count = conn.recv(batch, poll_interval);
+			AbortIf(count < 0,);
+
+			if (count > 0)
+			{
+				_received[worker].value.fetch_add(count,
+					std::memory_order_relaxed);
+
+				if (handler) handler(worker, batch);
+			}
+		}
+	}
+}
@@ -0,0 +1,111 @@
+/**
+ *  \file   UdpReceiverGroup.h
+ *  \author Jason Fernandez
+ *  \date   10/16/2026
+ *
+ *  https://github.com/jfern2011/io_tools
+ */
+
+#ifndef __UDP_RECEIVER_GROUP_H__
+#define __UDP_RECEIVER_GROUP_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "UdpBatch.h"
+#include "UdpConnection.h"
+
+namespace net
+{
+	/**
+	 * Shards receipt of datagrams on a single port across several
+	 * worker threads. Each worker has its own SO_REUSEPORT socket
+	 * bound to the port and runs its own receive loop, so workers
+	 * never contend with one another
+	 *
+	 * By default the kernel picks a socket by hashing each flow's
+	 * addresses. Optionally, a BPF program may be attached which
+	 * instead picks the socket of the worker pinned to the CPU that
+	 * is processing the datagram, keeping each datagram on one core
+	 * from the NIC queue through to the application
+	 */
+	class UdpReceiverGroup
+	{
+
+	public:
+
+		/**
+		 * Invoked from a worker thread with each batch of datagrams
+		 * it receives. The batch is reused once the handler returns
+		 */
+		using Handler = std::function<void(size_t worker,
+			const UdpBatch& batch)>;
+
+		UdpReceiverGroup(size_t n_workers, size_t batch_size = 64);
+
+		UdpReceiverGroup(const UdpReceiverGroup& group) = delete;
+
+		UdpReceiverGroup& operator=(const UdpReceiverGroup& group)
+			= delete;
+
+		~UdpReceiverGroup();
+
+		bool attach_cpu_steering();
+
+		bool bind(uint16 port, const std::string& name = "");
+
+		std::uint64_t received(size_t worker) const;
+
+		size_t size() const;
+
+		bool start(Handler handler, bool pin_threads = true);
+
+		void stop();
+
+	private:
+
+		void _run(size_t worker, Handler handler, bool pin_thread);
+
+		/**
+		 * A worker's count of datagrams received, on a cache line of its
+		 * own so that workers on different cores don't contend for it
+		 */
+		struct alignas(64) Counter
+		{
+			std::atomic<std::uint64_t> value;
+		};
+
+		/**
+		 * The number of datagrams received per system call
+		 */
+		size_t _batch_size;
+
+		/**
+		 * One socket per worker
+		 */
+		std::vector<std::unique_ptr<UdpConnection>> _conns;
+
+		/**
+		 * Per-worker counts of datagrams received
+		 */
+		std::unique_ptr<Counter[]> _received;
+
+		/**
+		 * True while the workers should keep running
+		 */
+		std::atomic<bool> _running;
+
+		/**
+		 * The worker threads
+		 */
+		std::vector<std::thread> _threads;
+	};
+}
+
+#endif
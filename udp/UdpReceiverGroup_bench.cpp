@@ -0,0 +1,160 @@
+#include "UdpReceiverGroup.h"
+#include "abort.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	/**
+	 * The number of datagrams sent to each receiver group
+	 */
+	const size_t n_datagrams = 400000;
+
+	/**
+	 * The number of datagrams sent or received per system call
+	 */
+	const size_t batch_size = 64;
+
+	/**
+	 * The size of each datagram, typical of market data updates
+	 */
+	const size_t datagram_size = 128;
+
+	/**
+	 * The number of sending sockets. Each has its own source port,
+	 * hence its own flow, so hashing spreads them across receivers
+	 */
+	const size_t n_flows = 16;
+
+	/**
+	 * The port receivers bind to
+	 */
+	const net::uint16 port = 12349;
+
+	/**
+	 * Get the number of seconds elapsed since a start time
+	 */
+	double elapsed(std::chrono::steady_clock::time_point start)
+	{
+		const std::chrono::duration<double> diff =
+			std::chrono::steady_clock::now() - start;
+		return diff.count();
+	}
+
+	/**
+	 * Send datagrams round robin across \ref n_flows flows to a group
+	 * of receivers, until they have all been received
+	 *
+	 * @param[in] n_workers The number of receivers
+	 * @param[in] steer     If true, steer datagrams by CPU rather than
+	 *                      by flow hash
+	 *
+	 * @return The number of datagrams received per second, or -1 on
+	 *         error
+	 */
+	double run_group(size_t n_workers, bool steer)
+	{
+		net::UdpReceiverGroup group(n_workers, batch_size);
+		AbortIfNot(group.bind(port, "localhost"), -1);
+
+		if (steer)
+			AbortIfNot(group.attach_cpu_steering(), -1);
+
+		std::vector<std::unique_ptr<net::UdpConnection>> flows;
+		for (size_t i = 0; i < n_flows; i++)
+		{
+			flows.emplace_back(new net::UdpConnection());
+			AbortIfNot(flows.back()->connect(port, "localhost"), -1);
+		}
+
+		std::vector<char> payload(datagram_size, 'x');
+
+		const net::ConstDataBuffer send_buf(payload.data(),
+			payload.size());
+
+		net::UdpBatch send_batch(batch_size);
+
+		AbortIfNot(group.start(nullptr), -1);
+
+		auto total = [&group]() {
+			std::uint64_t sum = 0;
+			for (size_t i = 0; i < group.size(); i++)
+				sum += group.received(i);
+			return sum;
+		};
+
+		const auto start = std::chrono::steady_clock::now();
+
+		size_t sent = 0;
+		while (sent < n_datagrams)
+		{
+			net::UdpConnection& tx = *flows[(sent / batch_size) % n_flows];
+
+			send_batch.clear();
+			for (size_t i = 0; i < batch_size; i++)
+				AbortIfNot(send_batch.add(send_buf), -1);
+
+			while (send_batch.size() > 0)
+				AbortIf(tx.send(send_batch) < 0, -1);
+
+			sent += batch_size;
+
+			// Keep well below the socket buffer sizes so that
+			// nothing is dropped
+			while (sent - total() > batch_size)
+				std::this_thread::yield();
+		}
+
+		while (total() < sent)
+		{
+			AbortIf(elapsed(start) > 30.0, -1, "timed out");
+			std::this_thread::yield();
+		}
+
+		const double rate = sent / elapsed(start);
+
+		group.stop();
+
+		return rate;
+	}
+}
+
+bool run()
+{
+	const size_t n_cpus =
+		std::max(1u, std::thread::hardware_concurrency());
+
+	std::printf("%zu datagrams of %zu bytes over loopback, %zu CPUs\n",
+		n_datagrams, datagram_size, n_cpus);
+
+	for (size_t n = 1; n <= std::max<size_t>(n_cpus, 4); n *= 2)
+	{
+		const double hashed  = run_group(n, false);
+		const double steered = run_group(n, true);
+
+		AbortIf(hashed < 0, false);
+
+		std::printf("%2zu workers, flow hash: %12.0f datagrams/sec\n",
+			n, hashed);
+
+		if (steered < 0)
+			std::printf("%2zu workers, CPU steer: unsupported\n", n);
+		else
+		{
+			std::printf("%2zu workers, CPU steer: %12.0f datagrams/sec\n",
+				n, steered);
+		}
+	}
+
+	return true;
+}
+
+int main()
+{
+	return run() ? 0 : 1;
+}